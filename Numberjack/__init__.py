@@ -1998,6 +1998,155 @@ class Table(Predicate):
         return self.operator + "([" + ",".join([str(var) for var in self.children]) + "]," + str(self.parameters[0]) + ",'" + self.parameters[1] + "')"
 
 
+class Regular(Predicate):
+    """
+    Regular constraint ensures that the sequence of values of the variables is
+    a word accepted by a (possibly non-deterministic) finite automaton.
+
+    Solvers with a decision diagram propagator (Mistral2) post it as a single
+    global constraint, the others decompose it into a chain of ternary
+    :class:`.Table` constraints over one state variable per position.
+
+    :param list vars: the variables to be constrained by the constraint.
+    :param transitions: list of triplets (state, value, next state).
+    :param int initial: the initial state of the automaton.
+    :param finals: list of the final states of the automaton.
+
+    .. note::
+
+        Can only be used as a top-level constraint, not reified.
+    """
+
+    def __init__(self, vars, transitions, initial, finals):
+        Predicate.__init__(self, vars, "Regular")
+        self.parameters = [[tuple(t) for t in transitions], initial, [q for q in finals]]
+        self.lb = None
+        self.ub = None
+
+    def decompose(self):
+        transitions, initial, finals = self.parameters
+        n = len(self.children)
+        if n == 1:
+            return [Table(self.children, sorted(set((v,) for (q, v, r) in transitions if q == initial and r in finals)))]
+        states = sorted(set([q for (q, v, r) in transitions] + [r for (q, v, r) in transitions])) or [initial]
+        Q = [Variable(states) for i in range(n - 1)]
+        decomposition = [Table([self.children[0], Q[0]], sorted(set((v, r) for (q, v, r) in transitions if q == initial)))]
+        for i in range(1, n - 1):
+            decomposition.append(Table([Q[i - 1], self.children[i], Q[i]], sorted(set(transitions))))
+        decomposition.append(Table([Q[n - 2], self.children[n - 1]], sorted(set((q, v) for (q, v, r) in transitions if r in finals))))
+        return decomposition
+
+    def __str__(self):
+        return "regular([" + ",".join(map(str, self.children)) + "], " + str(self.parameters[0]) + ", " + str(self.parameters[1]) + ", " + str(self.parameters[2]) + ")"
+
+
+class MDD(Predicate):
+    """
+    MDD constraint ensures that the sequence of values of the variables is the
+    label of a path from the root to a terminal node of a layered
+    multi-valued decision diagram.
+
+    Solvers with a decision diagram propagator (Mistral2) post it as a single
+    global constraint, the others decompose it as a :class:`.Regular`
+    constraint whose initial state is the root and whose final states are the
+    terminal nodes.
+
+    :param list vars: the variables to be constrained by the constraint.
+    :param edges: list of triplets (node, value, child), the root is node 0
+        and the terminals are the nodes without children.
+
+    .. note::
+
+        Can only be used as a top-level constraint, not reified.
+    """
+
+    def __init__(self, vars, edges):
+        Predicate.__init__(self, vars, "MDD")
+        self.parameters = [[tuple(e) for e in edges]]
+        self.lb = None
+        self.ub = None
+
+    def decompose(self):
+        edges = self.parameters[0]
+        terminals = set(c for (p, v, c) in edges) - set(p for (p, v, c) in edges)
+        return Regular(self.children, edges, 0, sorted(terminals)).decompose()
+
+    def __str__(self):
+        return "mdd([" + ",".join(map(str, self.children)) + "], " + str(self.parameters[0]) + ")"
+
+class Circuit(Predicate):
+    """
+    Circuit constraint ensures that the successor variables form a single
+    Hamiltonian circuit: the value of the i-th variable is the node visited
+    after node i, and the tour goes through every node exactly once.
+
+    Solvers with a dedicated circuit propagator (Mistral2) post it as a single
+    global constraint, the others decompose it into an :class:`.AllDiff` and
+    the position of each node in the tour.
+
+    :param list vars: the successor variables, with values in [0, n-1].
+
+    .. note::
+
+        Can only be used as a top-level constraint, not reified.
+    """
+
+    def __init__(self, vars):
+        Predicate.__init__(self, vars, "Circuit")
+        self.lb = None
+        self.ub = None
+
+    def decompose(self):
+        succ = self.children
+        n = len(succ)
+        position = VarArray(n, 0, n - 1)
+        decomposition = [AllDiff(succ), AllDiff(position), position[0] == 0]
+        for i in range(n):
+            decomposition.append(succ[i] != i)
+            for j in range(1, n):
+                if j != i:
+                    decomposition.append((succ[i] != j) | (position[j] == position[i] + 1))
+        return decomposition
+
+    def __str__(self):
+        return "circuit([" + ",".join(map(str, self.children)) + "])"
+
+
+class WeightedCircuit(Predicate):
+    """
+    Weighted circuit constraint ensures that the successor variables form a
+    single Hamiltonian circuit (see :class:`.Circuit`) whose length, the sum
+    of the weights of its arcs, is equal to the cost variable.
+
+    Mistral2 bounds the cost with the assignment relaxation of the circuit
+    and removes the arcs whose reduced cost exceeds the slack, the other
+    solvers decompose it into a :class:`.Circuit` and a :class:`.Sum` of
+    :class:`.Element` expressions.
+
+    :param list vars: the successor variables, with values in [0, n-1].
+    :param weights: an n by n matrix, the weight of the arc from i to j.
+    :param cost: the variable equal to the length of the circuit.
+
+    .. note::
+
+        Can only be used as a top-level constraint, not reified.
+    """
+
+    def __init__(self, vars, weights, cost):
+        Predicate.__init__(self, [var for var in vars] + [cost], "WeightedCircuit")
+        self.parameters = [[[w for w in row] for row in weights]]
+        self.lb = None
+        self.ub = None
+
+    def decompose(self):
+        succ = self.children[:-1]
+        weights = self.parameters[0]
+        legs = [Element([Variable(w, w, str(w)) for w in weights[i]], succ[i]) for i in range(len(succ))]
+        return Circuit(succ).decompose() + [Sum(legs) == self.children[-1]]
+
+    def __str__(self):
+        return "circuit([" + ",".join(map(str, self.children[:-1])) + "], " + str(self.parameters[0]) + ") = " + str(self.children[-1])
+
 class Sum(Predicate):
     """
     Sum expression with linear coefficients. Numberjack will detect inline sum
@@ -2210,6 +2359,9 @@ class AllDiff(Predicate):
 
     :param vars: the variables or expressions which must take different values.
         This should be a :class:`.VarArray` or `list` with at least two items.
+    :param type: optional propagator type, passed to the solver. Mistral2
+        accepts ``'gac'`` (matching-based filtering), ``'bc'`` (bounds, the
+        default) and ``'fc'`` (forward checking).
 
     .. note::
 
@@ -2822,20 +2974,31 @@ class NoOverlap(Predicate):
         return str(self.children[0]) + ' + ' + str(self.parameters[0]) + ' <= ' + str(self.children[1]) + ' OR ' + str(self.children[1]) + ' + ' + str(self.parameters[1]) + ' <= ' + str(self.children[0])
 
 
-class UnaryResource(list):
+class UnaryResource(Predicate):
     """
     Unary resource constraint ensures that only one of the specified list of
     tasks are running at each time point. An optional distance between tasks can
     be specified also.
 
+    Solvers with a dedicated unary resource propagator (Mistral2) post it as a
+    single global constraint, the others decompose it into one
+    :class:`.NoOverlap` constraint per pair of tasks.
+
     :param arg: a list of :class:`.Task` instances.
     :param int distance: optional distance between tasks.
+
+    .. note::
+
+        Can only be used as a top-level constraint, not reified.
     """
 
     def __init__(self, arg=[], distance=0):
-        list.__init__(self, [NoOverlap(arg[i], arg[j], arg[i].duration + distance, arg[j].duration + distance) for i in range(1, len(arg)) for j in range(i)])
-        self.tasks = [task for task in arg]
+        Predicate.__init__(self, [task for task in arg], "UnaryResource")
+        self.tasks = self.children
         self.distance = distance
+        self.parameters = [[task.duration + distance for task in self.tasks]]
+        self.lb = None
+        self.ub = None
 
     def add(self, new_task):
         """
@@ -2844,12 +3007,71 @@ class UnaryResource(list):
 
         :param Task new_task: the additional task to include.
         """
-        for task in self.tasks:
-            self.append(NoOverlap(new_task, task, new_task.duration + self.distance, task.duration + self.distance))
         self.tasks.append(new_task)
+        self.parameters[0].append(new_task.duration + self.distance)
+
+    def decompose(self):
+        durations = self.parameters[0]
+        return [NoOverlap(self.tasks[i], self.tasks[j], durations[i], durations[j]) for i in range(1, len(self.tasks)) for j in range(i)]
+
+    def __str__(self):
+        return "[" + " ".join(map(str, self.tasks)) + "] share a unary resource"
+
+
+class Cumulative(Predicate):
+    """
+    Cumulative resource constraint ensures that at each time point, the sum of
+    the demands of the tasks in process does not exceed the capacity of the
+    resource.
+
+    Solvers with a dedicated cumulative propagator (Mistral2) post it as a
+    single global constraint, the others decompose it into one weighted
+    :class:`.Sum` per time point of the scheduling horizon.
+
+    :param arg: a list of :class:`.Task` instances.
+    :param demands: a list of integers, the demand of each task.
+    :param int capacity: the capacity of the resource.
+
+    .. note::
+
+        Can only be used as a top-level constraint, not reified.
+    """
+
+    def __init__(self, arg, demands, capacity):
+        Predicate.__init__(self, [task for task in arg], "Cumulative")
+        self.tasks = self.children
+        self.parameters = [[task.duration for task in self.tasks], [d for d in demands], capacity]
+        self.lb = None
+        self.ub = None
+
+    def add(self, new_task, demand=1):
+        """
+        Add an additional task to the existing list of tasks using this
+        cumulative resource.
+
+        :param Task new_task: the additional task to include.
+        :param int demand: the demand of the additional task.
+        """
+        self.tasks.append(new_task)
+        self.parameters[0].append(new_task.duration)
+        self.parameters[1].append(demand)
+
+    def decompose(self):
+        durations, demands, capacity = self.parameters
+        tasks = [i for i in range(len(self.tasks)) if durations[i] > 0 and demands[i] > 0]
+        if not tasks:
+            return []
+        decomposition = []
+        start = min(self.tasks[i].get_lb() for i in tasks)
+        end = max(self.tasks[i].get_ub() + durations[i] for i in tasks)
+        for time in range(start, end):
+            running = [i for i in tasks if self.tasks[i].get_lb() <= time < self.tasks[i].get_ub() + durations[i]]
+            if sum(demands[i] for i in running) > capacity:
+                decomposition.append(Sum([(self.tasks[i] <= time) & (self.tasks[i] > time - durations[i]) for i in running], [demands[i] for i in running]) <= capacity)
+        return decomposition
 
     def __str__(self):
-        return "[" + " ".join(map(str, self.tasks)) + "] share a unary resource"  # "+" ".join(map(str, self))
+        return "[" + " ".join(map(str, self.tasks)) + "] share a cumulative resource of capacity " + str(self.parameters[2])
 
 
 # BH (2014/10/15): disabled as it does not appear to be used anywhere and
@@ -3794,6 +4016,29 @@ class NBJ_STD_Solver(object):
         "Returns the CPU time required for the last search."
         return self.solver.getTime()
 
+    def getPropagatorProfile(self):
+        """
+        Returns a dictionary mapping each type of propagator to a tuple
+        (calls, prunings, failures, cycles) recorded during the last search.
+        Profiling must have been enabled beforehand with
+        ``solver.solver.setProfiling(1)``. Valid for Mistral2 only.
+
+        :raises UnsupportedSolverFunction: if called on a solver that does
+            not record propagator profiles.
+        """
+        if not hasattr(self.solver, 'getNumPropagatorTypes'):
+            raise UnsupportedSolverFunction(
+                self.Library, "getPropagatorProfile", "This solver does not "
+                "support propagator profiling.")
+        profile = {}
+        for i in range(self.solver.getNumPropagatorTypes()):
+            profile[self.solver.getPropagatorType(i)] = (
+                self.solver.getPropagatorCalls(i),
+                self.solver.getPropagatorPrunings(i),
+                self.solver.getPropagatorFailures(i),
+                self.solver.getPropagatorCycles(i))
+        return profile
+
     ## @}
 
     def getChecks(self):
@@ -3833,9 +4078,10 @@ class NBJ_STD_Solver(object):
     def load_xml(self, file, type=4):
         """
         This function only allows you to load an XCSP instance into the Mistral
-        solver. You should use the :mod:`Numberjack.XCSP` module to build a
-        generic Numberjack model from an XCSP instance, which can be loaded with
-        other underlying solvers.
+        or Mistral2 solver. Mistral2 streams the file in C++, so large
+        relations are never held as an XML tree in Python. You should use the
+        :mod:`Numberjack.XCSP` module to build a generic Numberjack model from
+        an XCSP instance, which can be loaded with other underlying solvers.
 
         .. deprecated:: 1.1
             Use :mod:`Numberjack.XCSP` instead.
@@ -5,6 +5,9 @@
 
 #include "Mistral2.hpp"
 
+#include <set>
+#include <cstring>
+
 /**************************************************************
  ********************     EXPRESSION        *******************
  **************************************************************/
@@ -341,6 +344,19 @@ Mistral2_AllDiff::Mistral2_AllDiff( Mistral2ExpArray& vars )
   std::cout << "creating an alldiff constraint" << std::endl;
 #endif
   _vars = vars;
+  _consistency = BOUND_CONSISTENCY;
+}
+
+Mistral2_AllDiff::Mistral2_AllDiff( Mistral2ExpArray& vars, const char* type ) 
+  : Mistral2_Expression() 
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating an alldiff constraint (" << type << ")" << std::endl;
+#endif
+  _vars = vars;
+  if(!strcmp(type,"gac") || !strcmp(type,"domain")) _consistency = ARC_CONSISTENCY;
+  else if(!strcmp(type,"fc")) _consistency = FORWARD_CHECKING;
+  else _consistency = BOUND_CONSISTENCY;
 }
 
 Mistral2_AllDiff::Mistral2_AllDiff( Mistral2_Expression *var1, Mistral2_Expression *var2 ) 
@@ -351,6 +367,7 @@ Mistral2_AllDiff::Mistral2_AllDiff( Mistral2_Expression *var1, Mistral2_Expressi
 #endif
   _vars.add(var1);
   _vars.add(var2); 
+  _consistency = BOUND_CONSISTENCY;
 }
 
 Mistral2_AllDiff::~Mistral2_AllDiff()
@@ -378,7 +395,7 @@ Mistral2_Expression* Mistral2_AllDiff::add(Mistral2Solver *solver, bool top_leve
     } else {
       Mistral::VarArray scope(n);
       for(i=0; i<n; ++i) scope[i] = _vars.get_item(i)->_self;
-      _self = AllDiff(scope);
+      _self = AllDiff(scope, _consistency);
     }
 
     if(top_level){
@@ -397,6 +414,107 @@ Mistral2_Expression* Mistral2_AllDiff::add(Mistral2Solver *solver, bool top_leve
   return this;
 }
 
+Mistral2_Table::Mistral2_Table(Mistral2ExpArray& vars, Mistral2IntArray& tuples, const char* type)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a table constraint" << std::endl;
+#endif
+
+  _vars = vars;
+  _tuples = tuples;
+  _support = (!strcmp(type,"support"));
+}
+
+Mistral2_Table::Mistral2_Table(Mistral2_Expression *var1, Mistral2_Expression *var2,
+			       Mistral2IntArray& tuples, const char* type)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary table constraint" << std::endl;
+#endif
+
+  _vars.add(var1);
+  _vars.add(var2);
+  _tuples = tuples;
+  _support = (!strcmp(type,"support"));
+}
+
+Mistral2_Table::~Mistral2_Table()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete table" << std::endl;
+#endif
+}
+
+void Mistral2_Table::add(Mistral2IntArray& tuple) {
+  for(int i=0; i<tuple.size(); ++i)
+    _tuples.add(tuple.get_item(i));
+}
+
+Mistral2_Expression* Mistral2_Table::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add table constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, j, n=_vars.size(), m=_tuples.size()/n;
+    Mistral::Vector< Mistral::Variable > scope;
+    Mistral::Vector< const int* > relation;
+    int *tuple;
+
+    for(i=0; i<n; ++i) {
+      _vars.get_item(i)->add(_solver,false);
+      scope.add(_vars.get_item(i)->_self);
+    }
+
+    if(_support) {
+      for(i=0; i<m; ++i) {
+	tuple = new int[n];
+	for(j=0; j<n; ++j) tuple[j] = _tuples.get_item(i*n+j);
+	relation.add(tuple);
+      }
+    } else {
+      // enumerate the cartesian product of the domains, minus the conflicts
+      std::set< std::vector<int> > conflicts;
+      std::vector<int> current(n);
+      for(i=0; i<m; ++i) {
+	for(j=0; j<n; ++j) current[j] = _tuples.get_item(i*n+j);
+	conflicts.insert(current);
+      }
+
+      for(j=0; j<n; ++j) current[j] = scope[j].get_min();
+      j = 0;
+      while(j < n) {
+	if(!conflicts.count(current)) {
+	  tuple = new int[n];
+	  for(i=0; i<n; ++i) tuple[i] = current[i];
+	  relation.add(tuple);
+	}
+	for(j=0; j<n; ++j) {
+	  if(current[j] < scope[j].get_max()) {
+	    current[j] = scope[j].next(current[j]);
+	    break;
+	  }
+	  current[j] = scope[j].get_min();
+	}
+      }
+    }
+
+    _self = Mistral::Table(scope, relation, Mistral::TableExpression::Dynamic);
+    // the table expression now owns the list of tuples
+    relation.neutralise();
+
+    if( top_level )
+      _solver->solver->add( _self );
+  }
+
+  return this;
+}
+
 Mistral2_Gcc::Mistral2_Gcc(Mistral2ExpArray& vars,
 			   Mistral2IntArray& vals,
 			   Mistral2IntArray& lb_card,
@@ -1212,6 +1330,376 @@ Mistral2_Expression* Mistral2_NoOverlap::add(Mistral2Solver *solver, bool top_le
 }
 
 
+Mistral2_UnaryResource::Mistral2_UnaryResource(Mistral2ExpArray& vars, Mistral2IntArray& durations)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a unary resource constraint" << std::endl;
+#endif
+  _vars = vars;
+  _durations = durations;
+}
+
+Mistral2_UnaryResource::Mistral2_UnaryResource(Mistral2_Expression *var1, Mistral2_Expression *var2, 
+					       Mistral2IntArray& durations)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary unary resource constraint" << std::endl;
+#endif
+  _vars.add(var1);
+  _vars.add(var2);
+  _durations = durations;
+}
+
+Mistral2_UnaryResource::~Mistral2_UnaryResource()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete unary resource" << std::endl;
+#endif
+}
+
+Mistral2_Expression* Mistral2_UnaryResource::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add unary resource constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, n=_vars.size();
+    Mistral::VarArray scope;
+    Mistral::Vector< int > durations;
+    for(i=0; i<n; ++i) {
+      _vars.set_item(i, _vars.get_item(i)->add(solver, false));
+      scope.add(_vars.get_item(i)->_self);
+      durations.add(_durations.get_item(i));
+    }
+
+    _self = UnaryResource(scope, durations);
+
+    if(top_level) {
+      _solver->solver->add( _self );
+    } else {
+      std::cerr << "Error: UnaryResource can only be used as a top-level constraint" << std::endl;
+      exit(1);
+    }
+  }
+  return this;
+}
+
+Mistral2_Cumulative::Mistral2_Cumulative(Mistral2ExpArray& vars, Mistral2IntArray& durations, 
+					 Mistral2IntArray& demands, int capacity)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a cumulative constraint" << std::endl;
+#endif
+  _vars = vars;
+  _durations = durations;
+  _demands = demands;
+  _capacity = capacity;
+}
+
+Mistral2_Cumulative::Mistral2_Cumulative(Mistral2_Expression *var1, Mistral2_Expression *var2, 
+					 Mistral2IntArray& durations, Mistral2IntArray& demands, int capacity)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary cumulative constraint" << std::endl;
+#endif
+  _vars.add(var1);
+  _vars.add(var2);
+  _durations = durations;
+  _demands = demands;
+  _capacity = capacity;
+}
+
+Mistral2_Cumulative::~Mistral2_Cumulative()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete cumulative" << std::endl;
+#endif
+}
+
+Mistral2_Expression* Mistral2_Cumulative::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add cumulative constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, n=_vars.size();
+    Mistral::VarArray scope;
+    Mistral::Vector< int > durations;
+    Mistral::Vector< int > demands;
+    for(i=0; i<n; ++i) {
+      _vars.set_item(i, _vars.get_item(i)->add(solver, false));
+      scope.add(_vars.get_item(i)->_self);
+      durations.add(_durations.get_item(i));
+      demands.add(_demands.get_item(i));
+    }
+
+    _self = Cumulative(scope, durations, demands, _capacity);
+
+    if(top_level) {
+      _solver->solver->add( _self );
+    } else {
+      std::cerr << "Error: Cumulative can only be used as a top-level constraint" << std::endl;
+      exit(1);
+    }
+  }
+  return this;
+}
+
+
+Mistral2_Regular::Mistral2_Regular(Mistral2ExpArray& vars, Mistral2IntArray& transitions, 
+				   int initial, Mistral2IntArray& finals)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a regular constraint" << std::endl;
+#endif
+  _vars = vars;
+  _transitions = transitions;
+  _initial = initial;
+  _finals = finals;
+}
+
+Mistral2_Regular::Mistral2_Regular(Mistral2_Expression *var1, Mistral2_Expression *var2, 
+				   Mistral2IntArray& transitions, int initial, Mistral2IntArray& finals)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary regular constraint" << std::endl;
+#endif
+  _vars.add(var1);
+  _vars.add(var2);
+  _transitions = transitions;
+  _initial = initial;
+  _finals = finals;
+}
+
+Mistral2_Regular::~Mistral2_Regular()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete regular" << std::endl;
+#endif
+}
+
+Mistral2_Expression* Mistral2_Regular::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add regular constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, n=_vars.size();
+    Mistral::VarArray scope;
+    Mistral::Vector< int > transitions;
+    Mistral::Vector< int > finals;
+    for(i=0; i<n; ++i) {
+      _vars.set_item(i, _vars.get_item(i)->add(solver, false));
+      scope.add(_vars.get_item(i)->_self);
+    }
+    for(i=0; i<_transitions.size(); ++i) 
+      transitions.add(_transitions.get_item(i));
+    for(i=0; i<_finals.size(); ++i) 
+      finals.add(_finals.get_item(i));
+
+    _self = Regular(scope, _initial, transitions, finals);
+
+    if(top_level) {
+      _solver->solver->add( _self );
+    } else {
+      std::cerr << "Error: Regular can only be used as a top-level constraint" << std::endl;
+      exit(1);
+    }
+  }
+  return this;
+}
+
+Mistral2_MDD::Mistral2_MDD(Mistral2ExpArray& vars, Mistral2IntArray& edges)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating an mdd constraint" << std::endl;
+#endif
+  _vars = vars;
+  _edges = edges;
+}
+
+Mistral2_MDD::Mistral2_MDD(Mistral2_Expression *var1, Mistral2_Expression *var2, 
+			   Mistral2IntArray& edges)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary mdd constraint" << std::endl;
+#endif
+  _vars.add(var1);
+  _vars.add(var2);
+  _edges = edges;
+}
+
+Mistral2_MDD::~Mistral2_MDD()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete mdd" << std::endl;
+#endif
+}
+
+Mistral2_Expression* Mistral2_MDD::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add mdd constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, n=_vars.size();
+    Mistral::VarArray scope;
+    Mistral::Vector< int > edges;
+    for(i=0; i<n; ++i) {
+      _vars.set_item(i, _vars.get_item(i)->add(solver, false));
+      scope.add(_vars.get_item(i)->_self);
+    }
+    for(i=0; i<_edges.size(); ++i) 
+      edges.add(_edges.get_item(i));
+
+    _self = MDD(scope, edges);
+
+    if(top_level) {
+      _solver->solver->add( _self );
+    } else {
+      std::cerr << "Error: MDD can only be used as a top-level constraint" << std::endl;
+      exit(1);
+    }
+  }
+  return this;
+}
+
+
+Mistral2_Circuit::Mistral2_Circuit(Mistral2ExpArray& vars)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a circuit constraint" << std::endl;
+#endif
+  _vars = vars;
+}
+
+Mistral2_Circuit::Mistral2_Circuit(Mistral2_Expression *var1, Mistral2_Expression *var2)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary circuit constraint" << std::endl;
+#endif
+  _vars.add(var1);
+  _vars.add(var2);
+}
+
+Mistral2_Circuit::~Mistral2_Circuit()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete circuit" << std::endl;
+#endif
+}
+
+Mistral2_Expression* Mistral2_Circuit::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add circuit constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, n=_vars.size();
+    Mistral::VarArray scope;
+    for(i=0; i<n; ++i) {
+      _vars.set_item(i, _vars.get_item(i)->add(solver, false));
+      scope.add(_vars.get_item(i)->_self);
+    }
+
+    _self = Circuit(scope);
+
+    if(top_level) {
+      _solver->solver->add( _self );
+    } else {
+      std::cerr << "Error: Circuit can only be used as a top-level constraint" << std::endl;
+      exit(1);
+    }
+  }
+  return this;
+}
+
+Mistral2_WeightedCircuit::Mistral2_WeightedCircuit(Mistral2ExpArray& vars, Mistral2IntArray& weights)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a weighted circuit constraint" << std::endl;
+#endif
+  _vars = vars;
+  _weights = weights;
+}
+
+Mistral2_WeightedCircuit::Mistral2_WeightedCircuit(Mistral2_Expression *var1, Mistral2_Expression *var2, 
+						   Mistral2IntArray& weights)
+  : Mistral2_Expression()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "creating a binary weighted circuit constraint" << std::endl;
+#endif
+  _vars.add(var1);
+  _vars.add(var2);
+  _weights = weights;
+}
+
+Mistral2_WeightedCircuit::~Mistral2_WeightedCircuit()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "delete weighted circuit" << std::endl;
+#endif
+}
+
+Mistral2_Expression* Mistral2_WeightedCircuit::add(Mistral2Solver *solver, bool top_level)
+{
+  if(!has_been_added()) {
+#ifdef _DEBUGWRAP
+    std::cout << "add weighted circuit constraint" << std::endl;
+#endif
+
+    _solver = solver;
+
+    int i, n=_vars.size()-1;
+    Mistral::VarArray scope;
+    Mistral::Vector< int > weights;
+    for(i=0; i<=n; ++i) {
+      _vars.set_item(i, _vars.get_item(i)->add(solver, false));
+      if(i<n) scope.add(_vars.get_item(i)->_self);
+    }
+    for(i=0; i<n*n; ++i) 
+      weights.add(_weights.get_item(i));
+
+    _self = Circuit(scope, weights, _vars.get_item(n)->_self);
+
+    if(top_level) {
+      _solver->solver->add( _self );
+    } else {
+      std::cerr << "Error: WeightedCircuit can only be used as a top-level constraint" << std::endl;
+      exit(1);
+    }
+  }
+  return this;
+}
+
+
 /* Leq operator */
 
 Mistral2_le::Mistral2_le(Mistral2_Expression *var1, Mistral2_Expression *var2)
@@ -1527,6 +2015,16 @@ void Mistral2Solver::add(Mistral2_Expression* arg)
   
 }
 
+void Mistral2Solver::load_xml(const char* filename, const int type)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "loading xcsp instance " << filename << std::endl;
+#endif
+
+  // the file is streamed, the tuples of each relation are shared by its tables
+  solver->parse_xcsp(filename);
+}
+
 void Mistral2Solver::initialise(Mistral2ExpArray& arg)
 {
 #ifdef _DEBUGWRAP
@@ -1950,6 +2448,76 @@ int Mistral2Solver::getPropags()
   return solver->statistics.num_propagations;
 }
 
+void Mistral2Solver::setProfiling(const int flag)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "set propagator profiling to " << flag << std::endl;
+#endif
+  solver->parameters.profiling = flag;
+}
+
+void Mistral2Solver::printPropagatorProfile()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "printing propagator profile" <<std::endl;
+#endif
+  solver->statistics.print_propagator_profile(std::cout);
+}
+
+int Mistral2Solver::getNumPropagatorTypes()
+{
+#ifdef _DEBUGWRAP
+  std::cout << "return number of propagator types" <<std::endl;
+#endif
+  solver->statistics.get_propagator_profile(profile);
+  return profile.size();
+}
+
+const char* Mistral2Solver::getPropagatorType(const int i)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "return name of propagator type " << i <<std::endl;
+#endif
+  if(i<0 || i>=(int)(profile.size())) return "";
+  return profile[i].name.c_str();
+}
+
+int Mistral2Solver::getPropagatorCalls(const int i)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "return number of calls to propagator type " << i <<std::endl;
+#endif
+  if(i<0 || i>=(int)(profile.size())) return 0;
+  return profile[i].num_calls;
+}
+
+int Mistral2Solver::getPropagatorPrunings(const int i)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "return number of prunings of propagator type " << i <<std::endl;
+#endif
+  if(i<0 || i>=(int)(profile.size())) return 0;
+  return profile[i].num_prunings;
+}
+
+int Mistral2Solver::getPropagatorFailures(const int i)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "return number of failures of propagator type " << i <<std::endl;
+#endif
+  if(i<0 || i>=(int)(profile.size())) return 0;
+  return profile[i].num_failures;
+}
+
+double Mistral2Solver::getPropagatorCycles(const int i)
+{
+#ifdef _DEBUGWRAP
+  std::cout << "return cycles spent in propagator type " << i <<std::endl;
+#endif
+  if(i<0 || i>=(int)(profile.size())) return 0;
+  return (double)(profile[i].num_cycles);
+}
+
 double Mistral2Solver::getTime()
 {
 #ifdef _DEBUGWRAP
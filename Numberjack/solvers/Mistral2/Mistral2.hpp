@@ -254,12 +254,23 @@ private:
    */
   Mistral2ExpArray _vars;
 
+  /**
+   * Consistency level of the propagator (FORWARD_CHECKING, BOUND_CONSISTENCY or ARC_CONSISTENCY)
+   */
+  int _consistency;
+
 public:
   
   /**
    * All Different constraint on an array of expressions
    */
   Mistral2_AllDiff(Mistral2ExpArray& vars);
+
+  /**
+   * All Different constraint with a given propagator type: 
+   * "gac" for Regin's matching-based filtering, "bc" for bounds and "fc" for forward checking
+   */
+  Mistral2_AllDiff(Mistral2ExpArray& vars, const char* type);
   
   /**
    * All Different constraint on two expressions, equivalent to a not equal 
@@ -279,6 +290,60 @@ public:
   virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
 };
 
+/**
+ * Table constraint
+ */
+class Mistral2_Table : public Mistral2_Expression
+{
+private:
+
+  /**
+   * Variables in scope of constraint
+   */
+  Mistral2ExpArray _vars;
+
+  /**
+   * The tuples, flattened one after the other
+   */
+  Mistral2IntArray _tuples;
+
+  /**
+   * True if the tuples are supports, false if they are conflicts
+   */
+  bool _support;
+
+public:
+
+  /**
+   * Table constraint on an array of expressions
+   */
+  Mistral2_Table(Mistral2ExpArray& vars, Mistral2IntArray& tuples, const char* type);
+
+  /**
+   * Table constraint on two expressions
+   */
+  Mistral2_Table(Mistral2_Expression *var1, Mistral2_Expression *var2, Mistral2IntArray& tuples, const char* type);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_Table();
+
+  /**
+   * Add a tuple to the table
+   */
+  void add(Mistral2IntArray& tuple);
+
+  /**
+   * Adds the constraint into the solver, as a Compact-Table propagator, or as
+   * a decision diagram propagator when the reduced MDD of the table is much smaller.
+   * A table of conflicts is first converted into the table of its supports.
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
 /**
  * GCC constraint 
  */
@@ -678,6 +743,279 @@ public:
   virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
 };
 
+/**
+ * Unary resource constraint: no two tasks overlap
+ */
+class Mistral2_UnaryResource : public Mistral2_Expression
+{
+private:
+
+  /**
+   * The start times of the tasks
+   */
+  Mistral2ExpArray _vars;
+
+  /**
+   * The durations of the tasks
+   */
+  Mistral2IntArray _durations;
+
+public:
+
+  /**
+   * Unary resource constraint on an array of tasks
+   */
+  Mistral2_UnaryResource(Mistral2ExpArray& vars, Mistral2IntArray& durations);
+
+  /**
+   * Unary resource constraint on two tasks
+   */
+  Mistral2_UnaryResource(Mistral2_Expression *var1, Mistral2_Expression *var2, Mistral2IntArray& durations);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_UnaryResource();
+
+  /**
+   * Adds the constraint into the solver, as a single global propagator
+   * (edge finding, not-first/not-last and detectable precedences) 
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
+class Mistral2_Cumulative : public Mistral2_Expression
+{
+private:
+
+  /**
+   * The start times of the tasks
+   */
+  Mistral2ExpArray _vars;
+
+  /**
+   * The durations of the tasks
+   */
+  Mistral2IntArray _durations;
+
+  /**
+   * The demands of the tasks
+   */
+  Mistral2IntArray _demands;
+
+  /**
+   * The capacity of the resource
+   */
+  int _capacity;
+
+public:
+
+  /**
+   * Cumulative resource constraint on an array of tasks
+   */
+  Mistral2_Cumulative(Mistral2ExpArray& vars, Mistral2IntArray& durations, 
+		      Mistral2IntArray& demands, int capacity);
+
+  /**
+   * Cumulative resource constraint on two tasks
+   */
+  Mistral2_Cumulative(Mistral2_Expression *var1, Mistral2_Expression *var2, Mistral2IntArray& durations, 
+		      Mistral2IntArray& demands, int capacity);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_Cumulative();
+
+  /**
+   * Adds the constraint into the solver, as a single global propagator
+   * (time-tabling and energetic overload check) 
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
+/**
+ * Regular constraint 
+ */
+class Mistral2_Regular : public Mistral2_Expression
+{
+private:
+
+  /**
+   * Variables in scope of constraint
+   */
+  Mistral2ExpArray _vars;
+
+  /**
+   * The transitions of the automaton, as triplets (state, value, next state)
+   */
+  Mistral2IntArray _transitions;
+
+  /**
+   * The initial state of the automaton
+   */
+  int _initial;
+
+  /**
+   * The final states of the automaton
+   */
+  Mistral2IntArray _finals;
+
+public:
+
+  /**
+   * Regular constraint on an array of expressions
+   */
+  Mistral2_Regular(Mistral2ExpArray& vars, Mistral2IntArray& transitions, 
+		   int initial, Mistral2IntArray& finals);
+
+  /**
+   * Regular constraint on two expressions
+   */
+  Mistral2_Regular(Mistral2_Expression *var1, Mistral2_Expression *var2, Mistral2IntArray& transitions, 
+		   int initial, Mistral2IntArray& finals);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_Regular();
+
+  /**
+   * Adds the constraint into the solver, as a decision diagram propagator 
+   * over the unfolding of the automaton
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
+/**
+ * MDD constraint 
+ */
+class Mistral2_MDD : public Mistral2_Expression
+{
+private:
+
+  /**
+   * Variables in scope of constraint
+   */
+  Mistral2ExpArray _vars;
+
+  /**
+   * The edges of the diagram, as triplets (node, value, child), the root is node 0
+   */
+  Mistral2IntArray _edges;
+
+public:
+
+  /**
+   * MDD constraint on an array of expressions
+   */
+  Mistral2_MDD(Mistral2ExpArray& vars, Mistral2IntArray& edges);
+
+  /**
+   * MDD constraint on two expressions
+   */
+  Mistral2_MDD(Mistral2_Expression *var1, Mistral2_Expression *var2, Mistral2IntArray& edges);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_MDD();
+
+  /**
+   * Adds the constraint into the solver, as a decision diagram propagator
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
+/**
+ * Circuit constraint 
+ */
+class Mistral2_Circuit : public Mistral2_Expression
+{
+private:
+
+  /**
+   * The successor variables
+   */
+  Mistral2ExpArray _vars;
+
+public:
+
+  /**
+   * Circuit constraint on an array of expressions
+   */
+  Mistral2_Circuit(Mistral2ExpArray& vars);
+
+  /**
+   * Circuit constraint on two expressions
+   */
+  Mistral2_Circuit(Mistral2_Expression *var1, Mistral2_Expression *var2);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_Circuit();
+
+  /**
+   * Adds the constraint into the solver, as a single global propagator
+   * (subtour elimination and dominators of the graph of the domains)
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
+/**
+ * Weighted circuit constraint 
+ */
+class Mistral2_WeightedCircuit : public Mistral2_Expression
+{
+private:
+
+  /**
+   * The successor variables, followed by the cost of the circuit
+   */
+  Mistral2ExpArray _vars;
+
+  /**
+   * The weights of the arcs, row by row
+   */
+  Mistral2IntArray _weights;
+
+public:
+
+  /**
+   * Weighted circuit constraint on an array of expressions (the last one is the cost)
+   */
+  Mistral2_WeightedCircuit(Mistral2ExpArray& vars, Mistral2IntArray& weights);
+
+  /**
+   * Weighted circuit constraint on a successor variable and the cost
+   */
+  Mistral2_WeightedCircuit(Mistral2_Expression *var1, Mistral2_Expression *var2, Mistral2IntArray& weights);
+
+  /**
+   * Destructor
+   */
+  virtual ~Mistral2_WeightedCircuit();
+
+  /**
+   * Adds the constraint into the solver, as a circuit propagator and a 
+   * propagator of the cost, based on the assignment relaxation
+   *
+   * see Expression::add()
+   */
+  virtual Mistral2_Expression* add(Mistral2Solver *solver, bool top_level);
+};
+
 class Mistral2_le: public Mistral2_binop
 {
 public:
@@ -762,6 +1100,9 @@ public:
   Mistral::RestartPolicy *_restart_policy;
   Mistral::Goal *_search_goal;
 
+  // snapshot of the propagator profile, refreshed by getNumPropagatorTypes()
+  std::vector<Mistral::PropagatorProfile> profile;
+
   Mistral2Solver();
   virtual ~Mistral2Solver();
 
@@ -769,6 +1110,9 @@ public:
   // each node of the tree is added separately, depth first.
   void add(Mistral2_Expression* arg);
 
+  // read an XCSP 2.1 instance into the solver (type is only used by Mistral)
+  void load_xml(const char* filename, const int type=4);
+
   // used to initialise search on a given subset of variables
   void initialise(Mistral2ExpArray& arg);
   // initialise the solver before solving (no more calls to add after this)
@@ -839,6 +1183,16 @@ public:
   int getPropags();
   double getTime();
 
+  // propagator profiling (requires setProfiling(1) before solving)
+  void setProfiling(const int flag);
+  void printPropagatorProfile();
+  int getNumPropagatorTypes();
+  const char* getPropagatorType(const int i);
+  int getPropagatorCalls(const int i);
+  int getPropagatorPrunings(const int i);
+  int getPropagatorFailures(const int i);
+  double getPropagatorCycles(const int i);
+
   int getRandomNumber();
 
   int getNumVariables();
@@ -0,0 +1,132 @@
+
+#include <mistral_solver.hpp>
+#include <mistral_variable.hpp>
+#include <mistral_search.hpp>
+
+
+using namespace std;
+using namespace Mistral;
+
+
+// Microbenchmark of the bulk operations of the Bitset class, with every
+// implementation of the kernels supported by the processor (portable,
+// SSE4.2, AVX2), on sets of 64 to 65536 values. The results (a checksum
+// of the sets and counts) must be identical at every level. The last
+// column times 'set_domain' and 'remove_set' on a Variable of the same
+// size, with a backtrack after each call:
+//   bitset_bench [number of iterations (x1000)] [seed]
+int main(int argc, char *argv[])
+{
+
+  int i, k, l, n, iterations=10000, seed=12345;
+  if(argc>1) iterations = atoi(argv[1]);
+  if(argc>2) seed = atoi(argv[2]);
+  iterations *= 1000;
+
+  const char* level_name[3] = {"portable", "sse4.2", "avx2"};
+  int best_level = set_bitset_kernels(BITSET_AVX2);
+
+  cout << " c bitset kernels: " << level_name[best_level] << " (" << iterations << " iterations)" << endl;
+  cout << setw(8) << "values" << setw(10) << "level"
+       << setw(10) << "and" << setw(10) << "or" << setw(10) << "andnot" << setw(10) << "count"
+       << setw(10) << "andcount" << setw(10) << "intersect" << setw(10) << "includes"
+       << setw(10) << "domain" << setw(12) << "checksum" << endl;
+
+  bool ok = true;
+  for(n=64; n<=65536; n*=4) {
+    unsigned int reference = 0;
+    // fewer iterations on larger sets
+    int num_iterations = iterations * 64 / n + 1;
+    for(l=BITSET_PORTABLE; l<=best_level; ++l) {
+      set_bitset_kernels(l);
+      usrand(seed);
+
+      BitSet a(0, n-1, BitSet::empt), b(0, n-1, BitSet::empt), c(0, n-1, BitSet::empt);
+      for(i=0; i<n; ++i) {
+	if(randint(2)) a.add(i);
+	if(randint(4)) b.add(i);
+      }
+      unsigned int checksum = 0;
+      double time[8];
+      double start;
+
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) { c.copy(a); c.intersect_with(b); }
+      time[0] = cpu_time() - start;
+      checksum = checksum*31 + c.size();
+
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) { c.copy(a); c.union_with(b); }
+      time[1] = cpu_time() - start;
+      checksum = checksum*31 + c.size();
+
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) { c.copy(a); c.setminus_with(b); }
+      time[2] = cpu_time() - start;
+      checksum = checksum*31 + c.size();
+
+      unsigned int total = 0;
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) { 
+	total += a.size(); 
+	if(a.contain(k%n)) a.remove(k%n); else a.add(k%n);
+      }
+      time[3] = cpu_time() - start;
+      checksum = checksum*31 + total;
+
+      total = 0;
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) { 
+	total += a.intersection_size(b); 
+	if(a.contain(k%n)) a.remove(k%n); else a.add(k%n);
+      }
+      time[4] = cpu_time() - start;
+      checksum = checksum*31 + total;
+
+      // c is a subset of b that intersects a only on its last value
+      c.copy(b); c.setminus_with(a); c.add(n-1); a.add(n-1);
+      total = 0;
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) total += a.intersect(c);
+      time[5] = cpu_time() - start;
+      checksum = checksum*31 + total;
+
+      total = 0;
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) total += b.includes(c);
+      time[6] = cpu_time() - start;
+      checksum = checksum*31 + total;
+
+      // domain reductions on a bitset variable
+      Solver s;
+      Variable X(0, n-1);
+      s.add( X != n/2 );
+      s.consolidate();
+      total = 0;
+      start = cpu_time();
+      for(k=0; k<num_iterations; ++k) {
+	s.save();
+	if(k&1) X.set_domain(a);
+	else X.remove_set(a);
+	total += X.get_size();
+	s.restore();
+      }
+      time[7] = cpu_time() - start;
+      checksum = checksum*31 + total;
+
+      cout << setw(8) << n << setw(10) << level_name[l];
+      for(i=0; i<8; ++i) cout << setw(10) << (time[i]*1e9/num_iterations);
+      cout << setw(12) << checksum << endl;
+
+      if(l == BITSET_PORTABLE) reference = checksum;
+      else if(checksum != reference) {
+	cout << " c Error: the " << level_name[l] << " kernels disagree with the portable ones" << endl;
+	ok = false;
+      }
+    }
+  }
+
+  cout << " c times in nanoseconds per operation" << endl;
+
+  return (ok ? 0 : 1);
+}
@@ -0,0 +1,79 @@
+
+#include <mistral_solver.hpp>
+#include <mistral_variable.hpp>
+#include <mistral_search.hpp>
+
+
+using namespace std;
+using namespace Mistral;
+
+
+// Large random linear constraints: N variables in [0,D], K weighted sums
+// over all of them (random weights in [-W,W]) constrained to a window
+// just above the middle of their range, and the minimisation of another
+// random weighted sum. It measures the throughput of the sum propagator:
+//   linear_sum [N] [K] [D] [W] [seed] [node limit]
+int main(int argc, char *argv[])
+{
+
+  int i, k, N=10000, K=4, D=9, W=20, seed=12345, node_limit=2000;
+  if(argc>1) N = atoi(argv[1]);
+  if(argc>2) K = atoi(argv[2]);
+  if(argc>3) D = atoi(argv[3]);
+  if(argc>4) W = atoi(argv[4]);
+  if(argc>5) seed = atoi(argv[5]);
+  if(argc>6) node_limit = atoi(argv[6]);
+
+  usrand(seed);
+
+  Solver s;
+  VarArray X(N, 0, D);
+  Vector< int > weights;
+
+  for(k=0; k<K; ++k) {
+    int smin = 0, smax = 0;
+    weights.clear();
+    for(i=0; i<N; ++i) {
+      weights.add((int)(randint(2*W)) - W);
+      if(weights[i] >= 0) ++weights[i];
+      if(weights[i] > 0) smax += weights[i]*D;
+      else smin += weights[i]*D;
+    }
+    s.add( Sum(X, weights, smin + (smax-smin)/2, smin + 5*(smax-smin)/8) );
+  }
+
+  weights.clear();
+  for(i=0; i<N; ++i) weights.add(1+randint(W));
+  Variable obj(0, N*W*D);
+  s.add( Sum(X, weights) == obj );
+
+  s.consolidate();
+
+  s.parameters.verbosity = 0;
+  s.parameters.node_limit = node_limit;
+
+  cout << " c linear sums: " << K << " x " << N << " terms in [0," << D << "], weights in [-"
+       << W << "," << W << "]" << endl;
+
+  double start = get_run_time();
+
+  Outcome result = s.depth_first_search(X,
+					new GenericHeuristic<
+					  GenericDVO<
+					    MinDomainOverWeight, 1,
+					    FailureCountManager
+					    >,
+					  RandomMinMax >(&s),
+					new Geometric(),
+					new Goal(Goal::MINIMIZATION, obj.get_var()));
+
+  double runtime = (get_run_time() - start);
+
+  cout << " d OBJECTIVE " << (s.objective ? s.objective->upper_bound : 0) << endl
+       << " d NODES " << s.statistics.num_nodes << endl
+       << " d PROPAGATIONS " << s.statistics.num_propagations << endl
+       << " d RUNTIME " << runtime << endl
+       << " d NODES/s " << (runtime > 0 ? (double)(s.statistics.num_nodes)/runtime : 0) << endl
+       << (result == OPT ? " s OPTIMUM FOUND" : (result == SAT ? " s SATISFIABLE" : (result == UNSAT ? " s UNSATISFIABLE" : " s UNKNOWN"))) << endl;
+
+}
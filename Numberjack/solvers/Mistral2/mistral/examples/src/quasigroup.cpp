@@ -0,0 +1,99 @@
+
+#include <mistral_solver.hpp>
+#include <mistral_variable.hpp>
+#include <mistral_search.hpp>
+
+
+using namespace std;
+using namespace Mistral;
+
+
+// Quasigroup completion (QWH): a random latin square of order N is built
+// by shuffling the rows, columns and symbols of the cyclic square, then a
+// percentage of its cells are emptied. The instance is solved with the
+// AllDiff constraints on rows and columns at the given consistency level:
+//   quasigroup [N] [holes (%)] [seed] [fc|bc|gac] [time limit]
+int main(int argc, char *argv[])
+{
+
+  int i, j, N=20, holes=42, seed=12345, ct=ARC_CONSISTENCY;
+  double time_limit = 60;
+  if(argc>1) N = atoi(argv[1]);
+  if(argc>2) holes = atoi(argv[2]);
+  if(argc>3) seed = atoi(argv[3]);
+  if(argc>4) {
+    string consistency(argv[4]);
+    if(consistency == "fc") ct = FORWARD_CHECKING;
+    else if(consistency == "bc") ct = BOUND_CONSISTENCY;
+  }
+  if(argc>5) time_limit = atof(argv[5]);
+
+  usrand(seed);
+
+  // random latin square
+  Vector< int > row, col, sym;
+  for(i=0; i<N; ++i) {
+    row.add(i);
+    col.add(i);
+    sym.add(i);
+  }
+  for(i=N-1; i>0; --i) {
+    std::swap(row[i], row[randint(i+1)]);
+    std::swap(col[i], col[randint(i+1)]);
+    std::swap(sym[i], sym[randint(i+1)]);
+  }
+
+  Solver s;
+  VarArray X(N*N, 0, N-1);
+  VarArray scope;
+
+  for(i=0; i<N; ++i) {
+    scope.clear();
+    for(j=0; j<N; ++j) scope.add(X[i*N+j]);
+    s.add( AllDiff(scope, ct) );
+    scope.clear();
+    for(j=0; j<N; ++j) scope.add(X[j*N+i]);
+    s.add( AllDiff(scope, ct) );
+  }
+
+  int num_holes = 0;
+  for(i=0; i<N; ++i) {
+    for(j=0; j<N; ++j) {
+      if((int)(randint(100)) < holes) ++num_holes;
+      else s.add( X[i*N+j] == sym[(row[i]+col[j])%N] );
+    }
+  }
+
+  s.consolidate();
+
+  s.parameters.verbosity = 1;
+  s.parameters.time_limit = time_limit;
+
+  cout << " c quasigroup completion: order " << N << ", " << num_holes << " holes, "
+       << (ct == FORWARD_CHECKING ? "fc" : (ct == BOUND_CONSISTENCY ? "bc" : "gac")) << endl;
+
+  double start = get_run_time();
+
+  Outcome result = s.depth_first_search(X,
+					new GenericHeuristic<
+					  GenericDVO<
+					    MinDomainOverWeight, 1,
+					    FailureCountManager
+					    >,
+					  RandomMinMax >(&s),
+					new Geometric());
+
+  if(result == SAT) {
+    for(i=0; i<N; ++i) {
+      cout << " c";
+      for(j=0; j<N; ++j)
+	cout << setw(3) << X[i*N+j].get_solution_int_value();
+      cout << endl;
+    }
+  }
+
+  cout << " d NODES " << s.statistics.num_nodes << endl
+       << " d RUNTIME " << (get_run_time() - start) << endl
+       << (result == SAT ? " s SATISFIABLE" : (result == UNSAT ? " s UNSATISFIABLE" : " s UNKNOWN")) << endl;
+
+}
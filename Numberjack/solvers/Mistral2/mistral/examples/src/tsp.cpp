@@ -0,0 +1,112 @@
+
+#include <fstream>
+#include <math.h>
+
+#include <mistral_solver.hpp>
+#include <mistral_variable.hpp>
+#include <mistral_search.hpp>
+
+
+using namespace std;
+using namespace Mistral;
+
+
+// Travelling salesman on the instances of the scheduler ("tsp" type, one
+// line per city: id, x, y, demand, release date, due date, duration), with
+// the truncated euclidean distance. The tour is either modelled with the
+// Circuit constraint (subtour elimination and assignment bound) or with
+// its decomposition into an AllDiff and the positions of the cities:
+//   tsp [data file] [circuit|alldiff] [time limit] [seed]
+int main(int argc, char *argv[])
+{
+
+  int i, j, N, seed=12345;
+  double time_limit = 30;
+  string model("circuit");
+  const char* filename = "data/scheduling/tsp/rand20.txt";
+  if(argc>1) filename = argv[1];
+  if(argc>2) model = argv[2];
+  if(argc>3) time_limit = atof(argv[3]);
+  if(argc>4) seed = atoi(argv[4]);
+
+  usrand(seed);
+
+  ifstream infile( filename, ios_base::in );
+  infile >> N;
+  if(!infile.good()) {
+    cerr << "Error: cannot read " << filename << endl;
+    exit(1);
+  }
+
+  Vector< double > X, Y;
+  double dump;
+  for(i=0; i<N; ++i) {
+    infile >> dump;
+    X.add(0);
+    Y.add(0);
+    infile >> X[i] >> Y[i];
+    for(j=0; j<4; ++j) infile >> dump;
+  }
+
+  Vector< int > distance;
+  int max_distance = 0;
+  for(i=0; i<N; ++i)
+    for(j=0; j<N; ++j) {
+      distance.add((int)(sqrt((X[i] - X[j])*(X[i] - X[j]) + (Y[i] - Y[j])*(Y[i] - Y[j]))));
+      if(max_distance < distance.back()) max_distance = distance.back();
+    }
+
+  Solver s;
+  VarArray next(N, 0, N-1);
+  Variable length(0, N*max_distance);
+
+  if(model == "alldiff") {
+    VarArray position(N, 0, N-1);
+    VarArray legs, row;
+    s.add( AllDiff(next, ARC_CONSISTENCY) );
+    s.add( position[0] == 0 );
+    for(i=0; i<N; ++i) {
+      s.add( next[i] != i );
+      for(j=1; j<N; ++j)
+	if(j != i) s.add( (next[i] != j) || (position[j] == (position[i]+1)) );
+      row.clear();
+      for(j=0; j<N; ++j) row.add( Variable(distance[i*N+j], distance[i*N+j]) );
+      legs.add( Element(row, next[i]) );
+    }
+    s.add( Sum(legs) == length );
+  } else {
+    s.add( Circuit(next, distance, length) );
+  }
+
+  s.consolidate();
+
+  s.parameters.verbosity = 1;
+  s.parameters.time_limit = time_limit;
+
+  cout << " c tsp: " << N << " cities, " << model << " model" << endl;
+
+  double start = get_run_time();
+
+  Outcome result = s.depth_first_search(next,
+					new GenericHeuristic<
+					  GenericDVO<
+					    MinDomainOverWeight, 1,
+					    FailureCountManager
+					    >,
+					  RandomMinMax >(&s),
+					new Geometric(),
+					new Goal(Goal::MINIMIZATION, length.get_var()));
+
+  if(result == SAT || result == OPT) {
+    cout << " c 0";
+    for(i=next[0].get_solution_int_value(); i; i=next[i].get_solution_int_value())
+      cout << " " << i;
+    cout << endl;
+  }
+
+  cout << " d OBJECTIVE " << (s.objective ? s.objective->upper_bound : 0) << endl
+       << " d NODES " << s.statistics.num_nodes << endl
+       << " d RUNTIME " << (get_run_time() - start) << endl
+       << (result == OPT ? " s OPTIMUM FOUND" : (result == SAT ? " s SATISFIABLE" : (result == UNSAT ? " s UNSATISFIABLE" : " s UNKNOWN"))) << endl;
+
+}
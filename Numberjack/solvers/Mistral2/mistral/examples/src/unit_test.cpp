@@ -460,6 +460,123 @@ public:
   virtual void run();
 };
 
+class TableTest : public UnitTest {
+
+public:
+  
+  TableTest();
+  ~TableTest();
+
+  int count_solutions(const int arity, Vector< const int* >& tuples, 
+		      const TableExpression::AlgorithmType ct);
+
+  virtual void run();
+};
+
+class LazyClauseTest : public UnitTest {
+
+public:
+  
+  LazyClauseTest();
+  ~LazyClauseTest();
+
+  int optimum(const int seed, const bool lcg, const bool with_element);
+
+  virtual void run();
+};
+
+class AllDiffGACTest : public UnitTest {
+
+public:
+  
+  AllDiffGACTest();
+  ~AllDiffGACTest();
+
+  int count_solutions(Vector< Vector< int > >& domains, const int ct);
+
+  virtual void run();
+};
+
+class UnaryResourceTest : public UnitTest {
+
+public:
+  
+  UnaryResourceTest();
+  ~UnaryResourceTest();
+
+  virtual void run();
+};
+
+class CumulativeTest : public UnitTest {
+
+public:
+  
+  CumulativeTest();
+  ~CumulativeTest();
+
+  virtual void run();
+};
+
+class GaussJordanTest : public UnitTest {
+
+public:
+  
+  GaussJordanTest();
+  ~GaussJordanTest();
+
+  virtual void run();
+};
+
+class MDDTest : public UnitTest {
+
+public:
+  
+  MDDTest();
+  ~MDDTest();
+
+  virtual void run();
+};
+
+class CircuitTest : public UnitTest {
+
+public:
+  
+  CircuitTest();
+  ~CircuitTest();
+
+  virtual void run();
+};
+
+class RandomElementTest : public UnitTest {
+
+public:
+  
+  RandomElementTest();
+  ~RandomElementTest();
+
+  virtual void run();
+};
+
+class RandomBoolSumTest : public UnitTest {
+
+public:
+  
+  RandomBoolSumTest();
+  ~RandomBoolSumTest();
+
+  virtual void run();
+};
+
+class BitsetTest : public UnitTest {
+
+public:
+  
+  BitsetTest();
+  ~BitsetTest();
+
+  virtual void run();
+};
+
 class MinMaxTest : public UnitTest {
 
 public:
@@ -1863,6 +1980,17 @@ int main(int argc, char *argv[])
   tests.push_back(new BoolPigeons(N+1, EXPRESSION));
   tests.push_back(new BoolPigeons(N+1, BITSET_VAR));
   */
+  tests.push_back(new TableTest());
+  tests.push_back(new LazyClauseTest());
+  tests.push_back(new AllDiffGACTest());
+  tests.push_back(new UnaryResourceTest());
+  tests.push_back(new CumulativeTest());
+  tests.push_back(new GaussJordanTest());
+  tests.push_back(new MDDTest());
+  tests.push_back(new CircuitTest());
+  tests.push_back(new BitsetTest());
+  tests.push_back(new RandomElementTest());
+  tests.push_back(new RandomBoolSumTest());
   tests.push_back(new SatTest());
   /*
   tests.push_back(new Pigeons(N+2)); 
@@ -6690,6 +6818,804 @@ void ElementTest::run() {
 }
 
 
+TableTest::TableTest() : UnitTest() {}
+TableTest::~TableTest() {}
+
+int TableTest::count_solutions(const int arity, Vector< const int* >& tuples, 
+			       const TableExpression::AlgorithmType ct) {
+  Solver s;
+
+  // variables with holes, so that some tuples are invalid from the start
+  VarArray X;
+  for(int i=0; i<arity; ++i) {
+    Vector< int > vals;
+    for(int v=0; v<6; ++v) 
+      if(v != i) vals.add(v);
+    X.add(Variable(vals));
+  }
+
+  // the constraint takes ownership of the list (but not of the tuples)
+  Vector< const int* > relation;
+  for(unsigned int k=0; k<tuples.size; ++k) relation.add(tuples[k]);
+  s.add( Table(X, relation, ct) );
+  relation.neutralise();
+  s.add( X[0] != X[arity-1] );
+
+  s.initialise_search(X,
+		      new GenericHeuristic< Lexicographic, MinValue >(&s), 
+		      new NoRestart());
+
+  int num_solutions = 0;
+  while(s.get_next_solution() == SAT) {
+    const int *sol = NULL;
+    for(int k=0; !sol && k<(int)tuples.size; ++k) {
+      sol = tuples[k];
+      for(int i=0; sol && i<arity; ++i)
+	if(X[i].get_solution_int_value() != sol[i]) sol = NULL;
+    }
+    if(!sol) {
+      cout << "Error: solution not in the table!" << endl;
+      exit(1);
+    }
+    ++num_solutions;
+  }
+
+  return num_solutions;
+}
+
+void TableTest::run() {
+  if(Verbosity) cout << "Run Table test: "; 
+
+  int arity = 4;
+  for(int iter=0; iter<20; ++iter) {
+    Vector< const int* > tuples;
+    int num_tuples = 50 + randint(400);
+    for(int k=0; k<num_tuples; ++k) {
+      int *t = new int[arity];
+      for(int i=0; i<arity; ++i) t[i] = randint(7)-1;
+      tuples.add(t);
+    }
+
+    // brute force count of the allowed tuples that satisfy the side constraint
+    int num_sols = 0;
+    int sol[4];
+    for(int c=0; c<6*6*6*6; ++c) {
+      int code = c;
+      bool ok = true;
+      for(int i=0; i<arity; ++i) {
+	sol[i] = code%6;
+	code /= 6;
+	if(sol[i] == i) ok = false;
+      }
+      if(!ok || sol[0] == sol[arity-1]) continue;
+      for(int k=0; k<(int)tuples.size; ++k) {
+	ok = true;
+	for(int i=0; ok && i<arity; ++i) ok = (tuples[k][i] == sol[i]);
+	if(ok) {
+	  ++num_sols;
+	  break;
+	}
+      }
+    }
+
+    int ct_sols = count_solutions(arity, tuples, TableExpression::CT);
+
+    if(ct_sols != num_sols) {
+      cout << "Error: wrong number of solutions! (" 
+	   << ct_sols << " / " << num_sols << ")" << endl;
+      exit(1);
+    }
+
+    for(unsigned int k=0; k<tuples.size; ++k) delete [] tuples[k];
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+LazyClauseTest::LazyClauseTest() : UnitTest() {}
+LazyClauseTest::~LazyClauseTest() {}
+
+int LazyClauseTest::optimum(const int seed, const bool lcg, const bool with_element) {
+  Solver s;
+  VarArray X;
+  Vector< int > w;
+  int i, n = 7;
+
+  usrand(seed);
+  if(with_element) {
+    VarArray T;
+    for(i=0; i<n; ++i) T.add(Variable(0, 9));
+    for(i=0; i<n; ++i) X.add(Variable(0, n-1));
+    for(i=0; i<n; ++i) X.add(Element(T, X[i]));
+    s.add( AllDiff(T, BOUND_CONSISTENCY) );
+    for(i=0; i+1<n; ++i) s.add( X[n+i] + 1 <= X[n+i+1] );
+  } else {
+    for(i=0; i<n; ++i) X.add(Variable(0, n+randint(3)));
+    s.add( AllDiff(X, BOUND_CONSISTENCY) );
+    for(int c=0; c<3; ++c) {
+      VarArray scp;
+      Vector< int > coefs;
+      for(i=0; i<n; ++i) if(randint(2)) {
+	  scp.add(X[i]);
+	  coefs.add(1+randint(3));
+	}
+      if(scp.size > 1) s.add( Sum(scp, coefs, 0, 3*n+randint(3*n)) );
+    }
+    for(i=0; i+1<n; i+=2) s.add( Precedence(X[i], 2, X[i+1]) );
+  }
+  for(i=0; i<(int)(X.size); ++i) w.add(randint(7)-3);
+
+  Variable objective(-100000, 100000);
+  s.add( Sum(X, w) == objective );
+  s.consolidate();
+  s.parameters.lazy_generation = lcg;
+  s.parameters.verbosity = 0;
+
+  Outcome result = 
+    s.depth_first_search(s.variables, 
+			 new GenericHeuristic< GenericDVO< MinDomainOverWeight, 1, FailureCountManager >, MinValue >(&s), 
+			 new NoRestart(), 
+			 new Goal(Goal::MINIMIZATION, objective.get_var()));
+
+  if(lcg && !s.lazy_base) {
+    cout << "Error: lazy clause generation is off!" << endl;
+    exit(1);
+  }
+
+  return (result == OPT ? s.objective->upper_bound : (result == UNSAT ? INFTY : -INFTY));
+}
+
+void LazyClauseTest::run() {
+  if(Verbosity) cout << "Run lazy clause generation test: "; 
+
+  for(int iter=0; iter<20; ++iter) {
+    int seed = randint(100000);
+    for(int k=0; k<2; ++k) {
+      int opt = optimum(seed, false, k);
+      int lcg_opt = optimum(seed, true, k);
+      if(opt != lcg_opt) {
+	cout << "Error: wrong optimum with lazy clause generation! (" 
+	     << lcg_opt << " instead of " << opt << ")" << endl;
+	exit(1);
+      }
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+AllDiffGACTest::AllDiffGACTest() : UnitTest() {}
+AllDiffGACTest::~AllDiffGACTest() {}
+
+// whether the variables from i onward can take distinct values in 'domains', given the values already used
+static bool has_distinct_values(Vector< Vector< int > >& domains, const int i, Vector< int >& used) {
+  if(i == (int)(domains.size)) return true;
+  for(unsigned int k=0; k<domains[i].size; ++k) {
+    int v = domains[i][k];
+    bool free_value = true;
+    for(unsigned int j=0; free_value && j<used.size; ++j) free_value = (used[j] != v);
+    if(!free_value) continue;
+    used.add(v);
+    bool ok = has_distinct_values(domains, i+1, used);
+    used.pop();
+    if(ok) return true;
+  }
+  return false;
+}
+
+int AllDiffGACTest::count_solutions(Vector< Vector< int > >& domains, const int ct) {
+  Solver s;
+  VarArray X;
+  for(unsigned int i=0; i<domains.size; ++i) X.add(Variable(domains[i]));
+  s.add( AllDiff(X, ct) );
+
+  if(ct == ARC_CONSISTENCY) {
+    s.consolidate();
+    if(s.propagate()) {
+      // every value left must belong to a solution
+      Vector< Vector< int > > current;
+      current.initialise(domains.size, domains.size);
+      for(unsigned int i=0; i<X.size; ++i) {
+	int v, vnext = X[i].get_min();
+	do {
+	  v = vnext;
+	  current[i].add(v);
+	  vnext = X[i].next(v);
+	} while( v < vnext );
+      }
+      for(unsigned int i=0; i<X.size; ++i) {
+	Vector< int > dom_i = current[i];
+	for(unsigned int k=0; k<dom_i.size; ++k) {
+	  Vector< int > used;
+	  current[i].clear();
+	  current[i].add(dom_i[k]);
+	  if(!has_distinct_values(current, 0, used)) {
+	    cout << "Error: " << X[i] << "=" << dom_i[k] << " has no support!" << endl;
+	    exit(1);
+	  }
+	}
+	current[i] = dom_i;
+      }
+    }
+  }
+
+  s.initialise_search(X,
+		      new GenericHeuristic< Lexicographic, MinValue >(&s), 
+		      new NoRestart());
+
+  int num_solutions = 0;
+  while(s.get_next_solution() == SAT) ++num_solutions;
+  return num_solutions;
+}
+
+void AllDiffGACTest::run() {
+  if(Verbosity) cout << "Run AllDiff (GAC) test: "; 
+
+  for(int iter=0; iter<100; ++iter) {
+    int n = 4+randint(4);
+    Vector< Vector< int > > domains;
+    domains.initialise(n, n);
+    for(int i=0; i<n; ++i) {
+      // at least two values, since constants cannot be branched on
+      while(domains[i].size < 2) {
+	domains[i].clear();
+	for(int v=0; v<n+1; ++v) if(randint(3)) domains[i].add(v);
+      }
+    }
+
+    int fc_sols = count_solutions(domains, FORWARD_CHECKING);
+    int gac_sols = count_solutions(domains, ARC_CONSISTENCY);
+    if(fc_sols != gac_sols) {
+      cout << "Error: wrong number of solutions! (" 
+	   << gac_sols << " instead of " << fc_sols << ")" << endl;
+      exit(1);
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+UnaryResourceTest::UnaryResourceTest() : UnitTest() {}
+UnaryResourceTest::~UnaryResourceTest() {}
+
+void UnaryResourceTest::run() {
+  if(Verbosity) cout << "Run UnaryResource test: "; 
+
+  for(int iter=0; iter<200; ++iter) {
+    int i, j, k, n = 2+randint(4), horizon = 0;
+    int start[6], lb[6], ub[6];
+    Vector< int > durations;
+    for(i=0; i<n; ++i) {
+      durations.add(1+randint(4));
+      horizon += durations[i];
+    }
+    for(i=0; i<n; ++i) {
+      lb[i] = randint(3);
+      ub[i] = lb[i]+2+randint(std::max(1, horizon-durations[i]-lb[i]));
+    }
+
+    // count the solutions by enumeration
+    int num_solutions = 0;
+    for(i=0; i<n; ++i) start[i] = lb[i];
+    do {
+      bool ok = true;
+      for(i=0; ok && i<n; ++i)
+	for(j=i+1; ok && j<n; ++j)
+	  ok = (start[i]+durations[i] <= start[j] || start[j]+durations[j] <= start[i]);
+      num_solutions += ok;
+      for(k=0; k<n && start[k]==ub[k]; ++k) start[k] = lb[k];
+      if(k<n) ++start[k];
+      else break;
+    } while(true);
+
+    Solver s;
+    VarArray X;
+    for(i=0; i<n; ++i) X.add(Variable(lb[i], ub[i]));
+    s.add( UnaryResource(X, durations) );
+
+    s.initialise_search(X,
+			new GenericHeuristic< Lexicographic, MinValue >(&s), 
+			new NoRestart());
+
+    int count = 0;
+    while(s.get_next_solution() == SAT) ++count;
+    if(count != num_solutions) {
+      cout << "Error: wrong number of solutions! (" 
+	   << count << " instead of " << num_solutions << ")" << endl;
+      exit(1);
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+CumulativeTest::CumulativeTest() : UnitTest() {}
+CumulativeTest::~CumulativeTest() {}
+
+void CumulativeTest::run() {
+  if(Verbosity) cout << "Run Cumulative test: "; 
+
+  for(int iter=0; iter<200; ++iter) {
+    int i, j, k, load, n = 2+randint(4), capacity = 2+randint(4), horizon = 0;
+    int start[6], lb[6], ub[6];
+    Vector< int > durations, demands;
+    for(i=0; i<n; ++i) {
+      durations.add(randint(4));
+      demands.add(randint(capacity+1));
+      horizon += durations[i];
+    }
+    horizon /= 2;
+    for(i=0; i<n; ++i) {
+      lb[i] = randint(3);
+      ub[i] = lb[i]+2+randint(std::max(1, horizon));
+    }
+
+    // count the solutions by enumeration
+    int num_solutions = 0;
+    for(i=0; i<n; ++i) start[i] = lb[i];
+    do {
+      bool ok = true;
+      for(i=0; ok && i<n; ++i) {
+	load = 0;
+	for(j=0; j<n; ++j)
+	  if(start[j] <= start[i] && start[j]+durations[j] > start[i]) load += demands[j];
+	ok = (load <= capacity);
+      }
+      num_solutions += ok;
+      for(k=0; k<n && start[k]==ub[k]; ++k) start[k] = lb[k];
+      if(k<n) ++start[k];
+      else break;
+    } while(true);
+
+    Solver s;
+    VarArray X;
+    for(i=0; i<n; ++i) X.add(Variable(lb[i], ub[i]));
+    s.add( Cumulative(X, durations, demands, capacity, iter%2) );
+
+    s.initialise_search(X,
+			new GenericHeuristic< Lexicographic, MinValue >(&s), 
+			new NoRestart());
+
+    int count = 0;
+    while(s.get_next_solution() == SAT) ++count;
+    if(count != num_solutions) {
+      cout << "Error: wrong number of solutions! (" 
+	   << count << " instead of " << num_solutions << ")" << endl;
+      exit(1);
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+GaussJordanTest::GaussJordanTest() : UnitTest() {}
+GaussJordanTest::~GaussJordanTest() {}
+
+void GaussJordanTest::run() {
+  if(Verbosity) cout << "Run GaussJordan test: "; 
+
+  for(int iter=0; iter<200; ++iter) {
+    int i, j, k, x, n = 3+randint(8), m = 1+randint(n);
+    Vector< Vector< int > > equations;
+    Vector< int > parities;
+    Vector< bool > used;
+    used.initialise(n, n, false);
+    for(i=0; i<m; ++i) {
+      equations.add(Vector< int >());
+      for(k=2+randint(3); k--;) {
+	x = randint(n);
+	for(j=equations.back().size; j-- && equations.back()[j]!=x;);
+	if(j<0) equations.back().add(x);
+	used[x] = true;
+      }
+      parities.add(randint(2));
+    }
+    // every variable must be constrained
+    for(x=0; x<n; ++x) if(!used[x]) equations[randint(m)].add(x);
+
+    // count the solutions by enumeration
+    int num_solutions = 0;
+    for(int sol=0; sol<(1<<n); ++sol) {
+      bool ok = true;
+      for(i=0; ok && i<m; ++i) {
+	k = parities[i];
+	for(j=0; j<(int)(equations[i].size); ++j) k ^= ((sol >> equations[i][j]) & 1);
+	ok = !k;
+      }
+      num_solutions += ok;
+    }
+
+    Solver s;
+    VarArray X(n, 0, 1), scope;
+    for(i=0; i<m; ++i) {
+      scope.clear();
+      for(j=0; j<(int)(equations[i].size); ++j) scope.add(X[equations[i][j]]);
+      s.add( Parity(scope, parities[i]) );
+    }
+    s.consolidate();
+    s.gaussian_elimination();
+
+    s.initialise_search(X,
+			new GenericHeuristic< Lexicographic, MinValue >(&s), 
+			new NoRestart());
+
+    int count = 0;
+    while(s.get_next_solution() == SAT) ++count;
+    if(count != num_solutions) {
+      cout << "Error: wrong number of solutions! (" 
+	   << count << " instead of " << num_solutions << ")" << endl;
+      exit(1);
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+MDDTest::MDDTest() : UnitTest() {}
+MDDTest::~MDDTest() {}
+
+void MDDTest::run() {
+  if(Verbosity) cout << "Run MDD test: "; 
+
+  for(int iter=0; iter<200; ++iter) {
+    int i, k, q, n = 1+randint(5), d = 2+randint(3), S = 1+randint(5);
+    int init = randint(S);
+    Vector< int > transitions, finals;
+    for(k=randint(2*S*(d+1)); k--;) {
+      transitions.add(randint(S));
+      transitions.add(randint(d+1));
+      transitions.add(randint(S));
+    }
+    for(q=0; q<S; ++q) if(randint(2)) finals.add(q);
+
+    // enumerate the words accepted by the (non-deterministic) automaton
+    Vector< const int* > tuples;
+    Vector< int > word, current, next;
+    word.initialise(n, n, 0);
+    while(true) {
+      current.clear();
+      current.add(init);
+      for(i=0; i<n; ++i) {
+	next.clear();
+	for(k=0; k<(int)(transitions.size); k+=3) 
+	  for(q=0; q<(int)(current.size); ++q)
+	    if(transitions[k] == current[q] && transitions[k+1] == word[i]) {
+	      next.add(transitions[k+2]);
+	      break;
+	    }
+	current = next;
+      }
+      bool accepted = false;
+      for(q=0; q<(int)(current.size); ++q)
+	for(k=0; k<(int)(finals.size); ++k)
+	  accepted |= (current[q] == finals[k]);
+      if(accepted) {
+	int *tuple = new int[n];
+	for(i=0; i<n; ++i) tuple[i] = word[i];
+	tuples.add(tuple);
+      }
+      for(i=0; i<n && word[i]==d; ++i) word[i] = 0;
+      if(i == n) break;
+      ++word[i];
+    }
+    int num_solutions = tuples.size;
+
+    for(int model=0; model<2; ++model) {
+      Solver s;
+      VarArray X(n, 0, d);
+      if(model) {
+	s.add( Table(X, tuples, TableExpression::MDD4R) );
+      } else {
+	s.add( Regular(X, init, transitions, finals) );
+      }
+      s.consolidate();
+
+      s.initialise_search(X,
+			  new GenericHeuristic< Lexicographic, MinValue >(&s), 
+			  new NoRestart());
+
+      int count = 0;
+      while(s.get_next_solution() == SAT) ++count;
+      if(count != num_solutions) {
+	cout << "Error: wrong number of solutions! (" 
+	     << count << " instead of " << num_solutions << ")" << endl;
+	exit(1);
+      }
+    }
+
+    tuples.neutralise();
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+CircuitTest::CircuitTest() : UnitTest() {}
+CircuitTest::~CircuitTest() {}
+
+void CircuitTest::run() {
+  if(Verbosity) cout << "Run Circuit test: "; 
+
+  for(int iter=0; iter<200; ++iter) {
+    int i, j, k, cost, n = 2+randint(5), bound = 4*n+randint(20);
+    Vector< Vector< int > > domains;
+    Vector< int > weights, idx, next;
+    for(i=0; i<n; ++i) {
+      domains.add(Vector< int >());
+      for(j=0; j<n; ++j) 
+	if(j == i ? !randint(4) : randint(3)) domains.back().add(j);
+      while(domains.back().size < 2) {
+	j = randint(n);
+	for(k=domains.back().size; k-- && domains.back()[k]!=j;);
+	if(k<0) domains.back().add(j);
+      }
+      for(j=0; j<n; ++j) weights.add(randint(10));
+    }
+
+    // count the circuits, and those within the bound, by enumeration
+    int num_circuits = 0, num_cheap_circuits = 0;
+    idx.initialise(n, n, 0);
+    next.initialise(n, n, 0);
+    while(true) {
+      for(i=0; i<n; ++i) next[i] = domains[i][idx[i]];
+      cost = 0;
+      j = 0;
+      k = 0;
+      do {
+	cost += weights[j*n+next[j]];
+	j = next[j];
+      } while(++k < n && j);
+      if(!j && k == n) {
+	++num_circuits;
+	if(cost <= bound) ++num_cheap_circuits;
+      }
+      for(i=0; i<n && idx[i]==(int)(domains[i].size)-1; ++i) idx[i] = 0;
+      if(i == n) break;
+      ++idx[i];
+    }
+
+    for(int weighted=0; weighted<2; ++weighted) {
+      Solver s;
+      VarArray X;
+      for(i=0; i<n; ++i) X.add(Variable(domains[i]));
+      if(weighted) {
+	Variable total(0, bound);
+	s.add( Circuit(X, weights, total) );
+      } else {
+	s.add( Circuit(X) );
+      }
+      s.consolidate();
+
+      s.initialise_search(X,
+			  new GenericHeuristic< Lexicographic, MinValue >(&s), 
+			  new NoRestart());
+
+      int count = 0;
+      while(s.get_next_solution() == SAT) ++count;
+      if(count != (weighted ? num_cheap_circuits : num_circuits)) {
+	cout << "Error: wrong number of solutions! (" 
+	     << count << " instead of " << (weighted ? num_cheap_circuits : num_circuits) << ")" << endl;
+	exit(1);
+      }
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+RandomElementTest::RandomElementTest() : UnitTest() {}
+RandomElementTest::~RandomElementTest() {}
+
+void RandomElementTest::run() {
+  if(Verbosity) cout << "Run random Element test: "; 
+
+  // random instances, with constant and variable arrays
+  for(int iter=0; iter<300; ++iter) {
+    int i, k, n = 1+randint(5), d = 2+randint(5), offset = randint(3)-1;
+    bool constant = randint(2);
+    // X[0..n-1], N and V
+    Vector< Vector< int > > domains;
+    for(i=0; i<n+2; ++i) domains.add(Vector< int >());
+    for(i=0; i<n; ++i) {
+      if(constant) domains[i].add(randint(d));
+      else for(k=0; k<d; ++k) if(randint(2) || (k==d-1 && domains[i].empty())) domains[i].add(k);
+    }
+    for(k=offset-1; k<=n+offset; ++k) if(randint(4)) domains[n].add(k);
+    if(domains[n].empty()) domains[n].add(offset);
+    for(k=-1; k<=d; ++k) if(randint(3)) domains[n+1].add(k);
+    if(domains[n+1].empty()) domains[n+1].add(0);
+
+    // count the solutions by enumeration
+    int num_solutions = 0;
+    Vector< int > idx;
+    idx.initialise(n+2, n+2, 0);
+    while(true) {
+      k = domains[n][idx[n]]-offset;
+      if(k >= 0 && k < n && domains[k][idx[k]] == domains[n+1][idx[n+1]]) ++num_solutions;
+      for(i=0; i<n+2 && idx[i]==(int)(domains[i].size)-1; ++i) idx[i] = 0;
+      if(i == n+2) break;
+      ++idx[i];
+    }
+
+    Solver s;
+    VarArray X, vars;
+    for(i=0; i<n; ++i) 
+      X.add(domains[i].size > 1 ? Variable(domains[i]) : Variable(domains[i][0], domains[i][0]));
+    Variable N(domains[n]), V(domains[n+1]);
+    s.add( Element(X, N, offset) == V );
+    s.consolidate();
+
+    for(i=0; i<n; ++i) if(!X[i].is_ground()) vars.add(X[i]);
+    if(!N.is_ground()) vars.add(N);
+    if(!V.is_ground()) vars.add(V);
+
+    int count = 0;
+    if(!s.propagate()) count = 0;
+    else if(vars.empty()) count = 1;
+    else {
+      s.initialise_search(vars,
+			  new GenericHeuristic< Lexicographic, MinValue >(&s), 
+			  new NoRestart());
+      while(s.get_next_solution() == SAT) ++count;
+    }
+    if(count != num_solutions) {
+      cout << "Error: wrong number of solutions! (" 
+	   << count << " instead of " << num_solutions << ")" << endl;
+      exit(1);
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+RandomBoolSumTest::RandomBoolSumTest() : UnitTest() {}
+RandomBoolSumTest::~RandomBoolSumTest() {}
+
+void RandomBoolSumTest::run() {
+  if(Verbosity) cout << "Run random watched BoolSum test: "; 
+
+  // random one-sided (weighted) sums, with watched literals and with counters
+  for(int iter=0; iter<300; ++iter) {
+    int i, j, k, n = 3+randint(8), m = 1+randint(4);
+    Vector< Vector< int > > weights;
+    Vector< int > lb, ub;
+    for(j=0; j<m; ++j) {
+      weights.add(Vector< int >());
+      int min_sum = 0, max_sum = 0;
+      bool weighted = randint(2);
+      for(i=0; i<n; ++i) {
+	weights[j].add(weighted ? randint(11)-4 : 1);
+	if(weights[j][i] < 0) min_sum += weights[j][i];
+	else max_sum += weights[j][i];
+      }
+      k = min_sum + randint(max_sum-min_sum+1);
+      if(randint(2)) {
+	lb.add(k);
+	ub.add(INFTY);
+      } else {
+	lb.add(-INFTY);
+	ub.add(k);
+      }
+    }
+
+    // count the solutions by enumeration
+    int num_solutions = 0;
+    for(int sol=0; sol<(1<<n); ++sol) {
+      bool ok = true;
+      for(j=0; ok && j<m; ++j) {
+	int total = 0;
+	for(i=0; i<n; ++i) if((sol>>i)&1) total += weights[j][i];
+	ok = (total >= lb[j] && total <= ub[j]);
+      }
+      if(ok) ++num_solutions;
+    }
+
+    for(int watched=0; watched<2; ++watched) {
+      Solver s;
+      VarArray X(n, 0, 1);
+      for(i=0; i<n; ++i) s.add(X[i]);
+      for(j=0; j<m; ++j) {
+	if(watched) s.add(Constraint(new ConstraintWatchedBoolSum(X, weights[j], lb[j], ub[j])));
+	else s.add(Constraint(new ConstraintIncrementalWeightedBoolSumInterval(X, weights[j], lb[j], ub[j])));
+      }
+      s.consolidate();
+
+      VarArray vars;
+      for(i=0; i<n; ++i) if(!X[i].is_ground()) vars.add(X[i]);
+
+      int count = 0;
+      if(!s.propagate()) count = 0;
+      else if(vars.empty()) count = 1;
+      else {
+	s.initialise_search(vars,
+			    new GenericHeuristic< Lexicographic, RandomMinMax >(&s), 
+			    new NoRestart());
+	while(s.get_next_solution() == SAT) ++count;
+      }
+      if(count != num_solutions) {
+	cout << "Error: wrong number of solutions! (" 
+	     << count << " instead of " << num_solutions << ")" << endl;
+	exit(1);
+      }
+    }
+  }
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
+BitsetTest::BitsetTest() : UnitTest() {}
+BitsetTest::~BitsetTest() {}
+
+void BitsetTest::run() {
+  if(Verbosity) cout << "Run Bitset test: "; 
+
+  int best_level = set_bitset_kernels();
+  for(int level=BITSET_PORTABLE; level<=best_level; ++level) {
+    set_bitset_kernels(level);
+    for(int iter=0; iter<100; ++iter) {
+      int v, lb[2], ub[2], inter=0, diff=0, size=0;
+      for(int k=0; k<2; ++k) {
+	lb[k] = randint(2000)-1000;
+	ub[k] = lb[k]+randint(3000);
+      }
+      BitSet a(lb[0], ub[0], BitSet::empt), b(lb[1], ub[1], BitSet::empt);
+      for(v=lb[0]; v<=ub[0]; ++v) if(randint(2)) a.add(v);
+      for(v=lb[1]; v<=ub[1]; ++v) if(randint(4)) b.add(v);
+      for(v=lb[0]; v<=ub[0]; ++v) 
+	if(a.contain(v)) {
+	  ++size;
+	  if(b.contain(v)) ++inter;
+	  else ++diff;
+	}
+
+      BitSet c(lb[0], ub[0], BitSet::empt);
+      c.copy(a);
+      c.setminus_with(b);
+      if((int)(a.size()) != size || (int)(a.intersection_size(b)) != inter || 
+	 a.intersect(b) != (inter>0) || a.includes(b) != ((int)(b.size()) == inter) ||
+	 (int)(c.size()) != diff) {
+	cout << "Error: wrong bitset operation!" << endl;
+	exit(1);
+      }
+
+      // domain reductions on a bitset variable
+      Solver s;
+      Variable X(lb[0], ub[0]+2);
+      s.add( X != ub[0]+1 );
+      s.consolidate();
+      int domain_size = X.get_size();
+      s.save();
+      Event evt = X.set_domain(b);
+      int expected = 0;
+      for(v=lb[0]; v<=ub[0]+2; ++v) if(v!=ub[0]+1 && b.contain(v)) ++expected;
+      if(evt == FAIL_EVENT ? expected : (int)(X.get_size()) != expected) {
+	cout << "Error: wrong domain after set_domain! (" << X.get_size() << " instead of " << expected << ")" << endl;
+	exit(1);
+      }
+      s.restore();
+      evt = X.remove_set(b);
+      expected = domain_size-expected;
+      if(evt == FAIL_EVENT ? expected : (int)(X.get_size()) != expected) {
+	cout << "Error: wrong domain after remove_set! (" << X.get_size() << " instead of " << expected << ")" << endl;
+	exit(1);
+      }
+    }
+  }
+  set_bitset_kernels(best_level);
+
+  if(Verbosity) cout << "OK" << endl; 
+}
+
+
 MinMaxTest::MinMaxTest() : UnitTest() {}
 MinMaxTest::~MinMaxTest() {}
 
@@ -42,6 +42,7 @@
 #include <string>
 #include <iostream>
 #include <cstdlib>
+#include <new>
 
 #define forceinline inline
 
@@ -67,11 +68,79 @@ namespace FlatZinc { namespace AST {
     std::string what(void) const { return _what; }
   };
 
+  /**
+   * \brief Memory arena for the nodes of abstract syntax trees
+   *
+   * While an arena is in use, nodes are carved out of large blocks instead
+   * of being allocated one by one, and all the blocks are freed at once
+   * when the arena is released. Deleting a node of an arena runs its
+   * destructor but does not free its memory.
+   */
+  class Arena {
+  private:
+    /// Blocks obtained from the heap
+    std::vector<char*> blocks;
+    /// Free part of the last block
+    char* top;
+    /// Size of the free part of the last block
+    size_t left;
+  public:
+    /// Size of the blocks
+    static const size_t blockSize = 1 << 20;
+    /// Constructor
+    Arena(void) : top(NULL), left(0) {}
+    /// Destructor
+    ~Arena(void) { release(); }
+    /// Allocate \a size bytes
+    void* alloc(size_t size);
+    /// Allocate the nodes created from now on in this arena
+    void use(void) { current() = this; }
+    /// Stop using this arena and free all its nodes
+    void release(void);
+    /// Return the arena in use (NULL if nodes are allocated on the heap)
+    static Arena*& current(void) {
+      static Arena* a = NULL;
+      return a;
+    }
+  };
+
+  inline void*
+  Arena::alloc(size_t size) {
+    size = (size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    if (size > left) {
+      left = size > blockSize ? size : blockSize;
+      top = static_cast<char*>(malloc(left));
+      if (top == NULL)
+        throw std::bad_alloc();
+      blocks.push_back(top);
+    }
+    void* p = top;
+    top += size;
+    left -= size;
+    return p;
+  }
+
+  inline void
+  Arena::release(void) {
+    if (current() == this)
+      current() = NULL;
+    for (unsigned int i=0; i<blocks.size(); i++)
+      free(blocks[i]);
+    blocks.clear();
+    top = NULL;
+    left = 0;
+  }
+
   /**
    * \brief A node in a %FlatZinc abstract syntax tree
    */
   class Node {
   public:
+    /// Allocate a node, in the arena in use if there is one
+    static void* operator new(size_t size);
+    /// Free a node, unless it belongs to an arena
+    static void operator delete(void* p);
+
     /// Destructor
     virtual ~Node(void);
 
@@ -169,7 +238,7 @@ namespace FlatZinc { namespace AST {
     bool interval;
     int min; int max;
     std::vector<int> s;
-    SetLit(void) {}
+    SetLit(void) : interval(false), min(0), max(-1) {}
     SetLit(int min0, int max0) : interval(true), min(min0), max(max0) {}
     SetLit(const std::vector<int>& s0) : interval(false), s(s0) {}
     bool empty(void) const {
@@ -298,6 +367,26 @@ namespace FlatZinc { namespace AST {
     }
   };
 
+  inline void*
+  Node::operator new(size_t size) {
+    // the word in front of the node tells whether it belongs to an arena
+    Arena* arena = Arena::current();
+    size += sizeof(size_t);
+    size_t* p = static_cast<size_t*>(arena ? arena->alloc(size)
+                                           : ::operator new(size));
+    *p = (arena == NULL);
+    return p+1;
+  }
+
+  inline void
+  Node::operator delete(void* n) {
+    if (n == NULL)
+      return;
+    size_t* p = static_cast<size_t*>(n) - 1;
+    if (*p)
+      ::operator delete(p);
+  }
+
   inline
   Node::~Node(void) {}
 
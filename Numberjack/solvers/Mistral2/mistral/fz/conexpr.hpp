@@ -50,8 +50,10 @@ namespace FlatZinc {
     std::string id;
     /// Constraint arguments
     AST::Array* args;
+    /// Index of the posting function in the registry (-1 if not resolved)
+    int poster;
     /// Constructor
-    ConExpr(const std::string& id0, AST::Array* args0);
+    ConExpr(const std::string& id0, AST::Array* args0, int poster0=-1);
     /// Return argument \a i
     AST::Node* operator[](int i) const;
     /// Destructor
@@ -59,8 +61,8 @@ namespace FlatZinc {
   };
 
   forceinline
-  ConExpr::ConExpr(const std::string& id0, AST::Array* args0)
-    : id(id0), args(args0) {}
+  ConExpr::ConExpr(const std::string& id0, AST::Array* args0, int poster0)
+    : id(id0), args(args0), poster(poster0) {}
 
   forceinline AST::Node*
   ConExpr::operator[](int i) const { return args->a[i]; }
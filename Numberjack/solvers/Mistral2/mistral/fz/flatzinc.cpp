@@ -188,6 +188,7 @@ FlatZincModel::FlatZincModel(Solver &s)
   _option_display_mistral_model(false),
   _option_annotations(false),
   _option_parity(0),
+  _option_gauss(false),
   intVarCount(-1), boolVarCount(-1), setVarCount(-1), _optVar(-1),
   _solveAnnotations(NULL)
 {
@@ -668,6 +669,11 @@ FlatZincModel::set_parity_processing(const int lvl) {
 	_option_parity = lvl;
 }
 
+void
+FlatZincModel::set_gaussian_elimination(const bool on) {
+	_option_gauss = on;
+}
+
 void
 FlatZincModel::set_display_model(const bool on) {
 	_option_display_mistral_model = on;
@@ -885,6 +891,9 @@ FlatZincModel::set_annotations(const bool on) {
     if(_option_parity)
       solver.parity_processing(_option_parity);
 
+    if(_option_gauss)
+      solver.gaussian_elimination();
+
     //std::cout << _variable_ordering << " " << _value_ordering << std::endl;
 
     _option_heuristic = solver.heuristic_factory(_variable_ordering, _value_ordering, _randomization);
@@ -284,6 +284,7 @@ protected:
   bool _option_display_solution;
   bool _option_annotations;
   int _option_parity;
+  bool _option_gauss;
 	////
 
 
@@ -381,6 +382,9 @@ public:
 	/// setup the rewriting step
 	void set_parity_processing(const int lvl);
 
+	/// setup the Gauss-Jordan elimination of parity constraints
+	void set_gaussian_elimination(const bool on);
+
 	/// setup the rewriting step
   void set_enumeration(const bool on);
 
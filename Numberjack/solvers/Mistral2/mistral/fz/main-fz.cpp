@@ -63,6 +63,9 @@ int main(int argc, char *argv[])
   TCLAP::ValueArg<int> parityArg("","parity","Uses parity processing", false, 0, "int");
   cmd.add( parityArg );
 
+  TCLAP::SwitchArg gaussArg("","gauss","Uses Gauss-Jordan elimination on parity constraints", false);
+  cmd.add( gaussArg );
+
   TCLAP::SwitchArg simple_rewriteArg("","simple_rewrite","Uses simple rewriting", false);
   cmd.add( simple_rewriteArg );
 
@@ -113,6 +116,7 @@ int main(int argc, char *argv[])
   fm->set_rewriting(cmd.use_rewrite());
   fm->set_simple_rewriting(simple_rewriteArg.getValue());
   fm->set_parity_processing(parityArg.getValue());
+  fm->set_gaussian_elimination(gaussArg.getValue());
   fm->set_enumeration(cmd.enumerate_solutions());
   fm->encode_clauses();
   fm->run(cout , p);
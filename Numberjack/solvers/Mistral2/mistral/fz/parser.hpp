@@ -87,6 +87,11 @@ namespace FlatZinc {
     FlatZinc::FlatZincModel* fg;
     std::vector<std::pair<std::string,AST::Node*> > _output;
 
+    /// Identifiers of the model
+    SymbolPool symbols;
+    /// Memory of the syntax trees of the constraint items
+    AST::Arena arena;
+
     SymbolTable<int> intvarTable;
     SymbolTable<int> boolvarTable;
     SymbolTable<int> floatvarTable;
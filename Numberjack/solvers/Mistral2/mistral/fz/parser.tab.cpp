@@ -72,6 +72,7 @@
 #define YYLEX_PARAM static_cast<ParserState*>(parm)->yyscanner
 #include "flatzinc.hpp"
 #include "parser.hpp"
+#include "registry.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -123,32 +124,32 @@ void yyassert(ParserState* pp, bool cond, const char* str)
  *
  */
 
-AST::Node* getArrayElement(ParserState* pp, string id, unsigned int offset) {
+AST::Node* getArrayElement(ParserState* pp, Symbol id, unsigned int offset) {
   if (offset > 0) {
-    vector<int> tmp;
-    if (pp->intvararrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::IntVar(tmp[offset-1]);
-    if (pp->boolvararrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::BoolVar(tmp[offset-1]);
-    if (pp->setvararrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::SetVar(tmp[offset-1]);
-
-    if (pp->intvalarrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::IntLit(tmp[offset-1]);
-    if (pp->boolvalarrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::BoolLit(tmp[offset-1]);
-    vector<AST::SetLit> tmpS;
-    if (pp->setvalarrays.get(id, tmpS) && offset<=tmpS.size())
-      return new AST::SetLit(tmpS[offset-1]);
+    const vector<int>* tmp;
+    if ((tmp = pp->intvararrays.find(id)) && offset<=tmp->size())
+      return new AST::IntVar((*tmp)[offset-1]);
+    if ((tmp = pp->boolvararrays.find(id)) && offset<=tmp->size())
+      return new AST::BoolVar((*tmp)[offset-1]);
+    if ((tmp = pp->setvararrays.find(id)) && offset<=tmp->size())
+      return new AST::SetVar((*tmp)[offset-1]);
+
+    if ((tmp = pp->intvalarrays.find(id)) && offset<=tmp->size())
+      return new AST::IntLit((*tmp)[offset-1]);
+    if ((tmp = pp->boolvalarrays.find(id)) && offset<=tmp->size())
+      return new AST::BoolLit((*tmp)[offset-1]);
+    const vector<AST::SetLit>* tmpS;
+    if ((tmpS = pp->setvalarrays.find(id)) && offset<=tmpS->size())
+      return new AST::SetLit((*tmpS)[offset-1]);
   }
 
-  pp->err << "Error: array access to " << id << " invalid"
+  pp->err << "Error: array access to " << pp->symbols.name(id) << " invalid"
           << " in line no. "
           << yyget_lineno(pp->yyscanner) << std::endl;
   pp->hadError = true;
   return new AST::IntVar(0); // keep things consistent
 }
-AST::Node* getVarRefArg(ParserState* pp, string id, bool annotation = false) {
+AST::Node* getVarRefArg(ParserState* pp, Symbol id, bool annotation = false) {
   int tmp;
   if (pp->intvarTable.get(id, tmp))
     return new AST::IntVar(tmp);
@@ -157,8 +158,8 @@ AST::Node* getVarRefArg(ParserState* pp, string id, bool annotation = false) {
   if (pp->setvarTable.get(id, tmp))
     return new AST::SetVar(tmp);
   if (annotation)
-    return new AST::Atom(id);
-  pp->err << "Error: undefined variable " << id
+    return new AST::Atom(pp->symbols.name(id));
+  pp->err << "Error: undefined variable " << pp->symbols.name(id)
           << " in line no. "
           << yyget_lineno(pp->yyscanner) << std::endl;
   pp->hadError = true;
@@ -172,7 +173,8 @@ void addDomainConstraint(ParserState* pp, std::string id, AST::Node* var,
   AST::Array* args = new AST::Array(2);
   args->a[0] = var;
   args->a[1] = dom.some();
-  pp->domainConstraints.push_back(new ConExpr(id, args));
+  pp->domainConstraints.push_back(new ConExpr(id, args,
+                                              registry().lookup(id.c_str())));
 }
 
 /*
@@ -237,6 +239,9 @@ void initfg(ParserState* pp) {
       }
     }
   }
+
+  // the syntax trees of the constraint items are freed at once, after posting
+  pp->arena.use();
 }
 
 void fillPrinter(ParserState& pp, FlatZinc::Printer& p) {
@@ -365,7 +370,7 @@ namespace FlatZinc {
 
 
 /* Line 268 of yacc.c  */
-#line 369 "parser.tab.cpp"
+#line 374 "parser.tab.cpp"
 
 /* Enabling traces.  */
 #ifndef YYDEBUG
@@ -446,7 +451,7 @@ typedef union YYSTYPE
 {
 
 /* Line 293 of yacc.c  */
-#line 337 "parser.yxx"
+#line 342 "parser.yxx"
  int iValue; char* sValue; bool bValue; double dValue;
          std::vector<int>* setValue;
          FlatZinc::AST::SetLit* setLit;
@@ -463,7 +468,7 @@ typedef union YYSTYPE
 
 
 /* Line 293 of yacc.c  */
-#line 467 "parser.tab.cpp"
+#line 472 "parser.tab.cpp"
 } YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define yystype YYSTYPE /* obsolescent; will be withdrawn */
@@ -475,7 +480,7 @@ typedef union YYSTYPE
 
 
 /* Line 343 of yacc.c  */
-#line 479 "parser.tab.cpp"
+#line 484 "parser.tab.cpp"
 
 #ifdef short
 # undef short
@@ -837,22 +842,22 @@ static const yytype_int8 yyrhs[] =
 /* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
 static const yytype_uint16 yyrline[] =
 {
-       0,   436,   436,   438,   440,   443,   444,   448,   449,   453,
-     454,   456,   458,   461,   462,   469,   471,   473,   476,   477,
-     480,   483,   484,   485,   486,   489,   490,   491,   492,   495,
-     496,   499,   500,   507,   537,   566,   571,   601,   625,   634,
-     646,   705,   757,   764,   819,   832,   845,   852,   866,   870,
-     885,   909,   910,   914,   916,   919,   919,   921,   925,   927,
-     942,   966,   967,   971,   973,   977,   981,   983,   998,  1022,
-    1023,  1027,  1029,  1032,  1035,  1037,  1052,  1076,  1077,  1081,
-    1083,  1086,  1091,  1092,  1097,  1098,  1103,  1104,  1109,  1110,
-    1114,  1128,  1141,  1163,  1165,  1167,  1173,  1175,  1188,  1189,
-    1196,  1198,  1205,  1206,  1210,  1212,  1217,  1218,  1222,  1224,
-    1229,  1230,  1234,  1236,  1241,  1242,  1246,  1248,  1256,  1258,
-    1262,  1264,  1269,  1270,  1274,  1276,  1278,  1280,  1282,  1331,
-    1345,  1346,  1350,  1352,  1360,  1371,  1393,  1394,  1402,  1403,
-    1407,  1409,  1413,  1417,  1421,  1423,  1427,  1429,  1433,  1435,
-    1437,  1439,  1441,  1484,  1495
+       0,   441,   441,   443,   445,   448,   449,   453,   454,   458,
+     459,   463,   464,   468,   469,   476,   478,   480,   483,   484,
+     487,   490,   491,   492,   493,   496,   497,   498,   499,   502,
+     503,   506,   507,   514,   544,   573,   578,   608,   632,   641,
+     653,   712,   764,   771,   826,   839,   852,   859,   873,   877,
+     892,   916,   917,   921,   923,   926,   926,   928,   932,   934,
+     949,   973,   974,   978,   980,   984,   988,   990,  1005,  1029,
+    1030,  1034,  1036,  1039,  1042,  1044,  1059,  1083,  1084,  1088,
+    1090,  1093,  1098,  1099,  1104,  1105,  1110,  1111,  1116,  1117,
+    1121,  1135,  1148,  1170,  1172,  1174,  1180,  1182,  1195,  1196,
+    1203,  1205,  1212,  1213,  1217,  1219,  1224,  1225,  1229,  1231,
+    1236,  1237,  1241,  1243,  1248,  1249,  1253,  1255,  1263,  1265,
+    1269,  1271,  1276,  1277,  1281,  1283,  1285,  1287,  1289,  1339,
+    1353,  1354,  1358,  1360,  1368,  1379,  1401,  1402,  1410,  1411,
+    1415,  1417,  1421,  1425,  1429,  1431,  1435,  1437,  1441,  1443,
+    1445,  1447,  1449,  1493,  1504
 };
 #endif
 
@@ -2019,27 +2024,41 @@ yyreduce:
         case 7:
 
 /* Line 1806 of yacc.c  */
-#line 448 "parser.yxx"
+#line 453 "parser.yxx"
     { initfg(static_cast<ParserState*>(parm)); }
     break;
 
   case 8:
 
 /* Line 1806 of yacc.c  */
-#line 450 "parser.yxx"
+#line 455 "parser.yxx"
     { initfg(static_cast<ParserState*>(parm)); }
     break;
 
+  case 11:
+
+/* Line 1806 of yacc.c  */
+#line 463 "parser.yxx"
+    { static_cast<ParserState*>(parm)->arena.release(); }
+    break;
+
+  case 12:
+
+/* Line 1806 of yacc.c  */
+#line 465 "parser.yxx"
+    { static_cast<ParserState*>(parm)->arena.release(); }
+    break;
+
   case 33:
 
 /* Line 1806 of yacc.c  */
-#line 508 "parser.yxx"
+#line 515 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, !(yyvsp[(2) - (6)].oSet)() || !(yyvsp[(2) - (6)].oSet).some()->empty(), "Empty var int domain.");
         bool print = (yyvsp[(5) - (6)].argVec)->hasAtom("output_var");
         bool introduced = (yyvsp[(5) - (6)].argVec)->hasAtom("var_is_introduced");
-        pp->intvarTable.put((yyvsp[(4) - (6)].sValue), pp->intvars.size());
+        pp->intvarTable.put(pp->symbols.intern((yyvsp[(4) - (6)].sValue)), pp->intvars.size());
         if (print) {
           pp->output(std::string((yyvsp[(4) - (6)].sValue)), new AST::IntVar(pp->intvars.size()));
         }
@@ -2068,12 +2087,12 @@ yyreduce:
   case 34:
 
 /* Line 1806 of yacc.c  */
-#line 538 "parser.yxx"
+#line 545 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[(5) - (6)].argVec)->hasAtom("output_var");
         bool introduced = (yyvsp[(5) - (6)].argVec)->hasAtom("var_is_introduced");
-        pp->boolvarTable.put((yyvsp[(4) - (6)].sValue), pp->boolvars.size());
+        pp->boolvarTable.put(pp->symbols.intern((yyvsp[(4) - (6)].sValue)), pp->boolvars.size());
         if (print) {
           pp->output(std::string((yyvsp[(4) - (6)].sValue)), new AST::BoolVar(pp->boolvars.size()));
         }
@@ -2102,7 +2121,7 @@ yyreduce:
   case 35:
 
 /* Line 1806 of yacc.c  */
-#line 567 "parser.yxx"
+#line 574 "parser.yxx"
     { ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, false, "Floats not supported.");
         delete (yyvsp[(5) - (6)].argVec); free((yyvsp[(4) - (6)].sValue));
@@ -2112,12 +2131,12 @@ yyreduce:
   case 36:
 
 /* Line 1806 of yacc.c  */
-#line 572 "parser.yxx"
+#line 579 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[(7) - (8)].argVec)->hasAtom("output_var");
         bool introduced = (yyvsp[(7) - (8)].argVec)->hasAtom("var_is_introduced");
-        pp->setvarTable.put((yyvsp[(6) - (8)].sValue), pp->setvars.size());
+        pp->setvarTable.put(pp->symbols.intern((yyvsp[(6) - (8)].sValue)), pp->setvars.size());
         if (print) {
           pp->output(std::string((yyvsp[(6) - (8)].sValue)), new AST::SetVar(pp->setvars.size()));
         }
@@ -2147,7 +2166,7 @@ yyreduce:
   case 37:
 
 /* Line 1806 of yacc.c  */
-#line 602 "parser.yxx"
+#line 609 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, !(yyvsp[(1) - (6)].oSet)() || !(yyvsp[(1) - (6)].oSet).some()->empty(), "Empty int domain.");
@@ -2168,7 +2187,7 @@ yyreduce:
             yyassert(pp, found, "Empty int domain.");
           }
         }
-        pp->intvals.put((yyvsp[(3) - (6)].sValue), i);
+        pp->intvals.put(pp->symbols.intern((yyvsp[(3) - (6)].sValue)), i);
         delete (yyvsp[(4) - (6)].argVec); free((yyvsp[(3) - (6)].sValue));
       }
     break;
@@ -2176,12 +2195,12 @@ yyreduce:
   case 38:
 
 /* Line 1806 of yacc.c  */
-#line 626 "parser.yxx"
+#line 633 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[(6) - (6)].arg)->isBool(), "Invalid bool initializer.");
         if ((yyvsp[(6) - (6)].arg)->isBool()) {
-          pp->boolvals.put((yyvsp[(3) - (6)].sValue), (yyvsp[(6) - (6)].arg)->getBool());
+          pp->boolvals.put(pp->symbols.intern((yyvsp[(3) - (6)].sValue)), (yyvsp[(6) - (6)].arg)->getBool());
         }
         delete (yyvsp[(4) - (6)].argVec); free((yyvsp[(3) - (6)].sValue));
       }
@@ -2190,7 +2209,7 @@ yyreduce:
   case 39:
 
 /* Line 1806 of yacc.c  */
-#line 635 "parser.yxx"
+#line 642 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, !(yyvsp[(3) - (8)].oSet)() || !(yyvsp[(3) - (8)].oSet).some()->empty(), "Empty set domain.");
@@ -2198,7 +2217,7 @@ yyreduce:
         AST::SetLit* set = NULL;
         if ((yyvsp[(8) - (8)].arg)->isSet())
           set = (yyvsp[(8) - (8)].arg)->getSet();
-        pp->setvals.put((yyvsp[(5) - (8)].sValue), *set);
+        pp->setvals.put(pp->symbols.intern((yyvsp[(5) - (8)].sValue)), *set);
         delete set;
         delete (yyvsp[(6) - (8)].argVec); free((yyvsp[(5) - (8)].sValue));
       }
@@ -2207,7 +2226,7 @@ yyreduce:
   case 40:
 
 /* Line 1806 of yacc.c  */
-#line 648 "parser.yxx"
+#line 655 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[(3) - (13)].iValue)==1, "Arrays must start at 1");
@@ -2261,7 +2280,7 @@ yyreduce:
             a->a.push_back(new AST::String(")"));
             pp->output(std::string((yyvsp[(11) - (13)].sValue)), a);
           }
-          pp->intvararrays.put((yyvsp[(11) - (13)].sValue), vars);
+          pp->intvararrays.put(pp->symbols.intern((yyvsp[(11) - (13)].sValue)), vars);
         }
         delete (yyvsp[(12) - (13)].argVec); free((yyvsp[(11) - (13)].sValue));
       }
@@ -2270,7 +2289,7 @@ yyreduce:
   case 41:
 
 /* Line 1806 of yacc.c  */
-#line 707 "parser.yxx"
+#line 714 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[(12) - (13)].argVec)->hasCall("output_array");
@@ -2317,7 +2336,7 @@ yyreduce:
             a->a.push_back(new AST::String(")"));
             pp->output(std::string((yyvsp[(11) - (13)].sValue)), a);
           }
-          pp->boolvararrays.put((yyvsp[(11) - (13)].sValue), vars);
+          pp->boolvararrays.put(pp->symbols.intern((yyvsp[(11) - (13)].sValue)), vars);
         }
         delete (yyvsp[(12) - (13)].argVec); free((yyvsp[(11) - (13)].sValue));
       }
@@ -2326,7 +2345,7 @@ yyreduce:
   case 42:
 
 /* Line 1806 of yacc.c  */
-#line 759 "parser.yxx"
+#line 766 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, false, "Floats not supported.");
@@ -2337,7 +2356,7 @@ yyreduce:
   case 43:
 
 /* Line 1806 of yacc.c  */
-#line 766 "parser.yxx"
+#line 773 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[(14) - (15)].argVec)->hasCall("output_array");
@@ -2387,7 +2406,7 @@ yyreduce:
             a->a.push_back(new AST::String(")"));
             pp->output(std::string((yyvsp[(13) - (15)].sValue)), a);
           }
-          pp->setvararrays.put((yyvsp[(13) - (15)].sValue), vars);
+          pp->setvararrays.put(pp->symbols.intern((yyvsp[(13) - (15)].sValue)), vars);
         }
         delete (yyvsp[(14) - (15)].argVec); free((yyvsp[(13) - (15)].sValue));
       }
@@ -2396,14 +2415,14 @@ yyreduce:
   case 44:
 
 /* Line 1806 of yacc.c  */
-#line 821 "parser.yxx"
+#line 828 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[(3) - (15)].iValue)==1, "Arrays must start at 1");
         yyassert(pp, (yyvsp[(14) - (15)].setValue)->size() == static_cast<unsigned int>((yyvsp[(5) - (15)].iValue)),
                  "Initializer size does not match array dimension");
         if (!pp->hadError)
-          pp->intvalarrays.put((yyvsp[(10) - (15)].sValue), *(yyvsp[(14) - (15)].setValue));
+          pp->intvalarrays.put(pp->symbols.intern((yyvsp[(10) - (15)].sValue)), *(yyvsp[(14) - (15)].setValue));
         delete (yyvsp[(14) - (15)].setValue);
         free((yyvsp[(10) - (15)].sValue));
         delete (yyvsp[(11) - (15)].argVec);
@@ -2413,14 +2432,14 @@ yyreduce:
   case 45:
 
 /* Line 1806 of yacc.c  */
-#line 834 "parser.yxx"
+#line 841 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[(3) - (15)].iValue)==1, "Arrays must start at 1");
         yyassert(pp, (yyvsp[(14) - (15)].setValue)->size() == static_cast<unsigned int>((yyvsp[(5) - (15)].iValue)),
                  "Initializer size does not match array dimension");
         if (!pp->hadError)
-          pp->boolvalarrays.put((yyvsp[(10) - (15)].sValue), *(yyvsp[(14) - (15)].setValue));
+          pp->boolvalarrays.put(pp->symbols.intern((yyvsp[(10) - (15)].sValue)), *(yyvsp[(14) - (15)].setValue));
         delete (yyvsp[(14) - (15)].setValue);
         free((yyvsp[(10) - (15)].sValue));
         delete (yyvsp[(11) - (15)].argVec);
@@ -2430,7 +2449,7 @@ yyreduce:
   case 46:
 
 /* Line 1806 of yacc.c  */
-#line 847 "parser.yxx"
+#line 854 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, false, "Floats not supported.");
@@ -2441,14 +2460,14 @@ yyreduce:
   case 47:
 
 /* Line 1806 of yacc.c  */
-#line 854 "parser.yxx"
+#line 861 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[(3) - (17)].iValue)==1, "Arrays must start at 1");
         yyassert(pp, (yyvsp[(16) - (17)].setValueList)->size() == static_cast<unsigned int>((yyvsp[(5) - (17)].iValue)),
                  "Initializer size does not match array dimension");
         if (!pp->hadError)
-          pp->setvalarrays.put((yyvsp[(12) - (17)].sValue), *(yyvsp[(16) - (17)].setValueList));
+          pp->setvalarrays.put(pp->symbols.intern((yyvsp[(12) - (17)].sValue)), *(yyvsp[(16) - (17)].setValueList));
         delete (yyvsp[(16) - (17)].setValueList);
         delete (yyvsp[(13) - (17)].argVec); free((yyvsp[(12) - (17)].sValue));
       }
@@ -2457,7 +2476,7 @@ yyreduce:
   case 48:
 
 /* Line 1806 of yacc.c  */
-#line 867 "parser.yxx"
+#line 874 "parser.yxx"
     {
         (yyval.varSpec) = new IntVarSpec((yyvsp[(1) - (1)].iValue),false);
       }
@@ -2466,11 +2485,11 @@ yyreduce:
   case 49:
 
 /* Line 1806 of yacc.c  */
-#line 871 "parser.yxx"
+#line 878 "parser.yxx"
     {
         int v = 0;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvarTable.get((yyvsp[(1) - (1)].sValue), v))
+        if (pp->intvarTable.get(pp->symbols.intern((yyvsp[(1) - (1)].sValue)), v))
           (yyval.varSpec) = new IntVarSpec(Alias(v),false);
         else {
           pp->err << "Error: undefined identifier " << (yyvsp[(1) - (1)].sValue)
@@ -2486,16 +2505,16 @@ yyreduce:
   case 50:
 
 /* Line 1806 of yacc.c  */
-#line 886 "parser.yxx"
+#line 893 "parser.yxx"
     {
-        vector<int> v;
+        const vector<int>* v;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvararrays.get((yyvsp[(1) - (4)].sValue), v)) {
+        if ((v = pp->intvararrays.find(pp->symbols.intern((yyvsp[(1) - (4)].sValue))))) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new IntVarSpec(Alias(v[(yyvsp[(3) - (4)].iValue)-1]),false);
+            (yyval.varSpec) = new IntVarSpec(Alias((*v)[(yyvsp[(3) - (4)].iValue)-1]),false);
           else
             (yyval.varSpec) = new IntVarSpec(0,false); // keep things consistent
         } else {
@@ -2512,53 +2531,53 @@ yyreduce:
   case 51:
 
 /* Line 1806 of yacc.c  */
-#line 909 "parser.yxx"
+#line 916 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
     break;
 
   case 52:
 
 /* Line 1806 of yacc.c  */
-#line 911 "parser.yxx"
+#line 918 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (2)].varSpecVec); }
     break;
 
   case 53:
 
 /* Line 1806 of yacc.c  */
-#line 915 "parser.yxx"
+#line 922 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[(1) - (1)].varSpec); }
     break;
 
   case 54:
 
 /* Line 1806 of yacc.c  */
-#line 917 "parser.yxx"
+#line 924 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (3)].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[(3) - (3)].varSpec)); }
     break;
 
   case 57:
 
 /* Line 1806 of yacc.c  */
-#line 922 "parser.yxx"
+#line 929 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(2) - (3)].varSpecVec); }
     break;
 
   case 58:
 
 /* Line 1806 of yacc.c  */
-#line 926 "parser.yxx"
+#line 933 "parser.yxx"
     { (yyval.varSpec) = new FloatVarSpec((yyvsp[(1) - (1)].dValue),false); }
     break;
 
   case 59:
 
 /* Line 1806 of yacc.c  */
-#line 928 "parser.yxx"
+#line 935 "parser.yxx"
     {
         int v = 0;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->floatvarTable.get((yyvsp[(1) - (1)].sValue), v))
+        if (pp->floatvarTable.get(pp->symbols.intern((yyvsp[(1) - (1)].sValue)), v))
           (yyval.varSpec) = new FloatVarSpec(Alias(v),false);
         else {
           pp->err << "Error: undefined identifier " << (yyvsp[(1) - (1)].sValue)
@@ -2574,16 +2593,16 @@ yyreduce:
   case 60:
 
 /* Line 1806 of yacc.c  */
-#line 943 "parser.yxx"
+#line 950 "parser.yxx"
     {
-        vector<int> v;
+        const vector<int>* v;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->floatvararrays.get((yyvsp[(1) - (4)].sValue), v)) {
+        if ((v = pp->floatvararrays.find(pp->symbols.intern((yyvsp[(1) - (4)].sValue))))) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new FloatVarSpec(Alias(v[(yyvsp[(3) - (4)].iValue)-1]),false);
+            (yyval.varSpec) = new FloatVarSpec(Alias((*v)[(yyvsp[(3) - (4)].iValue)-1]),false);
           else
             (yyval.varSpec) = new FloatVarSpec(0.0,false);
         } else {
@@ -2600,53 +2619,53 @@ yyreduce:
   case 61:
 
 /* Line 1806 of yacc.c  */
-#line 966 "parser.yxx"
+#line 973 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
     break;
 
   case 62:
 
 /* Line 1806 of yacc.c  */
-#line 968 "parser.yxx"
+#line 975 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (2)].varSpecVec); }
     break;
 
   case 63:
 
 /* Line 1806 of yacc.c  */
-#line 972 "parser.yxx"
+#line 979 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[(1) - (1)].varSpec); }
     break;
 
   case 64:
 
 /* Line 1806 of yacc.c  */
-#line 974 "parser.yxx"
+#line 981 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (3)].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[(3) - (3)].varSpec)); }
     break;
 
   case 65:
 
 /* Line 1806 of yacc.c  */
-#line 978 "parser.yxx"
+#line 985 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(2) - (3)].varSpecVec); }
     break;
 
   case 66:
 
 /* Line 1806 of yacc.c  */
-#line 982 "parser.yxx"
+#line 989 "parser.yxx"
     { (yyval.varSpec) = new BoolVarSpec((yyvsp[(1) - (1)].iValue),false); }
     break;
 
   case 67:
 
 /* Line 1806 of yacc.c  */
-#line 984 "parser.yxx"
+#line 991 "parser.yxx"
     {
         int v = 0;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->boolvarTable.get((yyvsp[(1) - (1)].sValue), v))
+        if (pp->boolvarTable.get(pp->symbols.intern((yyvsp[(1) - (1)].sValue)), v))
           (yyval.varSpec) = new BoolVarSpec(Alias(v),false);
         else {
           pp->err << "Error: undefined identifier " << (yyvsp[(1) - (1)].sValue)
@@ -2662,16 +2681,16 @@ yyreduce:
   case 68:
 
 /* Line 1806 of yacc.c  */
-#line 999 "parser.yxx"
+#line 1006 "parser.yxx"
     {
-        vector<int> v;
+        const vector<int>* v;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->boolvararrays.get((yyvsp[(1) - (4)].sValue), v)) {
+        if ((v = pp->boolvararrays.find(pp->symbols.intern((yyvsp[(1) - (4)].sValue))))) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new BoolVarSpec(Alias(v[(yyvsp[(3) - (4)].iValue)-1]),false);
+            (yyval.varSpec) = new BoolVarSpec(Alias((*v)[(yyvsp[(3) - (4)].iValue)-1]),false);
           else
             (yyval.varSpec) = new BoolVarSpec(false,false);
         } else {
@@ -2688,53 +2707,53 @@ yyreduce:
   case 69:
 
 /* Line 1806 of yacc.c  */
-#line 1022 "parser.yxx"
+#line 1029 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
     break;
 
   case 70:
 
 /* Line 1806 of yacc.c  */
-#line 1024 "parser.yxx"
+#line 1031 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (2)].varSpecVec); }
     break;
 
   case 71:
 
 /* Line 1806 of yacc.c  */
-#line 1028 "parser.yxx"
+#line 1035 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[(1) - (1)].varSpec); }
     break;
 
   case 72:
 
 /* Line 1806 of yacc.c  */
-#line 1030 "parser.yxx"
+#line 1037 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (3)].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[(3) - (3)].varSpec)); }
     break;
 
   case 73:
 
 /* Line 1806 of yacc.c  */
-#line 1032 "parser.yxx"
+#line 1039 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(2) - (3)].varSpecVec); }
     break;
 
   case 74:
 
 /* Line 1806 of yacc.c  */
-#line 1036 "parser.yxx"
+#line 1043 "parser.yxx"
     { (yyval.varSpec) = new SetVarSpec(Option<AST::SetLit*>::some((yyvsp[(1) - (1)].setLit)),false); }
     break;
 
   case 75:
 
 /* Line 1806 of yacc.c  */
-#line 1038 "parser.yxx"
+#line 1045 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         int v = 0;
-        if (pp->setvarTable.get((yyvsp[(1) - (1)].sValue), v))
+        if (pp->setvarTable.get(pp->symbols.intern((yyvsp[(1) - (1)].sValue)), v))
           (yyval.varSpec) = new SetVarSpec(Alias(v),false);
         else {
           pp->err << "Error: undefined identifier " << (yyvsp[(1) - (1)].sValue)
@@ -2750,16 +2769,16 @@ yyreduce:
   case 76:
 
 /* Line 1806 of yacc.c  */
-#line 1053 "parser.yxx"
+#line 1060 "parser.yxx"
     {
-        vector<int> v;
+        const vector<int>* v;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->setvararrays.get((yyvsp[(1) - (4)].sValue), v)) {
+        if ((v = pp->setvararrays.find(pp->symbols.intern((yyvsp[(1) - (4)].sValue))))) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[(3) - (4)].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new SetVarSpec(Alias(v[(yyvsp[(3) - (4)].iValue)-1]),false);
+            (yyval.varSpec) = new SetVarSpec(Alias((*v)[(yyvsp[(3) - (4)].iValue)-1]),false);
           else
             (yyval.varSpec) = new SetVarSpec(Alias(0),false);
         } else {
@@ -2776,100 +2795,100 @@ yyreduce:
   case 77:
 
 /* Line 1806 of yacc.c  */
-#line 1076 "parser.yxx"
+#line 1083 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
     break;
 
   case 78:
 
 /* Line 1806 of yacc.c  */
-#line 1078 "parser.yxx"
+#line 1085 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (2)].varSpecVec); }
     break;
 
   case 79:
 
 /* Line 1806 of yacc.c  */
-#line 1082 "parser.yxx"
+#line 1089 "parser.yxx"
     { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[(1) - (1)].varSpec); }
     break;
 
   case 80:
 
 /* Line 1806 of yacc.c  */
-#line 1084 "parser.yxx"
+#line 1091 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(1) - (3)].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[(3) - (3)].varSpec)); }
     break;
 
   case 81:
 
 /* Line 1806 of yacc.c  */
-#line 1087 "parser.yxx"
+#line 1094 "parser.yxx"
     { (yyval.varSpecVec) = (yyvsp[(2) - (3)].varSpecVec); }
     break;
 
   case 82:
 
 /* Line 1806 of yacc.c  */
-#line 1091 "parser.yxx"
+#line 1098 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
     break;
 
   case 83:
 
 /* Line 1806 of yacc.c  */
-#line 1093 "parser.yxx"
+#line 1100 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[(2) - (2)].varSpecVec)); }
     break;
 
   case 84:
 
 /* Line 1806 of yacc.c  */
-#line 1097 "parser.yxx"
+#line 1104 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
     break;
 
   case 85:
 
 /* Line 1806 of yacc.c  */
-#line 1099 "parser.yxx"
+#line 1106 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[(2) - (2)].varSpecVec)); }
     break;
 
   case 86:
 
 /* Line 1806 of yacc.c  */
-#line 1103 "parser.yxx"
+#line 1110 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
     break;
 
   case 87:
 
 /* Line 1806 of yacc.c  */
-#line 1105 "parser.yxx"
+#line 1112 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[(2) - (2)].varSpecVec)); }
     break;
 
   case 88:
 
 /* Line 1806 of yacc.c  */
-#line 1109 "parser.yxx"
+#line 1116 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
     break;
 
   case 89:
 
 /* Line 1806 of yacc.c  */
-#line 1111 "parser.yxx"
+#line 1118 "parser.yxx"
     { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[(2) - (2)].varSpecVec)); }
     break;
 
   case 90:
 
 /* Line 1806 of yacc.c  */
-#line 1115 "parser.yxx"
+#line 1122 "parser.yxx"
     {
-        ConExpr c((yyvsp[(2) - (6)].sValue), (yyvsp[(4) - (6)].argVec));
+        ConExpr c((yyvsp[(2) - (6)].sValue), (yyvsp[(4) - (6)].argVec), registry().lookup((yyvsp[(2) - (6)].sValue)));
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->hadError) {
           try {
@@ -2885,7 +2904,7 @@ yyreduce:
   case 91:
 
 /* Line 1806 of yacc.c  */
-#line 1129 "parser.yxx"
+#line 1136 "parser.yxx"
     {
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->hadError) {
@@ -2903,7 +2922,7 @@ yyreduce:
   case 92:
 
 /* Line 1806 of yacc.c  */
-#line 1142 "parser.yxx"
+#line 1149 "parser.yxx"
     {
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->hadError) {
@@ -2924,21 +2943,21 @@ yyreduce:
   case 93:
 
 /* Line 1806 of yacc.c  */
-#line 1164 "parser.yxx"
+#line 1171 "parser.yxx"
     { (yyval.oSet) = Option<AST::SetLit* >::none(); }
     break;
 
   case 94:
 
 /* Line 1806 of yacc.c  */
-#line 1166 "parser.yxx"
+#line 1173 "parser.yxx"
     { (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit(*(yyvsp[(2) - (3)].setValue))); }
     break;
 
   case 95:
 
 /* Line 1806 of yacc.c  */
-#line 1168 "parser.yxx"
+#line 1175 "parser.yxx"
     {
         (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit((yyvsp[(1) - (3)].iValue), (yyvsp[(3) - (3)].iValue)));
       }
@@ -2947,14 +2966,14 @@ yyreduce:
   case 96:
 
 /* Line 1806 of yacc.c  */
-#line 1174 "parser.yxx"
+#line 1181 "parser.yxx"
     { (yyval.oSet) = Option<AST::SetLit* >::none(); }
     break;
 
   case 97:
 
 /* Line 1806 of yacc.c  */
-#line 1176 "parser.yxx"
+#line 1183 "parser.yxx"
     { bool haveTrue = false;
         bool haveFalse = false;
         for (int i=(yyvsp[(2) - (4)].setValue)->size(); i--;) {
@@ -2970,247 +2989,248 @@ yyreduce:
   case 100:
 
 /* Line 1806 of yacc.c  */
-#line 1197 "parser.yxx"
+#line 1204 "parser.yxx"
     { (yyval.setLit) = new AST::SetLit(*(yyvsp[(2) - (3)].setValue)); }
     break;
 
   case 101:
 
 /* Line 1806 of yacc.c  */
-#line 1199 "parser.yxx"
+#line 1206 "parser.yxx"
     { (yyval.setLit) = new AST::SetLit((yyvsp[(1) - (3)].iValue), (yyvsp[(3) - (3)].iValue)); }
     break;
 
   case 102:
 
 /* Line 1806 of yacc.c  */
-#line 1205 "parser.yxx"
+#line 1212 "parser.yxx"
     { (yyval.setValue) = new vector<int>(0); }
     break;
 
   case 103:
 
 /* Line 1806 of yacc.c  */
-#line 1207 "parser.yxx"
+#line 1214 "parser.yxx"
     { (yyval.setValue) = (yyvsp[(1) - (2)].setValue); }
     break;
 
   case 104:
 
 /* Line 1806 of yacc.c  */
-#line 1211 "parser.yxx"
+#line 1218 "parser.yxx"
     { (yyval.setValue) = new vector<int>(1); (*(yyval.setValue))[0] = (yyvsp[(1) - (1)].iValue); }
     break;
 
   case 105:
 
 /* Line 1806 of yacc.c  */
-#line 1213 "parser.yxx"
+#line 1220 "parser.yxx"
     { (yyval.setValue) = (yyvsp[(1) - (3)].setValue); (yyval.setValue)->push_back((yyvsp[(3) - (3)].iValue)); }
     break;
 
   case 106:
 
 /* Line 1806 of yacc.c  */
-#line 1217 "parser.yxx"
+#line 1224 "parser.yxx"
     { (yyval.setValue) = new vector<int>(0); }
     break;
 
   case 107:
 
 /* Line 1806 of yacc.c  */
-#line 1219 "parser.yxx"
+#line 1226 "parser.yxx"
     { (yyval.setValue) = (yyvsp[(1) - (2)].setValue); }
     break;
 
   case 108:
 
 /* Line 1806 of yacc.c  */
-#line 1223 "parser.yxx"
+#line 1230 "parser.yxx"
     { (yyval.setValue) = new vector<int>(1); (*(yyval.setValue))[0] = (yyvsp[(1) - (1)].iValue); }
     break;
 
   case 109:
 
 /* Line 1806 of yacc.c  */
-#line 1225 "parser.yxx"
+#line 1232 "parser.yxx"
     { (yyval.setValue) = (yyvsp[(1) - (3)].setValue); (yyval.setValue)->push_back((yyvsp[(3) - (3)].iValue)); }
     break;
 
   case 110:
 
 /* Line 1806 of yacc.c  */
-#line 1229 "parser.yxx"
+#line 1236 "parser.yxx"
     { (yyval.floatSetValue) = new vector<double>(0); }
     break;
 
   case 111:
 
 /* Line 1806 of yacc.c  */
-#line 1231 "parser.yxx"
+#line 1238 "parser.yxx"
     { (yyval.floatSetValue) = (yyvsp[(1) - (2)].floatSetValue); }
     break;
 
   case 112:
 
 /* Line 1806 of yacc.c  */
-#line 1235 "parser.yxx"
+#line 1242 "parser.yxx"
     { (yyval.floatSetValue) = new vector<double>(1); (*(yyval.floatSetValue))[0] = (yyvsp[(1) - (1)].dValue); }
     break;
 
   case 113:
 
 /* Line 1806 of yacc.c  */
-#line 1237 "parser.yxx"
+#line 1244 "parser.yxx"
     { (yyval.floatSetValue) = (yyvsp[(1) - (3)].floatSetValue); (yyval.floatSetValue)->push_back((yyvsp[(3) - (3)].dValue)); }
     break;
 
   case 114:
 
 /* Line 1806 of yacc.c  */
-#line 1241 "parser.yxx"
+#line 1248 "parser.yxx"
     { (yyval.setValueList) = new vector<AST::SetLit>(0); }
     break;
 
   case 115:
 
 /* Line 1806 of yacc.c  */
-#line 1243 "parser.yxx"
+#line 1250 "parser.yxx"
     { (yyval.setValueList) = (yyvsp[(1) - (2)].setValueList); }
     break;
 
   case 116:
 
 /* Line 1806 of yacc.c  */
-#line 1247 "parser.yxx"
+#line 1254 "parser.yxx"
     { (yyval.setValueList) = new vector<AST::SetLit>(1); (*(yyval.setValueList))[0] = *(yyvsp[(1) - (1)].setLit); delete (yyvsp[(1) - (1)].setLit); }
     break;
 
   case 117:
 
 /* Line 1806 of yacc.c  */
-#line 1249 "parser.yxx"
+#line 1256 "parser.yxx"
     { (yyval.setValueList) = (yyvsp[(1) - (3)].setValueList); (yyval.setValueList)->push_back(*(yyvsp[(3) - (3)].setLit)); delete (yyvsp[(3) - (3)].setLit); }
     break;
 
   case 118:
 
 /* Line 1806 of yacc.c  */
-#line 1257 "parser.yxx"
+#line 1264 "parser.yxx"
     { (yyval.argVec) = new AST::Array((yyvsp[(1) - (1)].arg)); }
     break;
 
   case 119:
 
 /* Line 1806 of yacc.c  */
-#line 1259 "parser.yxx"
+#line 1266 "parser.yxx"
     { (yyval.argVec) = (yyvsp[(1) - (3)].argVec); (yyval.argVec)->append((yyvsp[(3) - (3)].arg)); }
     break;
 
   case 120:
 
 /* Line 1806 of yacc.c  */
-#line 1263 "parser.yxx"
+#line 1270 "parser.yxx"
     { (yyval.arg) = (yyvsp[(1) - (1)].arg); }
     break;
 
   case 121:
 
 /* Line 1806 of yacc.c  */
-#line 1265 "parser.yxx"
+#line 1272 "parser.yxx"
     { (yyval.arg) = (yyvsp[(2) - (3)].argVec); }
     break;
 
   case 122:
 
 /* Line 1806 of yacc.c  */
-#line 1269 "parser.yxx"
+#line 1276 "parser.yxx"
     { (yyval.oArg) = Option<AST::Node*>::none(); }
     break;
 
   case 123:
 
 /* Line 1806 of yacc.c  */
-#line 1271 "parser.yxx"
+#line 1278 "parser.yxx"
     { (yyval.oArg) = Option<AST::Node*>::some((yyvsp[(2) - (2)].arg)); }
     break;
 
   case 124:
 
 /* Line 1806 of yacc.c  */
-#line 1275 "parser.yxx"
+#line 1282 "parser.yxx"
     { (yyval.arg) = new AST::BoolLit((yyvsp[(1) - (1)].iValue)); }
     break;
 
   case 125:
 
 /* Line 1806 of yacc.c  */
-#line 1277 "parser.yxx"
+#line 1284 "parser.yxx"
     { (yyval.arg) = new AST::IntLit((yyvsp[(1) - (1)].iValue)); }
     break;
 
   case 126:
 
 /* Line 1806 of yacc.c  */
-#line 1279 "parser.yxx"
+#line 1286 "parser.yxx"
     { (yyval.arg) = new AST::FloatLit((yyvsp[(1) - (1)].dValue)); }
     break;
 
   case 127:
 
 /* Line 1806 of yacc.c  */
-#line 1281 "parser.yxx"
+#line 1288 "parser.yxx"
     { (yyval.arg) = (yyvsp[(1) - (1)].setLit); }
     break;
 
   case 128:
 
 /* Line 1806 of yacc.c  */
-#line 1283 "parser.yxx"
+#line 1290 "parser.yxx"
     {
-        vector<int> as;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvararrays.get((yyvsp[(1) - (1)].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::IntVar(as[i]);
+        Symbol id = pp->symbols.intern((yyvsp[(1) - (1)].sValue));
+        const vector<int>* as;
+        if ((as = pp->intvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::IntVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->boolvararrays.get((yyvsp[(1) - (1)].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::BoolVar(as[i]);
+        } else if ((as = pp->boolvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::BoolVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->setvararrays.get((yyvsp[(1) - (1)].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::SetVar(as[i]);
+        } else if ((as = pp->setvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::SetVar((*as)[i]);
           (yyval.arg) = ia;
         } else {
-          std::vector<int> is;
-          std::vector<AST::SetLit> isS;
+          const std::vector<int>* is;
+          const std::vector<AST::SetLit>* isS;
           int ival = 0;
           bool bval = false;
-          if (pp->intvalarrays.get((yyvsp[(1) - (1)].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::IntLit(is[i]);
+          if ((is = pp->intvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::IntLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->boolvalarrays.get((yyvsp[(1) - (1)].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::BoolLit(is[i]);
+          } else if ((is = pp->boolvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::BoolLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->setvalarrays.get((yyvsp[(1) - (1)].sValue), isS)) {
-            AST::Array *v = new AST::Array(isS.size());
-            for (int i=isS.size(); i--;)
-              v->a[i] = new AST::SetLit(isS[i]);
+          } else if ((isS = pp->setvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(isS->size());
+            for (int i=isS->size(); i--;)
+              v->a[i] = new AST::SetLit((*isS)[i]);
             (yyval.arg) = v;
-          } else if (pp->intvals.get((yyvsp[(1) - (1)].sValue), ival)) {
+          } else if (pp->intvals.get(id, ival)) {
             (yyval.arg) = new AST::IntLit(ival);
-          } else if (pp->boolvals.get((yyvsp[(1) - (1)].sValue), bval)) {
+          } else if (pp->boolvals.get(id, bval)) {
             (yyval.arg) = new AST::BoolLit(bval);
           } else {
-            (yyval.arg) = getVarRefArg(pp,(yyvsp[(1) - (1)].sValue));
+            (yyval.arg) = getVarRefArg(pp,id);
           }
         }
         free((yyvsp[(1) - (1)].sValue));
@@ -3220,13 +3240,13 @@ yyreduce:
   case 129:
 
 /* Line 1806 of yacc.c  */
-#line 1332 "parser.yxx"
+#line 1340 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         int i = -1;
         yyassert(pp, (yyvsp[(3) - (4)].arg)->isInt(i), "Non-integer array index.");
         if (!pp->hadError)
-          (yyval.arg) = getArrayElement(static_cast<ParserState*>(parm),(yyvsp[(1) - (4)].sValue),i);
+          (yyval.arg) = getArrayElement(pp,pp->symbols.intern((yyvsp[(1) - (4)].sValue)),i);
         else
           (yyval.arg) = new AST::IntLit(0); // keep things consistent
         free((yyvsp[(1) - (4)].sValue));
@@ -3236,38 +3256,38 @@ yyreduce:
   case 130:
 
 /* Line 1806 of yacc.c  */
-#line 1345 "parser.yxx"
+#line 1353 "parser.yxx"
     { (yyval.argVec) = new AST::Array(0); }
     break;
 
   case 131:
 
 /* Line 1806 of yacc.c  */
-#line 1347 "parser.yxx"
+#line 1355 "parser.yxx"
     { (yyval.argVec) = (yyvsp[(1) - (2)].argVec); }
     break;
 
   case 132:
 
 /* Line 1806 of yacc.c  */
-#line 1351 "parser.yxx"
+#line 1359 "parser.yxx"
     { (yyval.argVec) = new AST::Array((yyvsp[(1) - (1)].arg)); }
     break;
 
   case 133:
 
 /* Line 1806 of yacc.c  */
-#line 1353 "parser.yxx"
+#line 1361 "parser.yxx"
     { (yyval.argVec) = (yyvsp[(1) - (3)].argVec); (yyval.argVec)->append((yyvsp[(3) - (3)].arg)); }
     break;
 
   case 134:
 
 /* Line 1806 of yacc.c  */
-#line 1361 "parser.yxx"
+#line 1369 "parser.yxx"
     {
         ParserState *pp = static_cast<ParserState*>(parm);
-        if (!pp->intvarTable.get((yyvsp[(1) - (1)].sValue), (yyval.iValue))) {
+        if (!pp->intvarTable.get(pp->symbols.intern((yyvsp[(1) - (1)].sValue)), (yyval.iValue))) {
           pp->err << "Error: unknown integer variable " << (yyvsp[(1) - (1)].sValue)
                   << " in line no. "
                   << yyget_lineno(pp->yyscanner) << std::endl;
@@ -3280,11 +3300,11 @@ yyreduce:
   case 135:
 
 /* Line 1806 of yacc.c  */
-#line 1372 "parser.yxx"
+#line 1380 "parser.yxx"
     {
         vector<int> tmp;
         ParserState *pp = static_cast<ParserState*>(parm);
-        if (!pp->intvararrays.get((yyvsp[(1) - (4)].sValue), tmp)) {
+        if (!pp->intvararrays.get(pp->symbols.intern((yyvsp[(1) - (4)].sValue)), tmp)) {
           pp->err << "Error: unknown integer variable array " << (yyvsp[(1) - (4)].sValue)
                   << " in line no. "
                   << yyget_lineno(pp->yyscanner) << std::endl;
@@ -3305,35 +3325,35 @@ yyreduce:
   case 138:
 
 /* Line 1806 of yacc.c  */
-#line 1402 "parser.yxx"
+#line 1410 "parser.yxx"
     { (yyval.argVec) = NULL; }
     break;
 
   case 139:
 
 /* Line 1806 of yacc.c  */
-#line 1404 "parser.yxx"
+#line 1412 "parser.yxx"
     { (yyval.argVec) = (yyvsp[(1) - (1)].argVec); }
     break;
 
   case 140:
 
 /* Line 1806 of yacc.c  */
-#line 1408 "parser.yxx"
+#line 1416 "parser.yxx"
     { (yyval.argVec) = new AST::Array((yyvsp[(2) - (2)].arg)); }
     break;
 
   case 141:
 
 /* Line 1806 of yacc.c  */
-#line 1410 "parser.yxx"
+#line 1418 "parser.yxx"
     { (yyval.argVec) = (yyvsp[(1) - (3)].argVec); (yyval.argVec)->append((yyvsp[(3) - (3)].arg)); }
     break;
 
   case 142:
 
 /* Line 1806 of yacc.c  */
-#line 1414 "parser.yxx"
+#line 1422 "parser.yxx"
     {
         (yyval.arg) = new AST::Call((yyvsp[(1) - (4)].sValue), AST::extractSingleton((yyvsp[(3) - (4)].arg))); free((yyvsp[(1) - (4)].sValue));
       }
@@ -3342,108 +3362,109 @@ yyreduce:
   case 143:
 
 /* Line 1806 of yacc.c  */
-#line 1418 "parser.yxx"
+#line 1426 "parser.yxx"
     { (yyval.arg) = (yyvsp[(1) - (1)].arg); }
     break;
 
   case 144:
 
 /* Line 1806 of yacc.c  */
-#line 1422 "parser.yxx"
+#line 1430 "parser.yxx"
     { (yyval.arg) = new AST::Array((yyvsp[(1) - (1)].arg)); }
     break;
 
   case 145:
 
 /* Line 1806 of yacc.c  */
-#line 1424 "parser.yxx"
+#line 1432 "parser.yxx"
     { (yyval.arg) = (yyvsp[(1) - (3)].arg); (yyval.arg)->append((yyvsp[(3) - (3)].arg)); }
     break;
 
   case 146:
 
 /* Line 1806 of yacc.c  */
-#line 1428 "parser.yxx"
+#line 1436 "parser.yxx"
     { (yyval.arg) = (yyvsp[(1) - (1)].arg); }
     break;
 
   case 147:
 
 /* Line 1806 of yacc.c  */
-#line 1430 "parser.yxx"
+#line 1438 "parser.yxx"
     { (yyval.arg) = (yyvsp[(2) - (3)].arg); }
     break;
 
   case 148:
 
 /* Line 1806 of yacc.c  */
-#line 1434 "parser.yxx"
+#line 1442 "parser.yxx"
     { (yyval.arg) = new AST::BoolLit((yyvsp[(1) - (1)].iValue)); }
     break;
 
   case 149:
 
 /* Line 1806 of yacc.c  */
-#line 1436 "parser.yxx"
+#line 1444 "parser.yxx"
     { (yyval.arg) = new AST::IntLit((yyvsp[(1) - (1)].iValue)); }
     break;
 
   case 150:
 
 /* Line 1806 of yacc.c  */
-#line 1438 "parser.yxx"
+#line 1446 "parser.yxx"
     { (yyval.arg) = new AST::FloatLit((yyvsp[(1) - (1)].dValue)); }
     break;
 
   case 151:
 
 /* Line 1806 of yacc.c  */
-#line 1440 "parser.yxx"
+#line 1448 "parser.yxx"
     { (yyval.arg) = (yyvsp[(1) - (1)].setLit); }
     break;
 
   case 152:
 
 /* Line 1806 of yacc.c  */
-#line 1442 "parser.yxx"
+#line 1450 "parser.yxx"
     {
-        vector<int> as;
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvararrays.get((yyvsp[(1) - (1)].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::IntVar(as[i]);
+        Symbol id = pp->symbols.intern((yyvsp[(1) - (1)].sValue));
+        const vector<int>* as;
+        if ((as = pp->intvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::IntVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->boolvararrays.get((yyvsp[(1) - (1)].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::BoolVar(as[i]);
+        } else if ((as = pp->boolvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::BoolVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->setvararrays.get((yyvsp[(1) - (1)].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::SetVar(as[i]);
+        } else if ((as = pp->setvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::SetVar((*as)[i]);
           (yyval.arg) = ia;
         } else {
-          std::vector<int> is;
+          const std::vector<int>* is;
           int ival = 0;
           bool bval = false;
-          if (pp->intvalarrays.get((yyvsp[(1) - (1)].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::IntLit(is[i]);
+          if ((is = pp->intvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::IntLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->boolvalarrays.get((yyvsp[(1) - (1)].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::BoolLit(is[i]);
+          } else if ((is = pp->boolvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::BoolLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->intvals.get((yyvsp[(1) - (1)].sValue), ival)) {
+          } else if (pp->intvals.get(id, ival)) {
             (yyval.arg) = new AST::IntLit(ival);
-          } else if (pp->boolvals.get((yyvsp[(1) - (1)].sValue), bval)) {
+          } else if (pp->boolvals.get(id, bval)) {
             (yyval.arg) = new AST::BoolLit(bval);
           } else {
-            (yyval.arg) = getVarRefArg(pp,(yyvsp[(1) - (1)].sValue),true);
+            (yyval.arg) = getVarRefArg(pp,id,true);
           }
         }
         free((yyvsp[(1) - (1)].sValue));
@@ -3453,13 +3474,13 @@ yyreduce:
   case 153:
 
 /* Line 1806 of yacc.c  */
-#line 1485 "parser.yxx"
+#line 1494 "parser.yxx"
     {
         ParserState* pp = static_cast<ParserState*>(parm);
         int i = -1;
         yyassert(pp, (yyvsp[(3) - (4)].arg)->isInt(i), "Non-integer array index.");
         if (!pp->hadError)
-          (yyval.arg) = getArrayElement(static_cast<ParserState*>(parm),(yyvsp[(1) - (4)].sValue),i);
+          (yyval.arg) = getArrayElement(pp,pp->symbols.intern((yyvsp[(1) - (4)].sValue)),i);
         else
           (yyval.arg) = new AST::IntLit(0); // keep things consistent
         free((yyvsp[(1) - (4)].sValue));
@@ -3469,7 +3490,7 @@ yyreduce:
   case 154:
 
 /* Line 1806 of yacc.c  */
-#line 1496 "parser.yxx"
+#line 1505 "parser.yxx"
     {
         (yyval.arg) = new AST::String((yyvsp[(1) - (1)].sValue));
         free((yyvsp[(1) - (1)].sValue));
@@ -3479,7 +3500,7 @@ yyreduce:
 
 
 /* Line 1806 of yacc.c  */
-#line 3483 "parser.tab.cpp"
+#line 3504 "parser.tab.cpp"
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -41,6 +41,7 @@
 
 #include "registry.hpp"
 #include "flatzinc.hpp"
+#include "symboltable.hpp"
 
 //#include <mistral_solver.hpp>
 #include <mistral_variable.hpp>
@@ -66,17 +67,52 @@ namespace FlatZinc {
   void
   Registry::post(Solver& s, FlatZincModel &m,
                  const ConExpr& ce, AST::Node* ann) {
-    std::map<std::string,poster>::iterator i = r.find(ce.id);
-    if (i == r.end()) {
+    int p = (ce.poster >= 0 ? ce.poster : lookup(ce.id.c_str()));
+    if (p < 0) {
       throw FlatZinc::Error("Registry",
         std::string("Constraint ")+ce.id+" not found");
     }
-    i->second(s, m, ce, ann);
+    posters[p](s, m, ce, ann);
+  }
+
+  int
+  Registry::lookup(const char* id) const {
+    unsigned int mask = table.size()-1;
+    unsigned int j = hashString(id) & mask;
+    while (table[j] >= 0) {
+      if (names[table[j]] == id)
+        return table[j];
+      j = (j+1) & mask;
+    }
+    return -1;
+  }
+
+  void
+  Registry::index(int p) {
+    unsigned int mask = table.size()-1;
+    unsigned int j = hashString(names[p].c_str()) & mask;
+    while (table[j] >= 0)
+      j = (j+1) & mask;
+    table[j] = p;
   }
 
   void
   Registry::add(const std::string& id, poster p) {
-    r[id] = p;
+    int i = lookup(id.c_str());
+    if (i >= 0) {
+      posters[i] = p;
+      return;
+    }
+    names.push_back(id);
+    posters.push_back(p);
+    // keep the load factor below 1/2
+    if (2*names.size() > table.size()) {
+      table.assign(2*table.size(), -1);
+      for (unsigned int q=0; q<names.size(); q++)
+        index(q);
+    } else {
+      index(names.size()-1);
+    }
   }
 
   namespace {
@@ -40,7 +40,7 @@
 
 #include "flatzinc.hpp"
 #include <string>
-#include <map>
+#include <vector>
 
 // #define NEQ 1
 // #define  EQ 2
@@ -62,15 +62,25 @@ namespace FlatZinc {
                             FlatZincModel&,
                             const ConExpr&,
                             AST::Node*);
+    /// Constructor
+    Registry(void) : table(512, -1) {}
     /// Add posting function \a p with identifier \a id
     void add(const std::string& id, poster p);
+    /// Return the index of the posting function of \a id (-1 if there is none)
+    int lookup(const char* id) const;
     /// Post constraint specified by \a ce
     void post(Solver& s, FlatZincModel &m,
               const ConExpr& ce, AST::Node* ann);
 
   private:
-    /// The actual registry
-    std::map<std::string,poster> r;
+    /// Identifiers of the posting functions
+    std::vector<std::string> names;
+    /// The posting functions
+    std::vector<poster> posters;
+    /// Open-addressing hash table of the indices (-1 for empty slots)
+    std::vector<int> table;
+    /// Insert the index \a p in the hash table
+    void index(int p);
   };
 
   /// Return global registry object
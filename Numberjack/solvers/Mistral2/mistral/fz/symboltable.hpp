@@ -38,40 +38,170 @@
 #ifndef __GECODE_FLATZINC_SYMBOLTABLE_HH__
 #define __GECODE_FLATZINC_SYMBOLTABLE_HH__
 
-#include <map>
 #include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
 
 namespace FlatZinc {
 
-  /// Symbol table mapping identifiers (strings) to values
+  /// Hash value of the string \a s (FNV-1a)
+  inline unsigned int
+  hashString(const char* s) {
+    unsigned int h = 2166136261u;
+    while (*s) {
+      h ^= static_cast<unsigned char>(*s++);
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  /// Interned identifier: two identifiers are equal iff their symbols are
+  typedef int Symbol;
+
+  /**
+   * \brief Pool of interned identifiers
+   *
+   * Each distinct string is stored once and numbered in order of first
+   * occurrence. The strings are found through an open-addressing hash
+   * table with linear probing.
+   */
+  class SymbolPool {
+  private:
+    /// Strings of the symbols
+    std::vector<char*> names;
+    /// Hash values of the symbols
+    std::vector<unsigned int> hashes;
+    /// Hash table of the symbols (-1 for empty slots), its size is a power of 2
+    std::vector<Symbol> table;
+    /// Double the size of the hash table
+    void grow(void);
+  public:
+    /// Constructor
+    SymbolPool(void) : table(1024, -1) {}
+    /// Destructor
+    ~SymbolPool(void) {
+      for (unsigned int i=0; i<names.size(); i++)
+        free(names[i]);
+    }
+    /// Return the symbol of \a s, creating it if needed
+    Symbol intern(const char* s);
+    /// Return the string of symbol \a x
+    const char* name(Symbol x) const { return names[x]; }
+    /// Return the number of symbols
+    unsigned int size(void) const { return names.size(); }
+  };
+
+  inline void
+  SymbolPool::grow(void) {
+    unsigned int mask = 2*table.size()-1;
+    std::vector<Symbol> t(table.size()*2, -1);
+    for (unsigned int x=0; x<names.size(); x++) {
+      unsigned int j = hashes[x] & mask;
+      while (t[j] >= 0)
+        j = (j+1) & mask;
+      t[j] = x;
+    }
+    table.swap(t);
+  }
+
+  inline Symbol
+  SymbolPool::intern(const char* s) {
+    unsigned int h = hashString(s);
+    unsigned int mask = table.size()-1;
+    unsigned int j = h & mask;
+    while (table[j] >= 0) {
+      Symbol x = table[j];
+      if (hashes[x] == h && !strcmp(names[x], s))
+        return x;
+      j = (j+1) & mask;
+    }
+    Symbol x = names.size();
+    names.push_back(strdup(s));
+    hashes.push_back(h);
+    table[j] = x;
+    // keep the load factor below 1/2
+    if (2*names.size() > table.size())
+      grow();
+    return x;
+  }
+
+  /**
+   * \brief Symbol table mapping identifiers (symbols) to values
+   *
+   * Open-addressing hash table with linear probing, keyed by the symbols of
+   * a SymbolPool.
+   */
   template<class Val>
   class SymbolTable {
   private:
-    std::map<std::string,Val> m;
+    /// Slots of the table (key -1 for empty slots), their number is a power of 2
+    std::vector<std::pair<Symbol,Val> > slots;
+    /// Number of keys
+    unsigned int n;
+    /// Return the slot of \a key, or the empty slot where it would go
+    unsigned int slot(Symbol key) const;
   public:
+    /// Constructor
+    SymbolTable(void) : slots(16, std::pair<Symbol,Val>(-1, Val())), n(0) {}
     /// Insert \a val with \a key
-    void put(const std::string& key, const Val& val);
+    void put(Symbol key, const Val& val);
     /// Return whether \a key exists, and set \a val if it does exist
-    bool get(const std::string& key, Val& val) const;
+    bool get(Symbol key, Val& val) const;
+    /// Return the value of \a key, or NULL if it does not exist
+    const Val* find(Symbol key) const;
   };
 
+  template<class Val>
+  inline unsigned int
+  SymbolTable<Val>::slot(Symbol key) const {
+    // symbols are consecutive integers, Fibonacci hashing spreads them out
+    unsigned int mask = slots.size()-1;
+    unsigned int j = (static_cast<unsigned int>(key) * 2654435769u) & mask;
+    while (slots[j].first >= 0 && slots[j].first != key)
+      j = (j+1) & mask;
+    return j;
+  }
+
   template<class Val>
   void
-  SymbolTable<Val>::put(const std::string& key, const Val& val) {
-    m[key] = val;
+  SymbolTable<Val>::put(Symbol key, const Val& val) {
+    unsigned int j = slot(key);
+    if (slots[j].first < 0) {
+      // keep the load factor below 1/2
+      if (2*(n+1) > slots.size()) {
+        std::vector<std::pair<Symbol,Val> >
+          s(2*slots.size(), std::pair<Symbol,Val>(-1, Val()));
+        s.swap(slots);
+        for (unsigned int i=0; i<s.size(); i++)
+          if (s[i].first >= 0)
+            std::swap(slots[slot(s[i].first)], s[i]);
+        j = slot(key);
+      }
+      slots[j].first = key;
+      ++n;
+    }
+    slots[j].second = val;
   }
 
   template<class Val>
-  bool
-  SymbolTable<Val>::get(const std::string& key, Val& val) const {
-    typename std::map<std::string,Val>::const_iterator i =
-      m.find(key);
-    if (i == m.end())
+  inline bool
+  SymbolTable<Val>::get(Symbol key, Val& val) const {
+    const Val* v = find(key);
+    if (v == NULL)
       return false;
-    val = i->second;
+    val = *v;
     return true;
   }
 
+  template<class Val>
+  inline const Val*
+  SymbolTable<Val>::find(Symbol key) const {
+    unsigned int j = slot(key);
+    return slots[j].first < 0 ? NULL : &slots[j].second;
+  }
+
 }
 #endif
 
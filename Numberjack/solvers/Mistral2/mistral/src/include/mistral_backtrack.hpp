@@ -323,6 +323,8 @@ namespace Mistral {
 
 
   typedef TwoWayStack< VarEvent > VariableQueue;
+
+  class ConstraintLazyClauseBase;
   //typedef TwoWayStack< Triplet < int, Event, ConstraintImplementation*> > VariableQueue;
 
 
@@ -349,15 +351,22 @@ namespace Mistral {
     Vector< int > trail_;
 
     VariableQueue active_variables;
+    /// Number of domain events triggered so far (used to count the prunings)
+    unsigned long int num_events;
 
     ConstraintImplementation *taboo_constraint;
+
+    /// When lazy clause generation is on, the bound changes are recorded there
+    ConstraintLazyClauseBase *lazy_base;
     //@}
 
     /*!@name Constructors*/
     //@{
     Environment() { 
       level = 0;
+      num_events = 0;
       taboo_constraint = NULL;
+      lazy_base = NULL;
     }
     virtual ~Environment() {}
     //@}
@@ -379,6 +388,7 @@ namespace Mistral {
 
 
     void trigger_event(const int var, const Event evt) {
+      ++num_events;
       if(active_variables.contain(var)) {
 	active_variables[var].update( evt, taboo_constraint );
       } else {
@@ -386,8 +396,12 @@ namespace Mistral {
 	VarEvent t(var, evt, taboo_constraint);
 	active_variables.push_back(t);
       }
+      if(lazy_base) record_bound_change(var);
     }
 
+    // (defined in mistral_sat.cpp)
+    void record_bound_change(const int var);
+
     void _restore_();
 
     inline void save(ReversibleNum<int> *r) {saved_ints.add(r);}
@@ -217,6 +217,7 @@ namespace Mistral {
 
   
   class Variable;
+  class ConstraintDisjunctive;
   class ConstraintImplementation : public Explanation {
     
   public:
@@ -248,6 +249,26 @@ namespace Mistral {
     unsigned int type;
     bool enforce_nfc1;
     //@}
+
+    /*!@name Profiling*/
+    //@{
+    /// Number of calls to the propagator
+    unsigned long int num_calls;
+    /// Number of domain events triggered by the propagator
+    unsigned long int num_prunings;
+    /// Number of calls that failed
+    unsigned long int num_failures;
+    /// Cumulative number of cycles spent in the propagator
+    unsigned long long int num_cycles;
+
+    inline void update_profile(const unsigned long int prunings, const bool failed, 
+			       const unsigned long long int cycles) {
+      ++num_calls;
+      num_prunings += prunings;
+      if(failed) ++num_failures;
+      num_cycles += cycles;
+    }
+    //@}
     
 
     /*!@name Constructors*/
@@ -352,6 +373,10 @@ namespace Mistral {
     virtual bool rewritable() { return false; }
     virtual bool simple_rewritable() { return false; }
     virtual bool explained() { return false; }
+    /// lazy clause generation: adds to 'lcg' bounds entailing [x >= v] (upper=0) or 
+    /// [x <= v] (upper=1), where x is the index of a variable, or the failure if x=-1.
+    /// By default the explanation is made of the bounds of every variable of the scope
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
     virtual RewritingOutcome rewrite() { return NO_EVENT; }
     virtual void consolidate() = 0; 
     virtual void consolidate_var(const int idx) = 0; 
@@ -1076,7 +1101,8 @@ namespace Mistral {
        // print_active();
        // std::cout << " " << last << std::endl;
 
-       if(enforce_nfc1 && size_byte[active] == 1) {
+       // the lowest 3 bits are the current state, the previous ones are above
+       if(enforce_nfc1 && size_byte[tmp] == 1) {
 	 
 	 int last = tmp/2;
 	 c = self[last];
@@ -1360,6 +1386,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     /// Set of non-ground variables
     ReversibleSet active;
 
+    /// The cost class of the propagator (CUBIC_COST..BINARY_COST), cheapest first
     int priority;
 
     ////
@@ -1368,7 +1395,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     ////
 
   
-    GlobalConstraint() : ConstraintImplementation() {}
+    GlobalConstraint() : ConstraintImplementation() { priority = LINEAR_COST; event_type = NULL; solution = NULL; }
     GlobalConstraint(Vector< Variable > scp);
     GlobalConstraint(std::vector< Variable > scp);
     GlobalConstraint(Variable* scp, const int n);
@@ -2286,19 +2313,21 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     /**@name Parameters*/
     //@{  
     int offset;
+    // the disjunction that posted this precedence, if any
+    ConstraintDisjunctive *owner;
     //@}
 
     /**@name Constructors*/
     //@{
-    ConstraintLess() : BinaryConstraint() {}
+    ConstraintLess() : BinaryConstraint() { owner = NULL; }
     ConstraintLess(const int ofs=0) 
-      : BinaryConstraint() { offset = ofs; }
+      : BinaryConstraint() { offset = ofs; owner = NULL; }
     ConstraintLess(Variable x, Variable y, const int ofs=0) 
-      : BinaryConstraint(x, y) { offset = ofs; }
+      : BinaryConstraint(x, y) { offset = ofs; owner = NULL; }
     ConstraintLess(Vector< Variable >& scp, const int ofs=0) 
-      : BinaryConstraint(scp) { offset = ofs; }
+      : BinaryConstraint(scp) { offset = ofs; owner = NULL; }
     ConstraintLess(std::vector< Variable >& scp, const int ofs=0) 
-      : BinaryConstraint(scp) { offset = ofs; }
+      : BinaryConstraint(scp) { offset = ofs; owner = NULL; }
     virtual Constraint clone() { return Constraint(new ConstraintLess(scope[0], scope[1], offset)// , type
 						   ); }
     virtual void initialise();
@@ -2319,6 +2348,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     virtual int check( const int* sol ) const { return (sol[0]+offset > sol[1]); }
     virtual PropagationOutcome propagate();
     virtual PropagationOutcome propagate(const int changed_idx, const Event evt);
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
     //virtual RewritingOutcome rewrite();
     //@}
 
@@ -2743,11 +2773,11 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
   public:
     /**@name Constructors*/
     //@{
-    ConstraintLex() : GlobalConstraint() { priority=1; }
+    ConstraintLex() : GlobalConstraint() { priority=LINEAR_COST; }
     ConstraintLex(Vector< Variable >& scp) 
-      : GlobalConstraint(scp) { priority=1; }
+      : GlobalConstraint(scp) { priority=LINEAR_COST; }
     ConstraintLex(std::vector< Variable >& scp) 
-      : GlobalConstraint(scp) { priority=1; }
+      : GlobalConstraint(scp) { priority=LINEAR_COST; }
     virtual Constraint clone() { return Constraint(new ConstraintLex(scope)); }
     virtual void initialise();
     virtual void mark_domain();
@@ -3332,13 +3362,13 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
     /**@name Constructors*/
     //@{
-    PredicateMul() : GlobalConstraint() { priority = 1; }
+    PredicateMul() : GlobalConstraint() { priority = LINEAR_COST; }
     PredicateMul(Vector< Variable >& scp) 
-      : GlobalConstraint(scp) { priority = 1; }
+      : GlobalConstraint(scp) { priority = LINEAR_COST; }
     // PredicateMul(Variable x, Variable y, Variable z) 
     //   : GlobalConstraint(x,y,z) {}
     PredicateMul(std::vector< Variable >& scp) 
-      : GlobalConstraint(scp) { priority = 1; }
+      : GlobalConstraint(scp) { priority = LINEAR_COST; }
     //virtual Constraint clone() { return Constraint(new PredicateMul(scope[0], scope[1], scope[2])); }
     virtual Constraint clone() { return Constraint(new PredicateMul(scope)); }
     virtual void initialise();
@@ -3420,6 +3450,9 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     virtual PropagationOutcome propagate();
     //virtual RewritingOutcome rewrite();
     virtual void consolidate();
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
+    /// explains why precedence[choice] was posted (the other one is violated)
+    void explain_choice(ConstraintLazyClauseBase *lcg, const int choice);
     //@}
 
     /**@name Miscellaneous*/
@@ -3496,6 +3529,163 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
   };
 
 
+  /**********************************************
+   * Unary Resource Constraint (Theta-Lambda tree)
+   **********************************************/ 
+  /*! \class ConstraintUnaryResource
+    \brief  No two tasks of the scope overlap (x_i + p_i <= x_j || x_j + p_j <= x_i).
+
+    Bounds reasoning on a unary resource in O(n log n), after Vilim's 
+    Theta-Lambda trees: overload checking, edge finding, not-first/not-last 
+    and detectable precedences. Every rule is applied both on the tasks and 
+    on their mirror image (time reversed), until a fixpoint is reached.
+  */
+  class ConstraintUnaryResource : public GlobalConstraint {
+
+  public: 
+    /**@name Parameters*/
+    //@{
+    Vector< int > processing_time;
+
+    // the Theta-Lambda tree, node k has children 2k and 2k+1, leaves start at 'leaf_offset'
+    int leaf_offset;
+    int *sum_p;
+    int *ect;
+    int *sum_p_gray;
+    int *ect_gray;
+    int *resp_p_gray;
+    int *resp_ect_gray;
+    // leaf[i] is the leaf of task i (rank in the est ordering)
+    int *leaf;
+
+    // the current view of the tasks (direct or mirrored), and the deduced bounds
+    int *est;
+    int *lct;
+    int *lst;
+    int *ect_task;
+    int *new_est;
+    int *new_lct;
+    int *by_est;
+    int *by_lct;
+    int *by_lst;
+    int *by_ect;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintUnaryResource() : GlobalConstraint() { priority = LINEAR_COST; }
+    ConstraintUnaryResource(Vector< Variable >& scp, Vector< int >& p);
+    virtual Constraint clone() { return Constraint(new ConstraintUnaryResource(scope, processing_time)); }
+    virtual void initialise();
+    virtual void mark_domain();
+    virtual ~ConstraintUnaryResource();
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+
+    // Theta-Lambda tree operations
+    void clear_tree();
+    void update_tree(int k);
+    void insert_task(const int i);
+    void gray_task(const int i);
+    void remove_task(const int i);
+
+    // the rules, on the current view; they tighten new_est (or new_lct for not-last)
+    bool edge_finding();
+    void detectable_precedences();
+    void not_last();
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "unary"; }
+    //@}
+  };
+
+
+  /**********************************************
+   * Cumulative Resource Constraint (time-tabling)
+   **********************************************/ 
+  /*! \class ConstraintCumulative
+    \brief  At any time, the tasks in process use at most 'capacity' units of the resource.
+
+    The profile of the compulsory parts [lst_i, ect_i) is built by a sweep 
+    over their start and end events, then every task is pushed past the 
+    segments of the profile where it does not fit (time-tabling). 
+    Optionally, an energetic overload check is made with a Theta-tree 
+    (the energy of the tasks in a time window must fit in it).
+  */
+  class ConstraintCumulative : public GlobalConstraint {
+
+  public: 
+    /**@name Parameters*/
+    //@{
+    Vector< int > processing_time;
+    Vector< int > demand;
+    int capacity;
+    bool energetic;
+
+    // the profile: segments [seg_start[k], seg_end[k]) of height seg_height[k]
+    Vector< int > seg_start;
+    Vector< int > seg_end;
+    Vector< int > seg_height;
+
+    // the events of the sweep (2i: start of the compulsory part of task i, 2i+1: its end)
+    int *event_time;
+    int *event_order;
+
+    // bounds of the tasks
+    int *est;
+    int *lct;
+    int *by_est;
+    int *by_lct;
+    int *leaf;
+
+    // the Theta-tree for the overload check, node k has children 2k and 2k+1
+    int leaf_offset;
+    long long int *energy;
+    long long int *envelope;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintCumulative() : GlobalConstraint() { priority = LINEAR_COST; }
+    ConstraintCumulative(Vector< Variable >& scp, Vector< int >& p, Vector< int >& d, const int c, const bool e=true);
+    virtual Constraint clone() { return Constraint(new ConstraintCumulative(scope, processing_time, demand, capacity, energetic)); }
+    virtual void initialise();
+    virtual void mark_domain();
+    virtual ~ConstraintCumulative();
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    // builds the profile of the compulsory parts, returns false if it exceeds the capacity
+    bool compute_profile();
+    // returns false if some set of tasks does not fit in its time window
+    bool overload_check();
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "cumulative"; }
+    //@}
+  };
+
+
 //   template< int ARITY >
 //   /**********************************************
 //    *Tuple Constraint
@@ -4023,6 +4213,195 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
 
 
+  /**********************************************
+   *Compact-Table Constraint
+   **********************************************/
+  /*! \class ConstraintCompactTable
+    \brief  GAC on a positive table (Compact-Table, Demeulenaere et al. CP'16)
+
+    The set of currently valid tuples is a reversible sparse bitset:
+    'current' stores the bits, the first 'limit' elements of 'nonzero'
+    are the indices of its non-zero words, and only these are visited.
+    For every pair x=a, the tuples supporting it are stored as a Bitset64
+    mask. All the masks of a variable are laid out in a single contiguous
+    block of words so that the word loops are vectorised by the compiler.
+
+    Words are trailed with a timestamp, and restored lazily at the
+    beginning of the next call to propagate(): 'trail_size' is
+    reversible and tells how many entries of the word trail are still
+    valid at the current level.
+  */
+  class ConstraintCompactTable : public ConstraintTable {
+
+  public:
+
+    typedef unsigned long long int word;
+
+    /**@name Parameters*/
+    //@{
+    // number of words in a tuple set
+    int num_words;
+    // set of valid tuples
+    Bitset64 current;
+    // indices of the words of 'current', the first 'limit' ones are non-zero
+    int *nonzero;
+    ReversibleNum<int> limit;
+    // temporary mask used to update 'current'
+    word *mask;
+
+    // trail for the words of 'current' (index, previous value, previous stamp)
+    Vector< int >  trail_index;
+    Vector< word > trail_value;
+    Vector< int >  trail_stamp;
+    // level at which each word was last saved
+    int *stamp;
+    ReversibleNum<int> trail_size;
+
+    // supports[x][a] is the set of tuples with x=a (its table is NULL if a was not in the initial domain)
+    Bitset64 **supports;
+    // one block of memory per variable for its support masks
+    word **pool;
+    // index of the word where a support for x=a was last found
+    int **residue;
+    // the values initially in the domains
+    Vector< int > *values;
+    // initial lower bounds
+    int *themins;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintCompactTable() : ConstraintTable() {}
+    ConstraintCompactTable(Vector< Variable >& scp);
+    ConstraintCompactTable(std::vector< Variable >& scp);
+    virtual Constraint clone() { return Constraint(new ConstraintCompactTable(scope)); }
+    virtual void initialise();
+    virtual ~ConstraintCompactTable();
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    //@}
+
+    /**@name Reversible sparse bitset*/
+    //@{
+    // undo the changes made on 'current' below the current level
+    void restore_words();
+    // current <- current & mask (or current & ~mask if 'complement' is true)
+    void intersect_with_mask(const bool complement);
+    // whether some word of 'current' is non-zero
+    inline bool is_empty() const { return !limit; }
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "compact-table"; }
+    //@}
+  };
+
+
+
+  /**********************************************
+   * MDD Constraint
+   **********************************************/
+  /*! \class ConstraintMDD
+    \brief  GAC on a multi-valued decision diagram (Cheng & Yap, Perez & Regin)
+
+    The diagram is given as an automaton (initial state, transitions and 
+    final states). It is unfolded over the layers of the scope, restricted 
+    to the initial domains, and reduced by merging the equivalent nodes 
+    bottom-up. A Regular constraint (Pesant) is exactly this layered graph, 
+    and a positive table is first turned into a trie.
+
+    Every node counts its live incoming and outgoing edges, and every pair 
+    x_i=a counts the live edges labelled a in layer i. When an edge dies, 
+    a node left without incoming (resp. outgoing) edge kills its outgoing 
+    (resp. incoming) edges, and a pair left without edge is pruned. The 
+    dead edges are trailed, and revived lazily at the beginning of the 
+    next call to propagate() (as for Compact-Table).
+  */
+  class ConstraintMDD : public GlobalConstraint {
+
+  public:
+
+    /**@name Parameters*/
+    //@{
+    // the automaton, transitions are triplets (state, value, next state)
+    int initial_state;
+    Vector< int > transitions;
+    Vector< int > final_states;
+
+    // the layered graph, node 0 is the root and node 1 the terminal (0 if not yet compiled)
+    int num_nodes;
+    Vector< int > edge_from;
+    Vector< int > edge_to;
+    Vector< int > edge_layer;
+    Vector< int > edge_value;
+    Vector< int > *in_edges;
+    Vector< int > *out_edges;
+    // value_edges[i][a-min_value[i]] is the list of edges labelled a in layer i
+    Vector< int > **value_edges;
+    int *min_value;
+    int *max_value;
+
+    // number of live edges in/out of each node, and with each label in each layer
+    int *in_count;
+    int *out_count;
+    int **support_count;
+    char *alive;
+
+    // trail of the dead edges
+    Vector< int > killed;
+    ReversibleNum<int> trail_size;
+    // whether the initial domains have been filtered on this branch
+    ReversibleNum<int> synced;
+    // edges to kill
+    Vector< int > to_kill;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintMDD(Vector< Variable >& scp, const int init, Vector< int >& trans, Vector< int >& finals);
+    ConstraintMDD(Vector< Variable >& scp, Vector< const int* >& tuples);
+    virtual ~ConstraintMDD();
+    virtual Constraint clone() { return Constraint(new ConstraintMDD(scope, initial_state, transitions, final_states)); }
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    virtual void initialise();
+    // unfolds and reduces the automaton, can be called before the constraint is posted 
+    void compile();
+    inline int num_edges() const { return edge_from.size; }
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    //@}
+
+    /**@name Layered graph*/
+    //@{
+    // revive the edges killed below the current level
+    void restore_edges();
+    // kill the live edges labelled a in layer i
+    void remove_value(const int i, const int a);
+    // kill the edges in 'to_kill' and those that depend on them
+    PropagationOutcome kill_edges();
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "mdd"; }
+    //@}
+  };
+
+
+
 
   // /**********************************************
   //  * BoolSum Equal Constraint
@@ -4103,7 +4482,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
     /**@name Constructors*/
     //@{
-    ConstraintBoolSumInterval() : GlobalConstraint() { priority = 1; }
+    ConstraintBoolSumInterval() : GlobalConstraint() { priority = LINEAR_COST; }
     ConstraintBoolSumInterval(Vector< Variable >& scp, const int l, const int u);
     ConstraintBoolSumInterval(std::vector< Variable >& scp, const int l, const int u);
     virtual Constraint clone() { return Constraint(new ConstraintBoolSumInterval(scope, lower_bound, upper_bound)); }
@@ -4176,7 +4555,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
     /**@name Constructors*/
     //@{
-    ConstraintWeightedBoolSumInterval() : GlobalConstraint() { priority = 1; }
+    ConstraintWeightedBoolSumInterval() : GlobalConstraint() { priority = LINEAR_COST; }
 
     ConstraintWeightedBoolSumInterval(Vector< Variable >& scp,
 				      const int L=0, const int U=0);
@@ -4260,7 +4639,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
     /**@name Constructors*/
     //@{
-    ConstraintIncrementalWeightedBoolSumInterval() : GlobalConstraint() { priority = 1; }
+    ConstraintIncrementalWeightedBoolSumInterval() : GlobalConstraint() { priority = LINEAR_COST; }
 
     ConstraintIncrementalWeightedBoolSumInterval(Vector< Variable >& scp,
 				      const int L=0, const int U=0);
@@ -4307,6 +4686,113 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
 
 
+  /**********************************************
+   * Watched BoolSum Constraint
+   **********************************************/
+  //  lb <= a1 * b1 + ... + an * bn  or  a1 * b1 + ... + an * bn <= ub
+  /// One-sided sum of Boolean variables, propagated with watched literals.
+  /// The constraint is normalised as c1 * l1 + ... + cn * ln >= bound, where
+  /// the li are literals and the ci positive coefficients. It is posted only
+  /// on a subset of the variables whose non-false literals have coefficients
+  /// summing up to at least bound + max(ci): as long as it is the case, no
+  /// literal is entailed, and the other variables need not wake it up.
+  /// The watches are not restored on backtrack: a false watch is dropped only
+  /// when literals of larger total coefficient replace it, or when the other
+  /// watches reach the target. When they cannot, every non-false literal is
+  /// watched, and no watch is dropped until we backtrack.
+  /// For a cardinality constraint (at least k), k+1 literals are watched.
+  /// Once the true watches reach the bound, the constraint is relaxed, and
+  /// posted again on the same watches when it is restored.
+  class ConstraintWatchedBoolSum : public GlobalConstraint {
+
+  public:
+    /**@name Parameters*/
+    //@{
+    // Lower bound of the linear expression
+    int lower_bound;
+
+    // Upper bound of the linear expression
+    int upper_bound;
+
+    // coefficients of the linear expression
+    Vector< int > weight;
+
+    // normalised form: sum of coefficient[i] * (scope[i] == polarity[i]) >= bound
+    Vector< int > coefficient;
+    Vector< int > polarity;
+    int bound;
+    int max_coefficient;
+
+    // permutation of the scope, the first 'num_watched' variables are watched
+    Vector< int > watched;
+    // position of each variable in 'watched'
+    Vector< int > position;
+    int num_watched;
+    // where to start looking for a new watch
+    int cursor;
+    // the sum of the watched literals must be recomputed on the next call
+    bool check_all;
+    // every non-false literal is watched, none can be dropped
+    ReversibleNum<int> saturated;
+    // lower bound of the sum of the coefficients of the true literals
+    ReversibleNum<int> satisfied;
+
+    bool init_prop;
+
+    // utils for the propagation
+    BoolDomain *domains;
+
+    // used to store the explanation when "get_reason_for()" is called
+    Vector<Literal> explanation;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintWatchedBoolSum() : GlobalConstraint() { priority = LINEAR_COST; }
+
+    ConstraintWatchedBoolSum(Vector< Variable >& scp,
+			     const int L=-INFTY, const int U=INFTY);
+    ConstraintWatchedBoolSum(Vector< Variable >& scp,
+			     Vector< int >& coefs,
+			     const int L=-INFTY, const int U=INFTY);
+    virtual Constraint clone() { return Constraint(new ConstraintWatchedBoolSum(scope, weight, lower_bound, upper_bound)); }
+    virtual void initialise();
+    virtual void mark_domain();
+    virtual bool explained() { return true; }
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    virtual ~ConstraintWatchedBoolSum();
+
+    /// Whether the sum is one-sided, and its watches at most half of its literals
+    /// (otherwise, the counters of ConstraintBoolSumInterval are cheaper)
+    static bool is_worthwhile(Vector< Variable >& scp, Vector< int >& coefs, const int L, const int U);
+    //@}
+
+    virtual iterator get_reason_for(const Atom a, const int lvl, iterator& end);
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+
+    inline bool is_false(const int i) const { return *(domains[i]) == 2-polarity[i]; }
+    inline bool is_true(const int i) const { return *(domains[i]) == 1+polarity[i]; }
+    int find_watch();
+    void watch(const int i);
+    void unwatch(const int i);
+    void relax_watches();
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "wbsum>="; }
+    //@}
+  };
+
+
+
   /**********************************************
    * WeightedBoolSum Predicate
    **********************************************/
@@ -4341,7 +4827,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
     /**@name Constructors*/
     //@{
-    PredicateWeightedBoolSum() : GlobalConstraint() { priority = 1; }
+    PredicateWeightedBoolSum() : GlobalConstraint() { priority = LINEAR_COST; }
 
     PredicateWeightedBoolSum(Vector< Variable >& scp, const int o=0);
     PredicateWeightedBoolSum(Vector< Variable >& scp,
@@ -4409,7 +4895,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
     /**@name Constructors*/
     //@{
-    PredicateBoolSum() : GlobalConstraint() { priority = 1; }
+    PredicateBoolSum() : GlobalConstraint() { priority = LINEAR_COST; }
     PredicateBoolSum(Vector< Variable >& scp, const int o=0);
     PredicateBoolSum(std::vector< Variable >& scp, const int o=0);
     PredicateBoolSum(Vector< Variable >& scp, Variable tot, const int o=0);
@@ -4449,6 +4935,14 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
    **********************************************/
   /*! \class ConstraintWeightedSum
     \brief  Constraint on a sum of variables (a1 * x1 + ... + an * xn = total)
+
+    The bounds of the terms (lo_bound, up_bound, span) and of the sum 
+    (smin, smax) are kept from one call to the next and only updated for 
+    the variables in 'events'. They are trailed with a timestamp and 
+    restored lazily at the beginning of propagate(), as for Compact-Table. 
+    The terms are visited by decreasing initial span, and the scan stops 
+    as soon as no remaining span exceeds the slack ('max_span' is an upper 
+    bound on the current spans).
   */
   class PredicateWeightedSum : public GlobalConstraint {
 
@@ -4472,6 +4966,26 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     int *lo_bound;
     int *up_bound;
     int *span;
+    // bounds of the sum w.r.t. lo_bound and up_bound
+    int smin;
+    int smax;
+    // whether lo_bound and up_bound have been computed on this branch
+    ReversibleNum<int> synced;
+
+    // trail for the bounds (index, previous bounds, previous stamp)
+    Vector< int > trail_index;
+    Vector< int > trail_lo;
+    Vector< int > trail_up;
+    Vector< int > trail_stamp;
+    // level at which each bound was last saved
+    int *stamp;
+    ReversibleNum<int> trail_size;
+
+    // the terms by decreasing initial span
+    int *by_span;
+    int *init_span;
+    ReversibleNum<int> max_span;
+
     ReversibleNum<int> parity;
     //ReversibleIntStack unknown_parity;
     ReversibleSet unknown_parity;
@@ -4509,6 +5023,17 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     virtual int check( const int* sol ) const ;
     virtual PropagationOutcome propagate();
     virtual RewritingOutcome rewrite();
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
+    //@}
+
+    /**@name Incremental bounds*/
+    //@{
+    // undo the changes made on the bounds below the current level
+    void restore_bounds();
+    // sets lo_bound[i] and up_bound[i] to the bounds of scope[i], and updates smin and smax
+    void update_bounds(const int i);
+    // same, without trailing
+    void set_bounds(const int i, const int lo, const int up);
     //@}
 
     /**@name Miscellaneous*/
@@ -4630,6 +5155,125 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
 
 
 
+  /**********************************************
+   * Gauss-Jordan Constraint
+   **********************************************/
+  /*! \class ConstraintGaussJordan
+    \brief  A system of parity constraints over Boolean variables, 
+    propagated by Gauss-Jordan elimination over GF(2)
+
+    Each row is stored as 'num_words' 64-bit words followed by its 
+    right-hand side and its pivot. The matrix is kept in reduced row 
+    echelon form w.r.t. the unassigned columns: the pivot of a row is 
+    unassigned and appears in no other row. When the pivot of a row gets 
+    assigned, another unassigned column of the row becomes its pivot and 
+    is eliminated from the other rows. A row with a single unassigned 
+    column implies it, a row with none may be a conflict.
+
+    The rows, the mask of assigned columns and the mask of columns 
+    assigned to 1 are blocks of words, saved with a timestamp the first 
+    time they change at a given level, and restored lazily at the 
+    beginning of the next call to propagate() (as for Compact-Table).
+    The assigned columns are never removed from the rows, so that the 
+    other columns of a row always explain the deductions made with it.
+  */
+  class ConstraintGaussJordan : public GlobalConstraint {
+
+  public:
+
+    typedef unsigned long long int word;
+
+    /**@name Parameters*/
+    //@{ 
+    // the system: equations[r] is a list of indices in scope, whose sum modulo 2 is parities[r]
+    Vector< Vector< int > > equations;
+    Vector< int > parities;
+
+    int num_rows;
+    int num_words;
+    // size of a block (row words, rhs, 1 + pivot)
+    int block_size;
+    // blocks 0..num_rows-1 are the rows, then the assigned and value masks
+    word *data;
+    // row whose pivot is the column, or -1
+    int *row_of_pivot;
+
+    // trail of the blocks (index, previous words, previous stamp)
+    Vector< int >  trail_block;
+    Vector< word > trail_words;
+    Vector< int >  trail_stamp;
+    // level at which each block was last saved
+    int *stamp;
+    ReversibleNum<int> trail_size;
+    // whether the matrix has been reduced on this branch
+    ReversibleNum<int> synced;
+
+    // columns to process and rows to check
+    IntStack to_process;
+    IntStack to_check;
+
+    // reason[i] is the row (list of columns) that implied scope[i], reason[scope.size] the conflict
+    Vector< int > *reason;
+    // index in scope of each variable id
+    int *index_of;
+    int max_id;
+
+    // used to store the explanation when "get_reason_for()" is called
+    Vector< Literal > explanation;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintGaussJordan(Vector< Variable >& scp);
+    ConstraintGaussJordan(Vector< Variable >& scp, Vector< Vector< int > >& eqs, Vector< int >& p);
+    virtual ~ConstraintGaussJordan();
+    virtual Constraint clone() { return Constraint(new ConstraintGaussJordan(scope, equations, parities)); }
+    virtual bool explained() { return true; }
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    virtual void initialise();
+    // adds the equation sum(scope[cols]) = p (mod 2)
+    void add_equation(Vector< int >& cols, const int p);
+    //@}
+
+    virtual iterator get_reason_for(const Atom a, const int lvl, iterator& end);
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
+    //@}
+
+    /**@name Matrix*/
+    //@{
+    inline word* row(const int r) const { return data + r*block_size; }
+    inline word* assigned() const { return data + num_rows*block_size; }
+    inline word* values() const { return data + (num_rows+1)*block_size; }
+    inline word& rhs(const int r) const { return data[r*block_size+num_words]; }
+    inline word& pivot(const int r) const { return data[r*block_size+num_words+1]; }
+    // saves block b if it was not yet saved at this level
+    void save_block(const int b);
+    // undo the changes made below the current level
+    void restore_blocks();
+    // builds the rows from the equations and reduces the matrix
+    void reduce();
+    // scope[i] is now assigned, update the masks and the pivots
+    void assign(const int i);
+    // the list of columns of row r other than i is the reason for i
+    void store_reason(const int r, const int i);
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "gauss-jordan"; }
+    //@}
+  };
+
+
+
   /**********************************************
    * AtMostSeqCard Constraint
    **********************************************/
@@ -4944,15 +5588,36 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
    * Element Predicate
    **********************************************/
   /*! \class PredicateElement
-    \brief  
+    \brief  X[N-offset] = V (domain consistency)
+
+    Each index i of N has a residual support (a value of X[i] that is also 
+    in V) and each value v of V has a residual support (an index i of N 
+    such that v is in X[i]). The values supported by an index are linked in 
+    a list, so when X[i] changes or i leaves N, only the values of that list
+    are checked again, instead of every value of V. The residues and lists 
+    are not restored on backtrack since domains can only grow back.
   */
   class PredicateElement : public GlobalConstraint {
 
   public:
     /**@name Parameters*/
     //@{ 
-    BitSet aux_dom;
     int offset;
+
+    /// residual support of each index (a value)
+    int *index_support;
+    /// residual support of each value v of V, from 'min_value' to 'max_value' (an index)
+    int *value_support;
+    int min_value;
+    int max_value;
+    /// the values supported by each index, as doubly linked lists (of v-min_value)
+    int *first_value;
+    int *next_value;
+    int *prev_value;
+    /// the indices of N whose list has been checked
+    ReversibleSet live;
+    /// whether the lists were built on this branch
+    ReversibleNum<int> synced;
     //@}
 
     /**@name Constructors*/
@@ -4975,6 +5640,26 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     //@{
     virtual int check( const int* sol ) const ;
     virtual PropagationOutcome propagate();
+    /// whether X[i] and V intersect (updates the residual support of i)
+    bool index_supported(const int i);
+    /// an index i of N such that v is in X[i], or -1 
+    int find_support(const int v);
+    /// moves v (minus min_value) to the list of index i
+    inline void set_support(const int k, const int i) {
+      if(value_support[k] >= 0) {
+	if(prev_value[k] >= 0) next_value[prev_value[k]] = next_value[k];
+	else first_value[value_support[k]] = next_value[k];
+	if(next_value[k] >= 0) prev_value[next_value[k]] = prev_value[k];
+      }
+      value_support[k] = i;
+      prev_value[k] = -1;
+      next_value[k] = first_value[i];
+      if(first_value[i] >= 0) prev_value[first_value[i]] = k;
+      first_value[i] = k;
+    }
+    /// checks again the values supported by index i
+    PropagationOutcome revise(const int i);
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
     //virtual RewritingOutcome rewrite();
     //@}
 
@@ -4986,6 +5671,75 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
   };
 
 
+  /**********************************************
+   * ConstantElement Predicate
+   **********************************************/
+  /*! \class PredicateConstantElement
+    \brief  values[N-offset] = V, for an array of constants
+
+    The distinct values of the array are sorted, and the indices are 
+    grouped by value. The ranks of the values of V that may still have a 
+    support are kept in a reversible interval, so the bounds of V and of 
+    the corresponding indices are updated with a binary search and amortised
+    constant time along a branch. Interior values are then filtered with a 
+    residual support per value.
+  */
+  class PredicateConstantElement : public GlobalConstraint {
+
+  public:
+    /**@name Parameters*/
+    //@{ 
+    Vector< int > values;
+    int offset;
+
+    /// the distinct values of the array, in increasing order
+    Vector< int > sorted_values;
+    /// the indices whose value is sorted_values[r] are indices[first[r]..first[r+1]-1] 
+    Vector< int > first;
+    Vector< int > indices;
+    /// residual support of each rank (a position in 'indices')
+    Vector< int > residue;
+    /// the ranks outside [lb_rank, ub_rank] have no support
+    ReversibleNum<int> lb_rank;
+    ReversibleNum<int> ub_rank;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    PredicateConstantElement(Vector< Variable >& scp, const Vector< int >& vals, const int o=0);
+    virtual ~PredicateConstantElement();
+    virtual Constraint clone() { return Constraint(new PredicateConstantElement(scope, values, offset)); }
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    virtual void initialise();
+    virtual void mark_domain();
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    /// whether some index of N has the value of rank r 
+    inline bool supported(const int r) {
+      if(scope[0].contain(indices[residue[r]]+offset)) return true;
+      for(int k=first[r]; k<first[r+1]; ++k) 
+	if(scope[0].contain(indices[k]+offset)) {
+	  residue[r] = k;
+	  return true;
+	}
+      return false;
+    }
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "[c]="; }
+    //@}
+  };
+
+
   /**********************************************
    * BoolElement Predicate
    **********************************************/
@@ -5046,7 +5800,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     
     /**@name Constructors*/
     //@{
-    ConstraintCliqueNotEqual() : GlobalConstraint() { priority = 2; }
+    ConstraintCliqueNotEqual() : GlobalConstraint() { priority = LINEAR_COST; }
     ConstraintCliqueNotEqual(Vector< Variable >& scp);
     ConstraintCliqueNotEqual(std::vector< Variable >& scp);
     ConstraintCliqueNotEqual(Variable* scp, const int n);
@@ -5147,7 +5901,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
   public:
     /**@name Constructors*/
     //@{
-    ConstraintAllDiff() : GlobalConstraint() { priority = 0; }
+    ConstraintAllDiff() : GlobalConstraint() { priority = QUADRATIC_COST; }
     ConstraintAllDiff(Vector< Variable >& scp);
     ConstraintAllDiff(std::vector< Variable >& scp);
     ConstraintAllDiff(Variable* scp, const int n);
@@ -5168,6 +5922,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
     virtual PropagationOutcome propagate();
     //virtual PropagationOutcome propagate(const int changed_idx, const Event evt);
     //virtual RewritingOutcome rewrite();
+    virtual void explain_bound(ConstraintLazyClauseBase *lcg, const int x, const int upper, const int v);
     //@}
 
     /**@name Miscellaneous*/
@@ -5185,6 +5940,207 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
   };
 
 
+  /***********************************************
+   * All Different Constraint (arc consistency).
+   ***********************************************/
+  /*! \class ConstraintAllDiffGAC
+    \brief  GAC on AllDifferent (Regin, AAAI'94)
+
+    A maximum matching between the variables and the values is kept 
+    from one call to the next: it stays valid on backtrack since the 
+    domains only grow, and only the variables whose matched value was 
+    removed need to be re-matched (with augmenting paths). A value can 
+    then be removed from a domain unless the edge belongs to the 
+    matching, to an alternating cycle (both ends in the same strongly 
+    connected component) or to an even alternating path starting from 
+    a free value.
+  */
+  class ConstraintAllDiffGAC : public GlobalConstraint {
+
+  public:
+    /**@name Parameters*/
+    //@{  
+    // the values range in [minval, minval+num_values-1]
+    int minval;
+    int num_values;
+    // the matching (var_match[i] is a value, val_match[v-minval] a variable index, or -1)
+    int *var_match;
+    int *val_match;
+
+    // the graph has a node for each variable (0..n-1) and each value (n..n+num_values-1)
+    // var -> value for the edges out of the matching, value -> var for the others
+    int *visited;
+    int stamp;
+    int *component;
+    int *lowlink;
+    int *order;
+    Vector< int > tarjan_stack;
+    Vector< int > call_stack;
+    Vector< int > next_edge;
+    // values from which a free value is reachable
+    int *reach_free;
+    Vector< int > pruning;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintAllDiffGAC() : GlobalConstraint() { priority = QUADRATIC_COST; }
+    ConstraintAllDiffGAC(Vector< Variable >& scp);
+    ConstraintAllDiffGAC(std::vector< Variable >& scp);
+    virtual Constraint clone() { return Constraint(new ConstraintAllDiffGAC(scope)); }
+    virtual void initialise();
+    virtual void mark_domain();
+    virtual ~ConstraintAllDiffGAC();
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    // finds an augmenting path from the free variable x, returns false if there is none
+    bool augment(const int x);
+    // strongly connected components of the graph, by Tarjan's algorithm
+    void compute_components();
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "alldiff-gac"; }
+    //@}
+  };
+
+
+  /***********************************************
+   * Circuit Constraint.
+   ***********************************************/
+  /*! \class ConstraintCircuit
+    \brief  Hamiltonian circuit over successor variables
+
+    scope[i] is the successor of node i, the arcs i -> scope[i] form a 
+    single cycle through the n nodes. Values out of [0,n-1] and self-loops 
+    are removed, the assigned successors are all different and the arc 
+    closing a chain of assigned successors into a subtour is forbidden. 
+    Then the graph of the domains must be strongly connected, and the arc 
+    i -> j is removed whenever j dominates i in the flow graph from node 0 
+    (the tour visits j before i), or i dominates j in the reversed graph.
+  */
+  class ConstraintCircuit : public GlobalConstraint {
+
+  public:
+    /**@name Parameters*/
+    //@{  
+    // successor and predecessor lists of the graph of the domains
+    Vector< int > *successors;
+    Vector< int > *predecessors;
+    // assigned predecessor of each node, or -1
+    int *pred;
+    // dominator tree (from node 0), its preorder numbering and the highest number in each subtree
+    int *idom;
+    Vector< int > *children;
+    int *preorder;
+    int *last;
+    // postorder numbering of the graph
+    int *rank;
+    Vector< int > dfs_stack;
+    Vector< int > next_edge;
+    Vector< int > ordering;
+    Vector< int > pruning;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintCircuit() : GlobalConstraint() { priority = QUADRATIC_COST; }
+    ConstraintCircuit(Vector< Variable >& scp);
+    virtual Constraint clone() { return Constraint(new ConstraintCircuit(scope)); }
+    virtual void initialise();
+    virtual void mark_domain();
+    virtual ~ConstraintCircuit();
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    // alldiff and subtour elimination on the assigned successors (the removals are left in 'pruning')
+    PropagationOutcome filter_chains(int& num_assigned);
+    // dominator tree of the graph (reversed if 'reverse') from node 0, returns false if a node is unreachable
+    bool compute_dominators(const bool reverse);
+    // whether i dominates j, in the tree computed last
+    inline bool dominates(const int i, const int j) const { return preorder[i] <= preorder[j] && preorder[j] <= last[i]; }
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "circuit"; }
+    //@}
+  };
+
+
+  /*! \class ConstraintWeightedCircuit
+    \brief  Cost of a Hamiltonian circuit (assignment relaxation)
+
+    The last variable of the scope is the cost of the circuit formed by 
+    the n first (successor) variables, that is the sum of weight[i][scope[i]]. 
+    The relaxation dropping the subtour elimination constraints is an 
+    assignment problem, solved with the Hungarian method: its optimal cost 
+    is a lower bound of the cost variable, and an arc whose reduced cost 
+    added to this bound exceeds the upper bound of the cost is removed.
+    It does not enforce the circuit itself (see ConstraintCircuit).
+  */
+  class ConstraintWeightedCircuit : public GlobalConstraint {
+
+  public:
+    /**@name Parameters*/
+    //@{  
+    int num_nodes;
+    int **weight;
+    // dual variables and assignment of the relaxation (1-indexed, as in the Hungarian method)
+    int *row_dual;
+    int *col_dual;
+    int *col_match;
+    int *slack;
+    int *slack_row;
+    bool *used;
+    Vector< int > pruning;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintWeightedCircuit() : GlobalConstraint() { priority = CUBIC_COST; }
+    ConstraintWeightedCircuit(Vector< Variable >& scp, Vector< int >& wgt);
+    virtual Constraint clone();
+    virtual void initialise();
+    virtual void mark_domain();
+    virtual ~ConstraintWeightedCircuit();
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const ;
+    virtual PropagationOutcome propagate();
+    // optimal cost of the assignment relaxation, or INFTY if there is none
+    int solve_assignment();
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "weighted-circuit"; }
+    //@}
+  };
+
+
 
   /***********************************************
    * Global Cardinality Constraint (bounds consistency).
@@ -5258,7 +6214,7 @@ std::cout << "[" << std::setw(4) << id << "](" << name() << "): restore" << std:
   public:
     /**@name Constructors*/
     //@{
-    ConstraintOccurrences() : GlobalConstraint() { priority = 0; }
+    ConstraintOccurrences() : GlobalConstraint() { priority = CUBIC_COST; }
     ConstraintOccurrences(Vector< Variable >& scp,
 			  const int firstDomainValue,
 			  const int lastDomainValue,
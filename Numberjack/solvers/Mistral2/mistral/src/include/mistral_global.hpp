@@ -30,6 +30,8 @@
 #define _MISTRAL_GLOBAL_HPP
 
 #include <stdint.h>
+#include <stdio.h>
+#include <time.h>
 
 #include <string>
 #include <iostream>
@@ -171,6 +173,7 @@ namespace Mistral {
 #define MIN_CAPACITY 16
 #define NULL_ATOM 0xffffffff
   
+#define ARC_CONSISTENCY 2
 #define BOUND_CONSISTENCY 1
 #define FORWARD_CHECKING 0
 
@@ -212,6 +215,15 @@ namespace Mistral {
 #define CTYPE      0x007fffff
 #define ITYPE      0xff800000
 
+  // cost classes of the propagators, used as priority in the constraint queue:
+  // the postponed propagators of a class are called only once the cheaper 
+  // classes have reached their fix point
+#define CUBIC_COST      0
+#define QUADRATIC_COST  1
+#define LINEAR_COST     2
+#define BINARY_COST     3
+#define NUM_COST_CLASSES 4
+
   static const int size_byte[8] = {0,1,1,2,1,2,2,3};
 
 #ifdef _PROFILING
@@ -448,8 +460,97 @@ namespace Mistral {
 
   double get_run_time();
   unsigned long int get_memory();
+
+  /// Return a cycle count (time stamp counter if available, nanoseconds otherwise)
+  inline unsigned long long int get_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((unsigned long long int)hi << 32) | lo;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long int)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+  }
   void get_command_line(const char**,int*,int,const char**,const char**,int,char**,int);
 
+
+  /**********************************************
+   * Input file
+   *********************************************/
+  /*! \class InputFile
+    \brief Sequential reader for the DIMACS, OPB and XCSP parsers
+
+    Plain files are mapped in memory (or read by large chunks when mmap
+    is not available). Files ending in ".gz" or ".xz" are decompressed on
+    the fly by gzip/xz through a pipe, one buffer at a time, so they are
+    never held in memory as a whole.
+  */
+  class InputFile {
+
+  public:
+
+    /**@name Parameters*/
+    //@{
+    /// chunk of the file being read
+    const char *cur;
+    const char *end;
+
+    FILE *stream;
+    bool piped;
+    char *buffer;
+    char *map;
+    size_t map_size;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    InputFile(const char* filename);
+    virtual ~InputFile();
+    //@}
+
+    /**@name Accessors*/
+    //@{
+    bool is_open() const { return stream || map; }
+
+    /// the current character (EOF at the end of the file)
+    inline int peek() { return (cur < end || refill()) ? (unsigned char)(*cur) : EOF; }
+    inline int get() { int c = peek(); cur += (c != EOF); return c; }
+
+    inline void skip_blanks() {
+      int c;
+      while((c = peek()) == ' ' || (unsigned int)(c - '\t') < 5) ++cur;
+    }
+    inline void skip_line() {
+      int c;
+      while((c = get()) != '\n' && c != EOF) ;
+    }
+
+    /// reads an optional sign followed by digits, the sign is applied without branching
+    inline int read_int() {
+      skip_blanks();
+      int c = peek();
+      int neg = (c == '-');
+      cur += (neg | (c == '+'));
+      unsigned int x = 0, d;
+      while((d = (unsigned int)(peek() - '0')) < 10) {
+	x = x*10 + d;
+	++cur;
+      }
+      return ((int)x ^ -neg) + neg;
+    }
+
+    /// reads the next sequence of non-blank characters
+    void read_word(std::string& word);
+    //@}
+
+  private:
+    /// reads the next chunk of a stream, returns false at the end of the file
+    bool refill();
+  };
+
+
   template <class WORD_TYPE>
   void print_bitset(WORD_TYPE n, const int idx, std::ostream& os) {
     int offset = 8*sizeof(WORD_TYPE)*idx;
@@ -275,6 +275,106 @@ namespace Mistral {
   std::ostream& operator<< (std::ostream& os, SatSolver* x);
 
 
+  /***********************************************
+   * Clause Arena
+   ***********************************************/
+  /*! \class ClauseInfo
+    \brief Header stored in front of every clause of a ClauseArena
+  */
+#define CORE_TIER  0
+#define MID_TIER   1
+#define LOCAL_TIER 2
+
+  class ClauseInfo {
+
+  public:
+
+    /// activity of a learnt clause, bumped when it takes part in a conflict
+    float activity;
+    /// literal block distance (number of distinct decision levels)
+    unsigned int lbd : 26;
+    /// CORE_TIER (kept forever), MID_TIER (kept while used) or LOCAL_TIER
+    unsigned int tier : 2;
+    unsigned int learnt : 1;
+    /// whether the clause took part in a conflict since the last reduction
+    unsigned int used : 1;
+    unsigned int deleted : 1;
+    /// the clause was moved by a garbage collection, its first word holds the new address 
+    unsigned int relocated : 1;
+  };
+
+
+  /*! \class ClauseArena
+    \brief Contiguous storage for clauses
+
+    Clauses are allocated one after the other in large blocks, each of 
+    them preceded by its ClauseInfo. Freeing a clause only marks it, the 
+    memory is reclaimed by copying the live clauses into a fresh arena
+    (see ConstraintClauseBase::collect()).
+  */
+  class ClauseArena {
+
+  public:
+
+    /**@name Parameters*/
+    //@{ 
+    Vector< char* > blocks;
+    Vector< size_t > block_size;
+    /// bytes used and available in the last block
+    size_t used;
+    size_t capacity;
+    /// bytes allocated and freed over all blocks
+    size_t allocated;
+    size_t wasted;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ClauseArena();
+    virtual ~ClauseArena();
+    void release();
+    void swap(ClauseArena& a);
+    //@}
+
+    /**@name Accessors*/
+    //@{
+    Clause* allocate(const Vector< Literal >& lits, const bool learnt);
+    Clause* allocate(const Literal* lits, const unsigned int n, const bool learnt);
+    /// makes sure that the next n bytes are allocated in the same block
+    void reserve(const size_t n);
+    void free_clause(Clause* cl);
+    /// whether ptr points inside one of the blocks
+    bool contain(const void* ptr) const;
+
+    static inline ClauseInfo* info(Clause* cl) { return ((ClauseInfo*)cl)-1; }
+    static inline size_t footprint(const unsigned int n) {
+      return (sizeof(ClauseInfo) + sizeof(Clause) + n*sizeof(Literal) + 7) & ~((size_t)7);
+    }
+    //@}
+  };
+
+
+  /*! \class Watcher
+    \brief A clause watching a literal, together with a "blocker" literal
+    of that clause. When the blocker is true the clause need not be visited.
+  */
+  class Watcher {
+
+  public:
+
+    Clause* clause;
+    Literal blocker;
+
+    Watcher() : clause(NULL), blocker(0) {}
+    Watcher(Clause* c, const Literal b) : clause(c), blocker(b) {}
+
+    inline bool operator==(const Watcher& w) const { return clause == w.clause; }
+    inline bool operator!=(const Watcher& w) const { return clause != w.clause; }
+  };
+
+  std::ostream& operator<< (std::ostream& os, const Watcher& x);
+
+
   /***********************************************
    * NogoodBase Constraint (forward checking).
    ***********************************************/
@@ -299,13 +399,25 @@ namespace Mistral {
     // list of clauses
     Vector< Clause* > clauses;
     Vector< Clause* > learnt;
+    // storage for both
+    ClauseArena arena;
     // the watched literals data structure
-    Vector< Vector< Clause* > > is_watched_by;
+    Vector< Vector< Watcher > > is_watched_by;
+
+    // learnt clauses database management
+    float clause_increment;
+    unsigned int num_reductions;
+    unsigned long int next_reduction;
+    // timestamps used to compute the lbd
+    Vector< unsigned int > level_stamp;
+    unsigned int lbd_stamp;
+    // buffer used when copying clauses
+    Vector< Literal > lit_buffer;
     //@}
     
     /**@name Constructors*/
     //@{
-    ConstraintClauseBase() : GlobalConstraint() { conflict = NULL; }
+    ConstraintClauseBase() : GlobalConstraint() { conflict = NULL; clause_increment = 1; num_reductions = 0; next_reduction = 0; lbd_stamp = 0; }
     ConstraintClauseBase(Vector< Variable >& scp);
     virtual void mark_domain();
     virtual Constraint clone() { return Constraint(new ConstraintClauseBase(scope), type); }
@@ -318,11 +430,27 @@ namespace Mistral {
     virtual bool explained() { return true; }
     void add( Variable x );
     void add( Vector < Literal >& clause, double init_activity=0.0 );
+    /// adds the clauses lits[ends[i-1]..ends[i]-1], growing the arena and the watch lists once
+    void add( Vector < Literal >& lits, Vector < unsigned int >& ends );
     void learn( Vector < Literal >& clause, double init_activity=0.0 );
     void remove( const int cidx );
-    //void forget( const double forgetfulness, const Vector< double >& activity );
-    // (returns the toal removed size)
-    int forget( const double forgetfulness, const double * vactivity, const double * lactivity );
+    // reduces the learnt clauses database if it is time to do so 
+    // (returns the total removed size)
+    int forget( const double forgetfulness );
+    //@}
+
+    /**@name Learnt clauses database*/
+    //@{
+    unsigned int compute_lbd( const Literal* lits, const unsigned int n );
+    // called on every clause taking part in a conflict
+    void bump( Clause* cl );
+    void decay_clause_activity();
+    // whether the clause is currently the reason for one of its literals
+    bool locked( Clause* cl );
+    // removes the watchers of the deleted clauses, and the references to them
+    void detach_deleted();
+    // copies the live clauses to a fresh arena and relocate all references
+    void collect();
     //@}
 
     /**@name Solving*/
@@ -354,6 +482,198 @@ namespace Mistral {
   };
 
 
+  /*! \class BoundChange
+    \brief An entry of the trail of bound changes used for lazy clause generation
+  */
+  class BoundChange {
+
+  public:
+
+    /// the variable (its index in the solver) and its new bound
+    int var;
+    int value;
+    /// 1 if 'value' is an upper bound, 0 if it is a lower bound
+    int upper;
+    int level;
+    /// index of the previous change of the same bound of 'var' (-1 if none)
+    int prev;
+    /// NULL for decisions, the propagator or the lazy clause otherwise
+    Explanation *reason;
+
+    BoundChange() : var(-1), value(0), upper(0), level(0), prev(-1), reason(NULL) {}
+    BoundChange(const int x, const int v, const int u, const int l, const int p, Explanation *r) 
+      : var(x), value(v), upper(u), level(l), prev(p), reason(r) {}
+  };
+
+
+  /***********************************************
+   * LazyClauseBase Constraint.
+   ***********************************************/
+  /*! \class ConstraintLazyClauseBase
+    \brief Lazy clause generation over order literals.
+
+    Every bound change of an integer variable is recorded on a trail,
+    together with its reason (the propagator that made it, a lazy clause,
+    or NULL for a decision). Order atoms [x <= v] are created on demand
+    when a clause mentions them: the literal POS(a) stands for [x <= v] 
+    and NEG(a) for [x >= v+1]. On a failure, the propagators are asked to
+    explain their prunings (see ConstraintImplementation::explain_bound())
+    and a 1-UIP nogood over order literals is learnt and propagated with 
+    two watched literals.
+
+    Holes in the domains are not expressible as order literals: when a 
+    hole was made below the root, the decisions down to the deepest such 
+    hole are added to the nogood, and nothing is learnt if it was made at 
+    the level of the conflict. The learnt clauses are dropped when the 
+    solver backtracks below the root they were learnt from.
+  */
+  class ConstraintLazyClauseBase : public GlobalConstraint {
+
+  public:
+
+    /**@name Parameters*/
+    //@{ 
+    /// the trail of bound changes, and the first change not yet propagated 
+    Vector< BoundChange > trail;
+    int qhead;
+    /// index of the last change of the bounds of each variable (-1 if none)
+    Vector< int > last_lb;
+    Vector< int > last_ub;
+    /// bounds when the trail was started
+    Vector< int > init_lb;
+    Vector< int > init_ub;
+    int init_level;
+    /// levels where a hole was made in a domain (increasing)
+    Vector< int > hole_levels;
+    /// whether the domain of each variable was an interval when the trail was started
+    Vector< char > interval;
+    /// reason given to the following bound changes
+    Explanation *cause;
+
+    /// order atoms: atom a stands for [atom_var[a] <= atom_value[a]]
+    Vector< int > atom_var;
+    Vector< int > atom_value;
+    /// atoms of each variable, sorted by value
+    Vector< Vector< int >* > atoms_of;
+    Vector< Vector< Watcher >* > is_watched_by;
+
+    /// learnt clauses
+    Vector< Clause* > learnt;
+    ClauseArena arena;
+    float clause_increment;
+    unsigned int num_reductions;
+    unsigned long int next_reduction;
+    /// the clauses are valid as long as the solver does not backtrack below this level
+    int learnt_root;
+    /// the conflicting clause, and the last learnt clause
+    Clause *conflict;
+    Clause *asserting;
+    unsigned long int num_conflicts;
+    //@}
+
+    /**@name Conflict analysis*/
+    //@{ 
+    /// the bounds are read as they were before this index of the trail
+    int explain_time;
+    bool explanation_ok;
+    int conflict_level;
+    int root_level;
+    int pathC;
+    /// for each trail entry, whether it takes part in the conflict and the bound needed
+    Vector< char > seen;
+    Vector< int > need;
+    /// bounds needed from lower levels, and the variables concerned
+    Vector< int > needed_lb;
+    Vector< int > needed_ub;
+    Vector< int > touched;
+    Vector< Literal > lit_buffer;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    ConstraintLazyClauseBase(Vector< Variable >& scp);
+    virtual Constraint clone() { return Constraint(new ConstraintLazyClauseBase(scope), type); }
+    virtual void initialise();
+    virtual ~ConstraintLazyClauseBase();
+
+    virtual int idempotent() { return 1;}
+    virtual int postponed() { return 1;}
+    virtual int pushed() { return 1;}
+    //@}
+
+    /**@name Bound trail*/
+    //@{
+    /// called by the solver after every event on 'x'
+    void record(const int x);
+    /// pops the changes made at a level above 'lvl'
+    void cancel_until(const int lvl);
+
+    inline int current_lb(const int x) const { return (last_lb[x] < 0 ? init_lb[x] : trail[last_lb[x]].value); }
+    inline int current_ub(const int x) const { return (last_ub[x] < 0 ? init_ub[x] : trail[last_ub[x]].value); }
+    //@}
+
+    /**@name Order literals*/
+    //@{
+    /// returns the atom [x <= v], creates it if necessary
+    int get_atom(const int x, const int v);
+    /// [x >= v] and [x <= v]
+    inline Literal geq_literal(const int x, const int v) { return NEG(get_atom(x, v-1)); }
+    inline Literal leq_literal(const int x, const int v) { return POS(get_atom(x, v)); }
+    /// V_TRUE, V_FALSE or V_UNKNOWN
+    int literal_value(const Literal l) const;
+    /// index in the trail of the change that made 'l' true, before 'explain_time' (-1 if none)
+    int entailing_change(const int x, const int v, const int upper) const;
+    //@}
+
+    /**@name Explanations*/
+    //@{
+    /// bounds of x before the bound change that is being explained
+    int get_lb(const int x);
+    int get_ub(const int x);
+    inline int get_lb(Variable x) { return (x.id() < 0 ? x.get_min() : get_lb(x.id())); }
+    inline int get_ub(Variable x) { return (x.id() < 0 ? x.get_max() : get_ub(x.id())); }
+    /// adds [x >= v] (resp. [x <= v]) to the explanation
+    void add_lb(const int x, const int v);
+    void add_ub(const int x, const int v);
+    inline void add_lb(Variable x, const int v) { if(x.id() >= 0) add_lb(x.id(), v); }
+    inline void add_ub(Variable x, const int v) { if(x.id() >= 0) add_ub(x.id(), v); }
+    /// adds both current bounds of x
+    inline void add_bounds(Variable x) { 
+      if(x.id() >= 0) { add_lb(x.id(), get_lb(x.id())); add_ub(x.id(), get_ub(x.id())); } 
+    }
+    /// explains [x >= v] (upper=0) or [x <= v] (upper=1), x=-1 stands for the failure of 'e'
+    void explain(Explanation *e, const int x, const int upper, const int v);
+    /// computes a 1-UIP nogood, returns false if the failure could not be explained
+    bool learn_nogood(Explanation *failure);
+    /// the decision that asserts the first literal of the last nogood
+    Decision get_deduction();
+    //@}
+
+    /**@name Learnt clauses database*/
+    //@{
+    void bump( Clause* cl );
+    bool locked( Clause* cl );
+    int forget( const double forgetfulness );
+    void clear_learnt();
+    void collect();
+    //@}
+
+    /**@name Solving*/
+    //@{
+    virtual int check( const int* sol ) const { return 0; }
+    virtual PropagationOutcome propagate();
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{  
+    std::ostream& display_literal(std::ostream& os, const Literal l) ;
+    virtual std::ostream& display(std::ostream&) const ;
+    virtual std::string name() const { return "lazy_clause_base"; }
+    //@}
+    
+  };
+
+
   // typedef Decision ExtLiteral;
   // typedef Array< ExtLitreal > ExtClause;
 
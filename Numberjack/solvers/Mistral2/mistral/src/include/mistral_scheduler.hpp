@@ -80,7 +80,7 @@ namespace Mistral {
 		static const int RGUIDED =  3;
 		static const int RAND    =  4;
 
-		static const int nia = 20;
+		static const int nia = 21;
 		static const char* int_ident[nia];
     
 		static const int nsa = 11;
@@ -117,6 +117,7 @@ namespace Mistral {
 		//int MinRank; // Whether the sum of the disjunct should be minimised
 		int OrderTasks; // Whetheer tasks should be ordered within the disjuncts
 		int NgdType; // nogood type for solution removal
+		int Unary; // "unary": 0: binary disjuncts, 1: disjuncts and unary resource constraints, 2: unary resource constraints only
 
 		double Factor;
 		double Decay;
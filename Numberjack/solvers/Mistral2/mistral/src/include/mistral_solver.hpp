@@ -105,6 +105,8 @@ namespace Mistral {
 
 
     int backjump;
+    /// whether nogoods over bound literals are learnt (lazy clause generation)
+    int lazy_generation;
 
     /// whether solutions are checked
     // 0 -> not checked
@@ -113,6 +115,9 @@ namespace Mistral {
     // 3 -> 2+check that all values are consistent for other constraints
     // NOT IMPLEMENTED! 4 -> check that the solution can be extended to all variables
     int checked; 
+
+    /// whether the calls, prunings, failures and cycles of each propagator are recorded
+    int profiling;
      
 
 
@@ -122,6 +127,14 @@ namespace Mistral {
     int               init_activity;
     double            forgetfulness;
     double            activity_decay;
+    /// learnt clauses of lbd up to lbd_core are never forgotten, 
+    /// and those of lbd up to lbd_mid are kept while they are used
+    int               lbd_core;
+    int               lbd_mid;
+    /// conflicts before the first reduction of the learnt clauses,
+    /// and increment of that number after each reduction
+    int               reduce_base;
+    int               reduce_increment;
 
     int               value_selection;
     int               dynamic_value;
@@ -137,6 +150,25 @@ namespace Mistral {
 
   };
 
+  /*! \class PropagatorProfile
+    \brief Calls, prunings, failures and cycles of all the propagators of a given type
+  */
+  class PropagatorProfile {
+
+  public:
+
+    PropagatorProfile(const std::string& n="") 
+      : name(n), num_propagators(0), num_calls(0), num_prunings(0), num_failures(0), num_cycles(0) {}
+
+    std::string name;
+    unsigned long int num_propagators;
+    unsigned long int num_calls;
+    unsigned long int num_prunings;
+    unsigned long int num_failures;
+    unsigned long long int num_cycles;
+  };
+
+
   class SolverStatistics {
   
   public:
@@ -165,6 +197,12 @@ namespace Mistral {
     unsigned long int num_solutions;
     /// Number of inference steps
     unsigned long int num_filterings;
+    /// Number of calls to the propagators of each cost class
+    unsigned long int num_class_propagations[NUM_COST_CLASSES];
+    /// Number of domain events triggered by the propagators of each cost class
+    unsigned long int num_class_prunings[NUM_COST_CLASSES];
+    /// Number of failures of the propagators of each cost class
+    unsigned long int num_class_failures[NUM_COST_CLASSES];
     /// Search outcome
     Outcome outcome;
     /// Objective value (ub for minimization, lb for maximization, -1 otherwise)
@@ -227,6 +265,8 @@ namespace Mistral {
 
     double total_restore_time;
 
+    double class_propag_time[NUM_COST_CLASSES];
+
     //int vartype_index[17];
 
 #ifdef _PROFILING_PRIMITIVE
@@ -241,10 +281,15 @@ namespace Mistral {
 
 
 
+    /// Aggregates the profile of the propagators by type, most expensive first
+    /// (the counters are recorded only if parameters.profiling is set)
+    void get_propagator_profile(std::vector< PropagatorProfile >& profile) const;
+
     //virtual std::string getString() const;
     virtual std::ostream& display(std::ostream&) const ;
     virtual std::ostream& print_full(std::ostream&) const ;
     virtual std::ostream& print_short(std::ostream&) const ;
+    virtual std::ostream& print_propagator_profile(std::ostream&) const ;
   };
   
 
@@ -561,6 +606,7 @@ namespace Mistral {
 
     void parse_dimacs(const char* filename);
     void parse_pbo(const char* filename);
+    void parse_xcsp(const char* filename);
 
     void set_parameters(SolverParameters& p);
 
@@ -685,6 +731,8 @@ namespace Mistral {
     void fail();
 
     void parity_processing(const int k=1);
+    /// adds a Gauss-Jordan propagator for the parity constraints over Boolean variables
+    void gaussian_elimination();
     bool simple_rewrite();
     bool rewrite(); 
     bool is_pseudo_boolean() const; 
@@ -820,6 +868,7 @@ namespace Mistral {
     void initialise_random_seed(const int seed);
     void set_time_limit(const double limit);
     void set_learning_on();
+    void set_lazy_generation_on();
     void close_propagation();
 
 
@@ -856,6 +905,7 @@ namespace Mistral {
     TCLAP::ValueArg<double>      *forgetArg;
     TCLAP::ValueArg<double>      *incrementArg;
     TCLAP::SwitchArg             *learningArg;
+    TCLAP::SwitchArg             *lcgArg;
     TCLAP::ValueArg<std::string> *branchingArg;
     TCLAP::ValueArg<std::string> *orderingArg;
     TCLAP::SwitchArg             *printsolArg;
@@ -863,6 +913,7 @@ namespace Mistral {
     TCLAP::SwitchArg             *printmodArg;
     TCLAP::SwitchArg             *printinsArg;
     TCLAP::SwitchArg             *printstaArg;
+    TCLAP::SwitchArg             *profileArg;
     //TCLAP::ValueArg<std::string> *commentArg;
     TCLAP::ValueArg<std::string> *pcommentArg;
     TCLAP::ValueArg<std::string> *pstatArg;
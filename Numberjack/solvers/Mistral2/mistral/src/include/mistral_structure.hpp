@@ -1384,6 +1384,13 @@ template < int N, class T >
 	data[i] = ps[i];
     }
 
+    Array(const DATA_TYPE* ps, const unsigned int n) 
+    {
+      size = n;
+      for (unsigned int i=0; i<n; ++i) 
+	data[i] = ps[i];
+    }
+
     virtual ~Array() {}
 
     // virtual Explanation::iterator begin(Atom a) { return &(data[0]); }
@@ -3960,6 +3967,50 @@ template < int N, class T >
   };
 
 
+  /**********************************************
+   * Bulk operations on arrays of words
+   **********************************************/
+
+#define BITSET_PORTABLE 0
+#define BITSET_SSE42    1
+#define BITSET_AVX2     2
+
+  /// The bulk operations of a Bitset use the kernels from this number of bytes
+#define BITSET_KERNEL_BYTES 64
+
+  /*! \class BitsetKernels
+    \brief Word-parallel loops used by the bulk operations of large Bitsets
+
+    The arrays are sequences of n 32 bits units (whatever the word type of 
+    the Bitset). The implementation is selected at runtime, depending on 
+    the instruction sets supported by the processor (AVX2, SSE4.2 and popcnt,
+    or portable C++).
+  */
+  struct BitsetKernels {
+    /// a &= b
+    void (*and_with)(unsigned int *a, const unsigned int *b, const int n);
+    /// a |= b
+    void (*or_with)(unsigned int *a, const unsigned int *b, const int n);
+    /// a &= ~b
+    void (*andnot_with)(unsigned int *a, const unsigned int *b, const int n);
+    /// |a|
+    unsigned int (*count)(const unsigned int *a, const int n);
+    /// |a & b|
+    unsigned int (*and_count)(const unsigned int *a, const unsigned int *b, const int n);
+    /// (a & b) != 0
+    bool (*intersect)(const unsigned int *a, const unsigned int *b, const int n);
+    /// (a & b) == b
+    bool (*includes)(const unsigned int *a, const unsigned int *b, const int n);
+    /// BITSET_PORTABLE, BITSET_SSE42 or BITSET_AVX2
+    int level;
+  };
+
+  extern BitsetKernels bitset_kernels;
+
+  /// Uses the best implementation supported by the processor, up to 'level', and returns its level
+  int set_bitset_kernels(const int level=BITSET_AVX2);
+
+
   /**********************************************
    * BitSet
    **********************************************/
@@ -4545,7 +4596,9 @@ template < int N, class T >
     {
       int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
       int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
-      while( i-- > j )
+      if( (i-j)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) 
+	bitset_kernels.or_with((unsigned int*)(table+j), (const unsigned int*)(s.table+j), (i-j)*size_word_byte/4);
+      else while( i-- > j )
 	table[i] |= s.table[i];
     }
 
@@ -4564,11 +4617,15 @@ template < int N, class T >
       int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
       int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
       int k = pos_words;
+      if( i < j ) i = j; // s is disjoint from this set (and may lie below it)
       while( k > i ) {
 	--k;
 	table[k] = empt;
       }
-      while( k > j ) {
+      if( (k-j)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) {
+	bitset_kernels.and_with((unsigned int*)(table+j), (const unsigned int*)(s.table+j), (k-j)*size_word_byte/4);
+	k = j;
+      } else while( k > j ) {
 	--k;
 	table[k] &= s.table[k];
       }
@@ -4594,7 +4651,9 @@ template < int N, class T >
     {
       int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
       int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
-      while( i-- > j )
+      if( (i-j)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) 
+	bitset_kernels.andnot_with((unsigned int*)(table+j), (const unsigned int*)(s.table+j), (i-j)*size_word_byte/4);
+      else while( i-- > j )
 	table[i] &= (~(s.table[i]));
     }
 
@@ -4686,6 +4745,7 @@ template < int N, class T >
       int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
       int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
       int k = pos_words;
+      if( i < j ) i = j; // s is disjoint from this set (and may lie below it)
       while( k > i ) {
 	--k;
 	if( table[k] ) return false;
@@ -4704,11 +4764,16 @@ template < int N, class T >
       int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
       int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
       int k = s.pos_words;
+      if( i < j ) i = j; // s is disjoint from this set (and may lie below it)
       while( k > i ) {
 	--k;
 	if( s.table[k] ) return false;
       }
-      while( k > j ) {
+      if( (k-j)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) {
+	if( !bitset_kernels.includes((const unsigned int*)(table+j), (const unsigned int*)(s.table+j), (k-j)*size_word_byte/4) ) 
+	  return false;
+	k = j;
+      } else while( k > j ) {
 	--k;
 	if( s.table[k] != (table[k] & s.table[k]) ) {
 	  return false;
@@ -4787,7 +4852,7 @@ template < int N, class T >
      */
     inline unsigned int word_size(WORD_TYPE v) const 
     {
-      return __builtin_popcount(v);
+      return (sizeof(WORD_TYPE) > 4 ? __builtin_popcountll(v) : __builtin_popcount(v));
       /*
       v = v - ((v >> 1) & (WORD_TYPE)~(WORD_TYPE)0/3);                           // temp
       v = (v & (WORD_TYPE)~(WORD_TYPE)0/15*3) + ((v >> 2) & (WORD_TYPE)~(WORD_TYPE)0/15*3);      // temp
@@ -4801,15 +4866,33 @@ template < int N, class T >
       int i=pos_words;
       unsigned int c=0;
       WORD_TYPE v;
+      if( (pos_words-neg_words)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) 
+	return bitset_kernels.count((const unsigned int*)(table+neg_words), (pos_words-neg_words)*size_word_byte/4);
       while( i-- > neg_words ) 
 	if( (v = table[i]) ) 
 	  c += word_size(v);
       return c;  
     }
 
+    /// Returns the number of elements that belong to both sets
+    inline unsigned int intersection_size(const Bitset<WORD_TYPE,FLOAT_TYPE>& s) const 
+    {  
+      int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
+      int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
+      unsigned int c=0;
+      WORD_TYPE v;
+      if( (i-j)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) 
+	return bitset_kernels.and_count((const unsigned int*)(table+j), (const unsigned int*)(s.table+j), (i-j)*size_word_byte/4);
+      while( i-- > j ) 
+	if( (v = (table[i] & s.table[i])) ) 
+	  c += word_size(v);
+      return c;  
+    }
+
     inline unsigned int word_size() const 
     {  
-      unsigned int v, c=0;
+      WORD_TYPE v;
+      unsigned int c=0;
       if( (v = table[neg_words]) ) 
 	c = word_size(v);
       return c;  
@@ -4907,6 +4990,8 @@ template < int N, class T >
     {
       int i = (pos_words > s.pos_words ? s.pos_words : pos_words);
       int j = (neg_words < s.neg_words ? s.neg_words : neg_words);
+      if( (i-j)*(int)size_word_byte >= BITSET_KERNEL_BYTES ) 
+	return bitset_kernels.intersect((const unsigned int*)(table+j), (const unsigned int*)(s.table+j), (i-j)*size_word_byte/4);
       while( i-- > j )
 	if(table[i] & s.table[i]) return true;
       return false;
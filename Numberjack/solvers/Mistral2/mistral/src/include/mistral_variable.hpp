@@ -714,14 +714,16 @@ namespace Mistral {
     inline Event set_domain(const BitSet& s) {
       Event intersection = DOMAIN_EVENT;
 
-      if( !domain.values.intersect(s) ) return FAIL_EVENT;
-      if( domain.values.included(s) ) return NO_EVENT;
+      // a single (word-parallel) pass tells both if the domain is wiped out and if it is included in s
+      unsigned int common = domain.values.intersection_size(s);
+      if( !common ) return FAIL_EVENT;
+      if( common == domain.size ) return NO_EVENT;
 
       save();
 
       // then change the static domain
       domain.values.intersect_with(s);
-      domain.size = domain.values.size();
+      domain.size = common;
       if(!s.contain(domain.min)) { intersection |= LB_EVENT; domain.min = domain.values.next(domain.min); }
       if(!s.contain(domain.max)) { intersection |= UB_EVENT; domain.max = domain.values.prev(domain.max); }
       if(domain.min == domain.max) intersection |= VALUE_EVENT;
@@ -767,31 +769,23 @@ namespace Mistral {
 
     /// Remove all values that belong to the set "s"
     inline Event remove_set(const BitSet& s) {
-      Event setdifference = NO_EVENT;
+      Event setdifference = DOMAIN_EVENT;
 
-      //       if(type != VIRTUAL_VAR) {
-      // 	// first check if we can abort early
-      // 	if(domain.values.table) {
-      // 	  if( !domain.values.intersect(s) ) return NO_EVENT;
-      // 	  if( domain.values.included(s) ) return FAIL_EVENT;
+      unsigned int common = domain.values.intersection_size(s);
+      if( !common ) return NO_EVENT;
+      if( common == domain.size ) return FAIL_EVENT;
 
-      // 	  _save_();
+      save();
 	  
-      // 	  // then change the static domain
-      // 	  setdifference = DOMAIN_EVENT;
-      // 	  domain.values.setminus_with(s);
-      // 	  domain.size = domain.values.size();
-      // 	  if(s.contain(domain.min)) { setdifference |= LB_EVENT; domain.min = domain.values.next(domain.min); }
-      // 	  if(s.contain(domain.max)) { setdifference |= UB_EVENT; domain.max = domain.values.prev(domain.max); }
-      // 	  if(domain.min == domain.max) setdifference |= VALUE_EVENT;
-      // 	} else {
-      // 	  std::cerr << "not supported" << std::endl;
-      // 	  exit(0);
-      // 	}
-      //       } 
-
-      //       trigger_event(setdifference);
-      return setdifference; // do nothing more for BOOL or CONSTANT or BITSET or RANGE
+      // then change the static domain
+      domain.values.setminus_with(s);
+      domain.size -= common;
+      if(s.contain(domain.min)) { setdifference |= LB_EVENT; domain.min = domain.values.next(domain.min); }
+      if(s.contain(domain.max)) { setdifference |= UB_EVENT; domain.max = domain.values.prev(domain.max); }
+      if(domain.min == domain.max) setdifference |= VALUE_EVENT;
+
+      solver->trigger_event(id, setdifference);
+      return setdifference; 
     }
 
     /// Remove all values in the interval [l..u]
@@ -2729,6 +2723,74 @@ namespace Mistral {
   Variable ReifiedDisjunctive(Variable X, Variable Y, const int px, const int py);
   
 
+  class UnaryResourceExpression : public Expression {
+
+  public:
+
+    Vector< int > processing_time;
+
+    UnaryResourceExpression(Vector< Variable >& args, Vector< int >& p);
+    
+    virtual ~UnaryResourceExpression();
+
+    virtual void extract_constraint(Solver*);
+    virtual void extract_variable(Solver*);
+    virtual void extract_predicate(Solver*);
+    virtual const char* get_name() const;
+
+  };
+
+  Variable UnaryResource(Vector< Variable >& args, Vector< int >& p);
+  
+
+  class CumulativeExpression : public Expression {
+
+  public:
+
+    Vector< int > processing_time;
+    Vector< int > demand;
+    int capacity;
+    bool energetic;
+
+    CumulativeExpression(Vector< Variable >& args, Vector< int >& p, Vector< int >& d, const int c, const bool e);
+    
+    virtual ~CumulativeExpression();
+
+    virtual void extract_constraint(Solver*);
+    virtual void extract_variable(Solver*);
+    virtual void extract_predicate(Solver*);
+    virtual const char* get_name() const;
+
+  };
+
+  Variable Cumulative(Vector< Variable >& args, Vector< int >& p, Vector< int >& d, const int c, const bool e=true);
+
+
+  class CircuitExpression : public Expression {
+
+  public:
+
+    // weights of the arcs (row-major), if not empty the last child is the cost of the circuit
+    Vector< int > weight;
+
+    CircuitExpression(Vector< Variable >& args);
+    CircuitExpression(Vector< Variable >& args, Vector< int >& w, Variable cost);
+    
+    virtual ~CircuitExpression();
+
+    virtual void extract_constraint(Solver*);
+    virtual void extract_variable(Solver*);
+    virtual void extract_predicate(Solver*);
+    virtual const char* get_name() const;
+
+  };
+
+  // args[i] is the successor of node i in a Hamiltonian circuit
+  Variable Circuit(Vector< Variable >& args);
+  // idem, and cost is the sum of the weights w[i*n+args[i]] 
+  Variable Circuit(Vector< Variable >& args, Vector< int >& w, Variable cost);
+  
+
   class FreeExpression : public Expression {
 
   public:
@@ -2927,6 +2989,8 @@ namespace Mistral {
       GAC3,
       AC3,
       GAC4,
+      CT,
+      MDD4R,
       Dynamic
     };
 
@@ -2956,6 +3020,31 @@ namespace Mistral {
   //Variable Table(VarArray& args, const TableExpression::AlgorithmType ct=TableExpression::Dynamic);
 
 
+  class MDDExpression : public Expression {
+
+  public:
+
+    // automaton: transitions are triplets (state, value, next state)
+    int initial_state;
+    Vector< int > transitions;
+    Vector< int > final_states;
+
+    MDDExpression(Vector< Variable >& args, const int init, Vector< int >& trans, Vector< int >& finals);
+    virtual ~MDDExpression();
+
+    virtual void extract_constraint(Solver*);
+    virtual void extract_variable(Solver*);
+    virtual void extract_predicate(Solver*);
+    virtual const char* get_name() const;
+
+  };
+
+  // the sequence of values of args is a word accepted by the automaton
+  Variable Regular(Vector< Variable >& args, const int init, Vector< int >& trans, Vector< int >& finals);
+  // edges are triplets (node, value, child) of a layered graph rooted in node 0, whose terminals are the nodes without children 
+  Variable MDD(Vector< Variable >& args, Vector< int >& edges);
+
+
 
   class LexExpression : public Expression {
 
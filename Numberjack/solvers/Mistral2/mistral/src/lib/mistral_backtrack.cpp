@@ -121,7 +121,7 @@ void Mistral::Constraint::initialise(Solver *s) {
 }
 
 int Mistral::Constraint::priority() const {
-  return (global() ? ((GlobalConstraint*)propagator)->priority : 2);
+  return (global() ? ((GlobalConstraint*)propagator)->priority : BINARY_COST);
 }
 
 void Mistral::Constraint::post(Solver* solver) { 
@@ -170,7 +170,7 @@ int Mistral::Constraint::num_active() const {
   if(binary()) 
     n = size_byte[((BinaryConstraint*)propagator)->active]; 
   else if(ternary())
-    n = size_byte[((TernaryConstraint*)propagator)->active]; 
+    n = size_byte[((TernaryConstraint*)propagator)->active&7]; 
   else
     n = ((GlobalConstraint*)propagator)->active.size; 
   return n;
@@ -19,6 +19,8 @@
 */
 
 #include <cmath>
+#include <map>
+#include <algorithm>
 
 #include <mistral_sat.hpp>
 #include <mistral_solver.hpp>
@@ -147,6 +149,10 @@ Mistral::ConstraintImplementation::ConstraintImplementation() {
   self = NULL;
   index = NULL;
   enforce_nfc1 = true;
+  num_calls = 0;
+  num_prunings = 0;
+  num_failures = 0;
+  num_cycles = 0;
 }
 
 // Mistral::ConstraintImplementation::ConstraintImplementation(const int a) {
@@ -336,6 +342,12 @@ void Mistral::ConstraintImplementation::set_scope(const int i, Variable x) {
   // on.add(&(get_solver()->constraint_graph[x.id()].on[t]));
 }
 
+void Mistral::ConstraintImplementation::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+						      const int upper, const int v) {
+  // the pruning was made with the current domains, which are intervals when explanations are computed
+  for(unsigned int i=0; i<_scope.size; ++i) lcg->add_bounds(_scope[i]);
+}
+
 int Mistral::Trigger::post(Constraint ct) {
   add(ct);
   return size-1;
@@ -884,13 +896,23 @@ void Mistral::GlobalConstraint::trigger()  { get_solver()->active_constraints.tr
 
 
 Mistral::GlobalConstraint::GlobalConstraint(Vector< Variable > scp) {
+  priority = LINEAR_COST;
   for(unsigned int i=0; i<scp.size; ++i) scope.add(scp[i]);
+  // a constraint may be deleted before being initialised
+  event_type = NULL;
+  solution = NULL;
 }
 Mistral::GlobalConstraint::GlobalConstraint(std::vector< Variable > scp) {
+  priority = LINEAR_COST;
   for(std::vector< Variable >::iterator vi=scp.begin(); vi!=scp.end(); ++vi) scope.add(*vi);
+  event_type = NULL;
+  solution = NULL;
 }
 Mistral::GlobalConstraint::GlobalConstraint(Variable* scp, const int n) {
+  priority = LINEAR_COST;
   for(int i=0; i<n; ++i) scope.add(scp[i]);
+  event_type = NULL;
+  solution = NULL;
 }
 
 int Mistral::GlobalConstraint::get_backtrack_level() {
@@ -2051,6 +2073,25 @@ Mistral::PropagationOutcome Mistral::ConstraintLess::propagate(const int changed
   return wiped;
 }
 
+void Mistral::ConstraintLess::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+					    const int upper, const int v) {
+  if(x < 0) {
+    // x0 + offset > max(x1)
+    int lb = lcg->get_lb(scope[0]);
+    lcg->add_lb(scope[0], lb);
+    lcg->add_ub(scope[1], lb+offset-1);
+  } else if(upper && x == scope[0].id()) {
+    lcg->add_ub(scope[1], v+offset);
+  } else if(!upper && x == scope[1].id()) {
+    lcg->add_lb(scope[0], v-offset);
+  } else {
+    ConstraintImplementation::explain_bound(lcg, x, upper, v);
+  }
+
+  // a precedence posted by a disjunction only holds because the other one is violated
+  if(owner) owner->explain_choice(lcg, (owner->precedence[1].propagator == this));
+}
+
 std::ostream& Mistral::ConstraintLess::display(std::ostream& os) const {
   os << scope[0]/*.get_var()*/;
   if(offset < 0) os << " - " << (-offset+1) << " < ";
@@ -2084,8 +2125,12 @@ Mistral::ConstraintDisjunctive::ConstraintDisjunctive(std::vector< Variable >& s
 
 void Mistral::ConstraintDisjunctive::initialise() {
   
-  precedence[0] = new ConstraintLess(scope[0], scope[1], processing_time[0]);
-  precedence[1] = new ConstraintLess(scope[1], scope[0], processing_time[1]);
+  ConstraintLess *prec;
+  for(int i=0; i<2; ++i) {
+    prec = new ConstraintLess(scope[i], scope[1-i], processing_time[i]);
+    prec->owner = this;
+    precedence[i] = prec;
+  }
 
   ConstraintImplementation::initialise();
   trigger_on(_RANGE_, scope[0]);
@@ -2197,6 +2242,24 @@ void Mistral::ConstraintDisjunctive::consolidate() {
   }
 }
 
+void Mistral::ConstraintDisjunctive::explain_choice(ConstraintLazyClauseBase *lcg, const int choice) {
+  // min(x_other) + p_other > max(x_choice)
+  int other = 1-choice, lb = lcg->get_lb(scope[other]);
+  lcg->add_lb(scope[other], lb);
+  lcg->add_ub(scope[choice], lb+processing_time[other]-1);
+}
+
+void Mistral::ConstraintDisjunctive::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+						   const int upper, const int v) {
+  // the disjunction only fails, the pruning is made by the precedences
+  if(x < 0) {
+    explain_choice(lcg, 0);
+    explain_choice(lcg, 1);
+  } else {
+    ConstraintImplementation::explain_bound(lcg, x, upper, v);
+  }
+}
+
 std::ostream& Mistral::ConstraintDisjunctive::display(std::ostream& os) const {
   os << precedence[0] << " or " 
      << precedence[1] ;
@@ -2451,6 +2514,546 @@ std::ostream& Mistral::ConstraintReifiedDisjunctive::display(std::ostream& os) c
 }
 
 
+Mistral::ConstraintUnaryResource::ConstraintUnaryResource(Vector< Variable >& scp, Vector< int >& p)
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST; 
+  processing_time = p;
+  // bounds reasoning only: the last unassigned task is not filtered
+  enforce_nfc1 = false;
+}
+
+void Mistral::ConstraintUnaryResource::initialise() {
+  ConstraintImplementation::initialise();
+  for(unsigned int i=0; i<scope.size; ++i) {
+    trigger_on(_RANGE_, scope[i]);
+  }
+  GlobalConstraint::initialise();
+
+  int n = scope.size;
+  leaf_offset = 1;
+  while(leaf_offset < n) leaf_offset *= 2;
+  sum_p = new int[2*leaf_offset];
+  ect = new int[2*leaf_offset];
+  sum_p_gray = new int[2*leaf_offset];
+  ect_gray = new int[2*leaf_offset];
+  resp_p_gray = new int[2*leaf_offset];
+  resp_ect_gray = new int[2*leaf_offset];
+  leaf = new int[n];
+
+  est = new int[n];
+  lct = new int[n];
+  lst = new int[n];
+  ect_task = new int[n];
+  new_est = new int[n];
+  new_lct = new int[n];
+  by_est = new int[n];
+  by_lct = new int[n];
+  by_lst = new int[n];
+  by_ect = new int[n];
+}
+
+void Mistral::ConstraintUnaryResource::mark_domain() {
+  for(unsigned int i=0; i<scope.size; ++i) {
+    get_solver()->forbid(scope[i].id(), LIST_VAR);
+  }
+}
+
+Mistral::ConstraintUnaryResource::~ConstraintUnaryResource() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete unary resource constraint" << std::endl;
+#endif
+  delete [] sum_p;
+  delete [] ect;
+  delete [] sum_p_gray;
+  delete [] ect_gray;
+  delete [] resp_p_gray;
+  delete [] resp_ect_gray;
+  delete [] leaf;
+  delete [] est;
+  delete [] lct;
+  delete [] lst;
+  delete [] ect_task;
+  delete [] new_est;
+  delete [] new_lct;
+  delete [] by_est;
+  delete [] by_lct;
+  delete [] by_lst;
+  delete [] by_ect;
+}
+
+static int *task_key;
+static int increasing_key(const void *x, const void *y) {
+  int _x = task_key[*(int*)x];
+  int _y = task_key[*(int*)y];
+  return (_x < _y ? -1 : (_x > _y ? 1 : (*(int*)x - *(int*)y)));
+}
+
+static void sort_tasks(int *order, int *key, const int n) {
+  for(int i=0; i<n; ++i) order[i] = i;
+  task_key = key;
+  qsort(order, n, sizeof(int), increasing_key);
+}
+
+#define NO_ECT (MININT/2)
+
+void Mistral::ConstraintUnaryResource::clear_tree() {
+  std::fill(sum_p, sum_p+2*leaf_offset, 0);
+  std::fill(ect, ect+2*leaf_offset, NO_ECT);
+  std::fill(sum_p_gray, sum_p_gray+2*leaf_offset, 0);
+  std::fill(ect_gray, ect_gray+2*leaf_offset, NO_ECT);
+  std::fill(resp_p_gray, resp_p_gray+2*leaf_offset, -1);
+  std::fill(resp_ect_gray, resp_ect_gray+2*leaf_offset, -1);
+}
+
+void Mistral::ConstraintUnaryResource::update_tree(int k) {
+  int l, r, a, b, c;
+  while(k > 1) {
+    k /= 2;
+    l = 2*k;
+    r = l+1;
+
+    sum_p[k] = sum_p[l] + sum_p[r];
+    ect[k] = std::max(ect[r], ect[l] + sum_p[r]);
+
+    // at most one gray task
+    a = sum_p_gray[l] + sum_p[r];
+    b = sum_p[l] + sum_p_gray[r];
+    if(a > b) {
+      sum_p_gray[k] = a;
+      resp_p_gray[k] = resp_p_gray[l];
+    } else {
+      sum_p_gray[k] = b;
+      resp_p_gray[k] = resp_p_gray[r];
+    }
+
+    a = ect_gray[r];
+    b = ect[l] + sum_p_gray[r];
+    c = ect_gray[l] + sum_p[r];
+    if(a >= b && a >= c) {
+      ect_gray[k] = a;
+      resp_ect_gray[k] = resp_ect_gray[r];
+    } else if(b >= c) {
+      ect_gray[k] = b;
+      resp_ect_gray[k] = resp_p_gray[r];
+    } else {
+      ect_gray[k] = c;
+      resp_ect_gray[k] = resp_ect_gray[l];
+    }
+  }
+}
+
+void Mistral::ConstraintUnaryResource::insert_task(const int i) {
+  int k = leaf[i];
+  sum_p[k] = sum_p_gray[k] = processing_time[i];
+  ect[k] = ect_gray[k] = ect_task[i];
+  resp_p_gray[k] = resp_ect_gray[k] = -1;
+  update_tree(k);
+}
+
+void Mistral::ConstraintUnaryResource::gray_task(const int i) {
+  int k = leaf[i];
+  sum_p[k] = 0;
+  ect[k] = NO_ECT;
+  sum_p_gray[k] = processing_time[i];
+  ect_gray[k] = ect_task[i];
+  resp_p_gray[k] = resp_ect_gray[k] = i;
+  update_tree(k);
+}
+
+void Mistral::ConstraintUnaryResource::remove_task(const int i) {
+  int k = leaf[i];
+  sum_p[k] = sum_p_gray[k] = 0;
+  ect[k] = ect_gray[k] = NO_ECT;
+  resp_p_gray[k] = resp_ect_gray[k] = -1;
+  update_tree(k);
+}
+
+bool Mistral::ConstraintUnaryResource::edge_finding() {
+  int i, j, q, n = scope.size;
+
+  clear_tree();
+  for(i=0; i<n; ++i) insert_task(i);
+
+  // overload checking and edge finding: Theta is the set of tasks ending 
+  // before lct_j, the gray tasks are those that were removed from it 
+  if(ect[1] > lct[by_lct[n-1]]) return false;
+  for(q=n-1; q>0; --q) {
+    gray_task(by_lct[q]);
+    j = by_lct[q-1];
+    if(ect[1] > lct[j]) return false;
+    while(ect_gray[1] > lct[j]) {
+      // the responsible gray task must come after all of Theta
+      i = resp_ect_gray[1];
+      if(new_est[i] < ect[1]) new_est[i] = ect[1];
+      remove_task(i);
+    }
+  }
+  return true;
+}
+
+void Mistral::ConstraintUnaryResource::detectable_precedences() {
+  int i, k, q = 0, e, n = scope.size;
+  
+  clear_tree();
+  for(k=0; k<n; ++k) {
+    i = by_ect[k];
+    // the tasks j such that ect_i > lst_j must precede i
+    while(q < n && ect_task[i] > lst[by_lst[q]]) {
+      insert_task(by_lst[q]);
+      ++q;
+    }
+    if(ect[leaf[i]] != NO_ECT) {
+      remove_task(i);
+      e = ect[1];
+      insert_task(i);
+    } else e = ect[1];
+    if(new_est[i] < e) new_est[i] = e;
+  }
+}
+
+void Mistral::ConstraintUnaryResource::not_last() {
+  int i, j, k, q = 0, e, last = -1, previous = -1, n = scope.size;
+
+  clear_tree();
+  for(k=0; k<n; ++k) {
+    i = by_lct[k];
+    while(q < n && lct[i] > lst[by_lst[q]]) {
+      j = by_lst[q];
+      insert_task(j);
+      previous = last;
+      last = j;
+      ++q;
+    }
+    if(ect[leaf[i]] != NO_ECT) {
+      remove_task(i);
+      e = ect[1];
+      insert_task(i);
+    } else e = ect[1];
+    // i cannot be the last of Theta, it ends before the latest start time of the others
+    if(e > lst[i]) {
+      j = (last == i ? previous : last);
+      if(new_lct[i] > lst[j]) new_lct[i] = lst[j];
+    }
+  }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintUnaryResource::propagate() 
+{
+  int i, p, view, n = scope.size;
+  bool fix_point;
+  Event evt;
+
+  do {
+    fix_point = true;
+    for(view=0; view<2; ++view) {
+      // in the mirrored view (view==1), time goes backward
+      for(i=0; i<n; ++i) {
+	p = processing_time[i];
+	if(view) {
+	  est[i] = -scope[i].get_max()-p;
+	  lct[i] = -scope[i].get_min();
+	} else {
+	  est[i] = scope[i].get_min();
+	  lct[i] = scope[i].get_max()+p;
+	}
+	lst[i] = lct[i]-p;
+	ect_task[i] = est[i]+p;
+	new_est[i] = est[i];
+	new_lct[i] = lct[i];
+      }
+      sort_tasks(by_est, est, n);
+      sort_tasks(by_lct, lct, n);
+      sort_tasks(by_lst, lst, n);
+      sort_tasks(by_ect, ect_task, n);
+      for(i=0; i<n; ++i) leaf[by_est[i]] = leaf_offset+i;
+
+      if(!edge_finding()) return FAILURE(0);
+      detectable_precedences();
+      not_last();
+
+      for(i=0; i<n; ++i) {
+	p = processing_time[i];
+	if(new_est[i] > est[i]) {
+	  evt = (view ? scope[i].set_max(-new_est[i]-p) : scope[i].set_min(new_est[i]));
+	  if(FAILED(evt)) return FAILURE(i);
+	  fix_point = false;
+	}
+	if(new_lct[i] < lct[i]) {
+	  evt = (view ? scope[i].set_min(-new_lct[i]) : scope[i].set_max(new_lct[i]-p));
+	  if(FAILED(evt)) return FAILURE(i);
+	  fix_point = false;
+	}
+      }
+    }
+  } while(!fix_point);
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintUnaryResource::check( const int* s ) const 
+{
+  int i, j, n = scope.size;
+  for(i=1; i<n; ++i) 
+    for(j=0; j<i; ++j) 
+      if(s[i]+processing_time[i] > s[j] && s[j]+processing_time[j] > s[i]) return 1;
+  return 0;
+}
+
+std::ostream& Mistral::ConstraintUnaryResource::display(std::ostream& os) const {
+  os << "unary(" << scope[0] << ":" << processing_time[0];
+  for(unsigned int i=1; i<scope.size; ++i) 
+    os << ", " << scope[i] << ":" << processing_time[i];
+  os << ")";
+  return os;
+}
+
+
+Mistral::ConstraintCumulative::ConstraintCumulative(Vector< Variable >& scp, Vector< int >& p, 
+						    Vector< int >& d, const int c, const bool e)
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST; 
+  processing_time = p;
+  demand = d;
+  capacity = c;
+  energetic = e;
+  enforce_nfc1 = false;
+}
+
+void Mistral::ConstraintCumulative::initialise() {
+  ConstraintImplementation::initialise();
+  for(unsigned int i=0; i<scope.size; ++i) {
+    trigger_on(_RANGE_, scope[i]);
+  }
+  GlobalConstraint::initialise();
+
+  int n = scope.size;
+  event_time = new int[2*n];
+  event_order = new int[2*n];
+  est = new int[n];
+  lct = new int[n];
+  by_est = new int[n];
+  by_lct = new int[n];
+  leaf = new int[n];
+
+  leaf_offset = 1;
+  while(leaf_offset < n) leaf_offset *= 2;
+  energy = new long long int[2*leaf_offset];
+  envelope = new long long int[2*leaf_offset];
+}
+
+void Mistral::ConstraintCumulative::mark_domain() {
+  for(unsigned int i=0; i<scope.size; ++i) {
+    get_solver()->forbid(scope[i].id(), LIST_VAR);
+  }
+}
+
+Mistral::ConstraintCumulative::~ConstraintCumulative() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete cumulative constraint" << std::endl;
+#endif
+  delete [] event_time;
+  delete [] event_order;
+  delete [] est;
+  delete [] lct;
+  delete [] by_est;
+  delete [] by_lct;
+  delete [] leaf;
+  delete [] energy;
+  delete [] envelope;
+}
+
+bool Mistral::ConstraintCumulative::compute_profile() {
+  int i, k, e, t, prev = 0, height = 0, num_events = 0, n = scope.size;
+
+  for(i=0; i<n; ++i) {
+    if(demand[i] && processing_time[i] && scope[i].get_max() < scope[i].get_min()+processing_time[i]) {
+      event_time[2*i] = scope[i].get_max();
+      event_time[2*i+1] = scope[i].get_min()+processing_time[i];
+      event_order[num_events++] = 2*i;
+      event_order[num_events++] = 2*i+1;
+    }
+  }
+  task_key = event_time;
+  qsort(event_order, num_events, sizeof(int), increasing_key);
+
+  seg_start.clear();
+  seg_end.clear();
+  seg_height.clear();
+  for(k=0; k<num_events; ++k) {
+    e = event_order[k];
+    t = event_time[e];
+    if(height && t > prev) {
+      if(height > capacity) return false;
+      seg_start.add(prev);
+      seg_end.add(t);
+      seg_height.add(height);
+    }
+    height += (e&1 ? -demand[e/2] : demand[e/2]);
+    prev = t;
+  }
+  return true;
+}
+
+bool Mistral::ConstraintCumulative::overload_check() {
+  int i, k, l, r, n = scope.size;
+  long long int C = capacity;
+
+  for(i=0; i<n; ++i) {
+    est[i] = scope[i].get_min();
+    lct[i] = scope[i].get_max()+processing_time[i];
+  }
+  sort_tasks(by_est, est, n);
+  sort_tasks(by_lct, lct, n);
+  for(i=0; i<n; ++i) leaf[by_est[i]] = leaf_offset+i;
+
+  std::fill(energy, energy+2*leaf_offset, 0);
+  std::fill(envelope, envelope+2*leaf_offset, (long long int)MININT*(C+1));
+
+  // the tasks are added by increasing lct, the energy envelope of 
+  // Theta cannot go beyond C * lct
+  for(l=0; l<n; ++l) {
+    i = by_lct[l];
+    k = leaf[i];
+    energy[k] = (long long int)(processing_time[i]) * demand[i];
+    envelope[k] = C * est[i] + energy[k];
+    while(k > 1) {
+      k /= 2;
+      r = 2*k+1;
+      energy[k] = energy[2*k] + energy[r];
+      envelope[k] = std::max(envelope[r], envelope[2*k] + energy[r]);
+    }
+    if(envelope[1] > C * lct[i]) return false;
+  }
+  return true;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintCumulative::propagate() 
+{
+  int i, k, p, d, h, lo, up, new_lo, new_end, n = scope.size;
+  bool fix_point, own;
+
+  for(i=0; i<n; ++i) 
+    if(processing_time[i] && demand[i] > capacity) return FAILURE(i);
+
+  do {
+    fix_point = true;
+
+    if(energetic && !overload_check()) return FAILURE(0);
+    if(!compute_profile()) return FAILURE(0);
+
+    for(i=0; i<n; ++i) {
+      p = processing_time[i];
+      d = demand[i];
+      if(!p || !d) continue;
+
+      // the own compulsory part of i is not counted
+      lo = scope[i].get_min();
+      up = scope[i].get_max();
+      own = (up < lo+p);
+
+      // push the start time past the segments where i does not fit
+      new_lo = lo;
+      for(k=0; k<(int)(seg_start.size); ++k) {
+	if(seg_end[k] <= new_lo) continue;
+	if(seg_start[k] >= new_lo+p) break;
+	h = seg_height[k] - ((own && seg_start[k] >= up && seg_end[k] <= lo+p) ? d : 0);
+	if(h + d > capacity) new_lo = seg_end[k];
+      }
+
+      // and the end time before them
+      new_end = up+p;
+      for(k=seg_start.size; k--;) {
+	if(seg_start[k] >= new_end) continue;
+	if(seg_end[k] <= new_end-p) break;
+	h = seg_height[k] - ((own && seg_start[k] >= up && seg_end[k] <= lo+p) ? d : 0);
+	if(h + d > capacity) new_end = seg_start[k];
+      }
+
+      if(new_lo > lo) {
+	if(FAILED(scope[i].set_min(new_lo))) return FAILURE(i);
+	fix_point = false;
+      }
+      if(new_end < up+p) {
+	if(FAILED(scope[i].set_max(new_end-p))) return FAILURE(i);
+	fix_point = false;
+      }
+    }
+  } while(!fix_point);
+
+  return CONSISTENT;
+}
+
+void Mistral::ConstraintCumulative::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+						  const int upper, const int v) {
+  int i, j = -1, k, t = 0, load, n = scope.size;
+  bool found = false;
+  Vector< int > lo, up;
+
+  for(i=0; i<n; ++i) {
+    lo.add(lcg->get_lb(scope[i]));
+    up.add(lcg->get_ub(scope[i]));
+    if(x>=0 && scope[i].id() == x) j = i;
+  }
+
+  // look for a time point t where the compulsory parts of the other tasks 
+  // leave no room for j, with j overlapping t unless its bound is pruned
+  if(j < 0) {
+    for(k=0; !found && k<n; ++k) if(demand[k] && processing_time[k] && up[k] < lo[k]+processing_time[k]) {
+	t = up[k];
+	load = 0;
+	for(i=0; i<n; ++i) 
+	  if(up[i] <= t && lo[i]+processing_time[i] > t) load += demand[i];
+	found = (load > capacity);
+      }
+  } else {
+    t = (upper ? v+processing_time[j] : v-1);
+    if(upper ? up[j] <= t : lo[j] >= v-processing_time[j]) {
+      load = demand[j];
+      for(i=0; i<n; ++i) 
+	if(i != j && up[i] <= t && lo[i]+processing_time[i] > t) load += demand[i];
+      found = (load > capacity);
+    }
+  }
+
+  if(found) {
+    for(i=0; i<n; ++i) 
+      if(i != j && demand[i] && up[i] <= t && lo[i]+processing_time[i] > t) {
+	lcg->add_ub(scope[i], t);
+	lcg->add_lb(scope[i], t-processing_time[i]+1);
+      }
+    if(j >= 0) {
+      if(upper) lcg->add_ub(scope[j], t);
+      else lcg->add_lb(scope[j], v-processing_time[j]);
+    }
+  } else {
+    ConstraintImplementation::explain_bound(lcg, x, upper, v);
+  }
+}
+
+int Mistral::ConstraintCumulative::check( const int* s ) const 
+{
+  int i, j, load, n = scope.size;
+  // the load is maximal at the start of some task
+  for(i=0; i<n; ++i) {
+    load = 0;
+    for(j=0; j<n; ++j) 
+      if(s[j] <= s[i] && s[j]+processing_time[j] > s[i]) load += demand[j];
+    if(load > capacity) return 1;
+  }
+  return 0;
+}
+
+std::ostream& Mistral::ConstraintCumulative::display(std::ostream& os) const {
+  os << "cumulative(" << scope[0] << ":" << processing_time[0] << "x" << demand[0];
+  for(unsigned int i=1; i<scope.size; ++i) 
+    os << ", " << scope[i] << ":" << processing_time[i] << "x" << demand[i];
+  os << " <= " << capacity << ")";
+  return os;
+}
+
+
 void Mistral::PredicateEqual::initialise() {
     ConstraintImplementation::initialise();
 
@@ -8178,10 +8781,10 @@ std::ostream& Mistral::ConstraintGAC4::display(std::ostream& os) const {
 
 
 Mistral::ConstraintTable::ConstraintTable(Vector< Variable >& scp)
-  : GlobalConstraint(scp) { priority = 0; }
+  : GlobalConstraint(scp) { priority = QUADRATIC_COST; }
 
 Mistral::ConstraintTable::ConstraintTable(std::vector< Variable >& scp)
-  : GlobalConstraint(scp) { priority = 0; }
+  : GlobalConstraint(scp) { priority = QUADRATIC_COST; }
 
 Mistral::ConstraintTable::~ConstraintTable() 
 {
@@ -8708,88 +9311,704 @@ std::ostream& Mistral::ConstraintGAC3::display(std::ostream& os) const {
 
 
 
+Mistral::ConstraintCompactTable::ConstraintCompactTable(Vector< Variable >& scp)
+  : ConstraintTable(scp) { }
 
-// Mistral::ConstraintBoolSumEqual::ConstraintBoolSumEqual(Vector< Variable >& scp, const int t)
-//   : GlobalConstraint(scp) { 
-//   priority = 1;
-//   total = t; 
-//   lower_bound = t;
-//   upper_bound = t;
-// }
+Mistral::ConstraintCompactTable::ConstraintCompactTable(std::vector< Variable >& scp)
+  : ConstraintTable(scp) { }
 
-// void Mistral::ConstraintBoolSumEqual::initialise() {
-//   ConstraintImplementation::initialise();
-//   int _min_ = 0;
-//   int _max_ = scope.size;
+void Mistral::ConstraintCompactTable::initialise() {
+  ConstraintTable::initialise();
 
+  int arity = scope.size, i, k, m, val, vnxt;
+  unsigned int t;
 
-//   std::cout << "initialise: c" << id << " " << this << std::endl;
+  themins = new int[arity];
+  values = new Vector<int>[arity];
+  supports = new Bitset64*[arity];
+  pool = new word*[arity];
+  residue = new int*[arity];
 
+  for(i=0; i<arity; ++i) {
+    themins[i] = scope[i].get_initial_min();
+    vnxt = scope[i].get_first();
+    do {
+      val = vnxt;
+      values[i].add(val);
+      vnxt = scope[i].next(val);
+    } while( val != vnxt );
+  }
 
-//   for(unsigned int i=0; i<scope.size; ++i) {
-//     trigger_on(_VALUE_, scope[i]);
-//     if(scope[i].is_ground()) {
-//       if(scope[i].get_value()) ++_min_;
-//       else --_max_;
-//     }
-//   }
+  // only the tuples that fit in the initial domains are kept,
+  // the kth one is the kth bit of the tuple sets
+  Vector< int > valid;
+  for(t=0; t<table.size; ++t) {
+    bool ok = true;
+    for(i=0; ok && i<arity; ++i)
+      ok = scope[i].contain(table[t][i]);
+    if(ok) valid.add(t);
+  }
 
-//   min_.initialise(get_solver(), _min_);
-//   max_.initialise(get_solver(), _max_);
+  num_words = (valid.size + Bitset64::size_word_bit - 1) >> Bitset64::EXP;
+  if(!num_words) num_words = 1;
 
-//   GlobalConstraint::initialise();
-// }
+  current.initialise(0, num_words*Bitset64::size_word_bit-1, Bitset64::empt);
+  for(t=0; t<valid.size; ++t)
+    current.fast_add(t);
 
-// void Mistral::ConstraintBoolSumEqual::mark_domain() {
-//   for(int i=scope.size; i;)
-//     get_solver()->forbid(scope[--i].id(), LIST_VAR);
-// }
+  mask = new word[num_words];
+  stamp = new int[num_words];
+  nonzero = new int[num_words];
+  std::fill(stamp, stamp+num_words, -1);
 
-// Mistral::ConstraintBoolSumEqual::~ConstraintBoolSumEqual() 
-// {
-// #ifdef _DEBUG_MEMORY
-//   std::cout << "c delete boolsumequal constraint" << std::endl;
-// #endif
-// }
+  k = 0;
+  for(i=0; i<num_words; ++i) {
+    if(current.table[i]) nonzero[k++] = i;
+  }
+  for(i=0; i<num_words; ++i) {
+    if(!current.table[i]) nonzero[k++] = i;
+  }
+  limit.initialise(solver, (valid.size ? (valid.size + Bitset64::size_word_bit - 1) >> Bitset64::EXP : 0));
+  trail_size.initialise(solver, 0);
 
-// Mistral::PropagationOutcome Mistral::ConstraintBoolSumEqual::propagate() 
-// {
-//   PropagationOutcome wiped_idx = CONSISTENT;
+  for(i=0; i<arity; ++i) {
+    m = scope[i].get_initial_max() - themins[i] + 1;
 
-// #ifdef _DEBUG_CARD
-//   if(_DEBUG_CARD) {
-//     std::cout << "c" << id << ":\n";
-//     std::cout << "changes: " << changes << std::endl;
-//     std::cout << " events: " << events << std::endl;
-    
-//     int new_evt[scope.size];
-//     for(int i=0; i<scope.size; ++i) {
-//       new_evt[i]=0;
-//     }
-//     for(int i=0; i<events.size; ++i) {
-//       new_evt[events[i]] = 1;
-//     }
-//     std::cout << " propagate [" ;
-//     for(int i=0; i<scope.size; ++i) {
-//       std::cout << std::setw(5) << scope[i].get_domain();
-//     }
-//     std::cout << "]\n   changes [" ;
-//     for(int i=0; i<scope.size; ++i) {
-//       std::cout << std::setw(5) << (new_evt[i] ? scope[i].get_domain() : " ");
-//     }
-//     std::cout << "]\n was in [" << min_ << ".." << max_ << "] now in [";
-//   }
-// #endif
+    supports[i] = new Bitset64[m];
+    supports[i] -= themins[i];
+    residue[i] = new int[m];
+    std::fill(residue[i], residue[i]+m, 0);
+    residue[i] -= themins[i];
 
+    pool[i] = new word[values[i].size * num_words];
+    for(k=0; k<(int)(values[i].size); ++k)
+      supports[i][values[i][k]].initialise(0, num_words*Bitset64::size_word_bit-1,
+					   Bitset64::empt, pool[i]+k*num_words);
+  }
 
+  for(t=0; t<valid.size; ++t) {
+    for(i=0; i<arity; ++i) {
+      supports[i][table[valid[t]][i]].fast_add(t);
+    }
+  }
 
-//   while(!events.empty()) {
-//     //if(LB_CHANGED(event_type[events.pop()])) ++min_;
-//     if(scope[events.pop()].get_min()) ++min_;
-//     else --max_;
-//   }
+  GlobalConstraint::initialise();
+}
 
-// #ifdef _DEBUG_CARD
+Mistral::ConstraintCompactTable::~ConstraintCompactTable()
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete compact-table constraint" << std::endl;
+#endif
+
+  int arity = scope.size;
+  for(int i=0; i<arity; ++i) {
+    // the masks point into the pool, they should not free it
+    for(unsigned int k=0; k<values[i].size; ++k)
+      supports[i][values[i][k]].table = NULL;
+    supports[i] += themins[i];
+    delete [] supports[i];
+    residue[i] += themins[i];
+    delete [] residue[i];
+    delete [] pool[i];
+  }
+  delete [] supports;
+  delete [] residue;
+  delete [] pool;
+  delete [] values;
+  delete [] themins;
+  delete [] mask;
+  delete [] stamp;
+  delete [] nonzero;
+}
+
+void Mistral::ConstraintCompactTable::restore_words() {
+  int w;
+  while((int)trail_index.size > trail_size) {
+    w = trail_index.pop();
+    current.table[w] = trail_value.pop();
+    stamp[w] = trail_stamp.pop();
+  }
+}
+
+void Mistral::ConstraintCompactTable::intersect_with_mask(const bool complement) {
+  int i, w, lvl = solver->level, lim = limit;
+  word nw, flip = (complement ? ~(word)0 : (word)0);
+  word *words = current.table;
+
+  for(i=lim; i--;) {
+    w = nonzero[i];
+    nw = words[w] & (mask[w] ^ flip);
+    if(nw != words[w]) {
+      if(stamp[w] != lvl) {
+	trail_index.add(w);
+	trail_value.add(words[w]);
+	trail_stamp.add(stamp[w]);
+	stamp[w] = lvl;
+      }
+      words[w] = nw;
+      if(!nw) {
+	nonzero[i] = nonzero[--lim];
+	nonzero[lim] = w;
+      }
+    }
+  }
+
+  if((int)trail_index.size != trail_size) trail_size = trail_index.size;
+  if(lim != limit) limit = lim;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintCompactTable::propagate()
+{
+  PropagationOutcome wiped = CONSISTENT;
+
+  int i, k, x, y, w, val, lim, arity = scope.size;
+  bool reset;
+  const word *sup;
+  word *words;
+
+  restore_words();
+
+#ifdef _DEBUG_TABLE
+  if(_DEBUG_TABLE) {
+    std::cout << "\npropagate " << *this << " changes: " << changes << std::endl;
+  }
+#endif
+
+  if(is_empty()) return FAILURE(changes.empty() ? 0 : changes[0]);
+
+  // update the set of valid tuples
+  int last_changed = (changes.size == 1 ? changes[0] : -1);
+  while(!changes.empty()) {
+    x = changes.pop();
+
+    lim = limit;
+    for(i=0; i<lim; ++i) mask[nonzero[i]] = 0;
+
+    // reset-based (union of the supports of the remaining values) or
+    // incremental (union of the supports of the removed values)
+    reset = (scope[x].get_size() <= (int)(values[x].size) - scope[x].get_size());
+    for(k=values[x].size; k--;) {
+      val = values[x][k];
+      if(scope[x].contain(val) == reset) {
+	sup = supports[x][val].table;
+	for(i=0; i<lim; ++i) {
+	  w = nonzero[i];
+	  mask[w] |= sup[w];
+	}
+      }
+    }
+    intersect_with_mask(!reset);
+
+    if(is_empty()) {
+      changes.clear();
+      return FAILURE(x);
+    }
+  }
+
+  // filter the domains: look for a support of every value, starting from its residue
+  words = current.table;
+  lim = limit;
+  for(y=0; IS_OK(wiped) && y<arity; ++y) {
+    if(y == last_changed || !active.contain(y)) continue;
+
+    for(k=values[y].size; IS_OK(wiped) && k--;) {
+      val = values[y][k];
+      if(!scope[y].contain(val)) continue;
+      sup = supports[y][val].table;
+      w = residue[y][val];
+      if(!(words[w] & sup[w])) {
+	for(i=0; i<lim; ++i) {
+	  w = nonzero[i];
+	  if(words[w] & sup[w]) {
+	    residue[y][val] = w;
+	    break;
+	  }
+	}
+	if(i == lim && FAILED(scope[y].remove(val))) wiped = FAILURE(y);
+      }
+    }
+  }
+
+#ifdef _DEBUG_TABLE
+  if(_DEBUG_TABLE) {
+    std::cout << "return " << (IS_OK(wiped) ? "consistent\n" : "failure\n");
+  }
+#endif
+
+  return wiped;
+}
+
+int Mistral::ConstraintCompactTable::check( const int* s ) const
+{
+  int i, w, arity = scope.size;
+  word inter;
+
+  for(i=0; i<arity; ++i) {
+    if(s[i] < themins[i] || s[i] > scope[i].get_initial_max() || !supports[i][s[i]].table)
+      return 1;
+  }
+
+  for(w=0; w<num_words; ++w) {
+    inter = supports[0][s[0]].table[w];
+    for(i=1; inter && i<arity; ++i)
+      inter &= supports[i][s[i]].table[w];
+    if(inter) return 0;
+  }
+
+  return 1;
+}
+
+std::ostream& Mistral::ConstraintCompactTable::display(std::ostream& os) const {
+  os << "TABLE_CT(" << scope[0]/*.get_var()*/ ;
+  for(unsigned int i=1; i<scope.size; ++i)
+    os << ", " << scope[i]/*.get_var()*/;
+  os << ")";
+  return os;
+}
+
+
+
+// lexicographic order on the tuples of a table
+struct tuple_order {
+  int arity;
+  tuple_order(const int n) : arity(n) {}
+  bool operator()(const int* t1, const int* t2) const {
+    for(int i=0; i<arity; ++i) 
+      if(t1[i] != t2[i]) return t1[i] < t2[i];
+    return false;
+  }
+};
+
+Mistral::ConstraintMDD::ConstraintMDD(Vector< Variable >& scp, const int init, 
+				      Vector< int >& trans, Vector< int >& finals) 
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST; 
+  initial_state = init;
+  transitions = trans;
+  final_states = finals;
+  num_nodes = 0;
+  in_edges = out_edges = NULL;
+  value_edges = NULL;
+  min_value = max_value = in_count = out_count = NULL;
+  support_count = NULL;
+  alive = NULL;
+}
+
+Mistral::ConstraintMDD::ConstraintMDD(Vector< Variable >& scp, Vector< const int* >& tuples) 
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST; 
+  num_nodes = 0;
+  in_edges = out_edges = NULL;
+  value_edges = NULL;
+  min_value = max_value = in_count = out_count = NULL;
+  support_count = NULL;
+  alive = NULL;
+
+  // the table is turned into a trie: once sorted, each tuple shares the 
+  // prefix it has in common with the previous one
+  int i, p, n = scope.size, num_states = 1;
+  Vector< const int* > sorted;
+  sorted = tuples;
+  std::sort(sorted.stack_, sorted.stack_+sorted.size, tuple_order(n));
+
+  Vector< int > path;
+  path.initialise(n+1, n+1, 0);
+  initial_state = 0;
+  for(unsigned int t=0; t<sorted.size; ++t) {
+    p = 0;
+    if(t) while(p<n && sorted[t-1][p] == sorted[t][p]) ++p;
+    if(p == n) continue;
+    for(i=p; i<n; ++i) {
+      path[i+1] = num_states++;
+      transitions.add(path[i]);
+      transitions.add(sorted[t][i]);
+      transitions.add(path[i+1]);
+    }
+    final_states.add(path[n]);
+  }
+}
+
+void Mistral::ConstraintMDD::compile() {
+  int i, q, t, v, n = scope.size, num_states = initial_state+1;
+  unsigned int j, k;
+
+  for(k=0; k<transitions.size; k+=3) {
+    if(transitions[k] >= num_states) num_states = transitions[k]+1;
+    if(transitions[k+2] >= num_states) num_states = transitions[k+2]+1;
+  }
+  for(k=0; k<final_states.size; ++k) 
+    if(final_states[k] >= num_states) num_states = final_states[k]+1;
+
+  // transitions out of every state
+  Vector< int > *delta = new Vector< int >[num_states];
+  for(k=0; k<transitions.size; k+=3) 
+    delta[transitions[k]].add(k);
+
+  // states reachable at every layer, within the current domains
+  Vector< int > *reached = new Vector< int >[n+1];
+  int *mark = new int[num_states];
+  std::fill(mark, mark+num_states, -1);
+  reached[0].add(initial_state);
+  mark[initial_state] = 0;
+  for(i=0; i<n; ++i) {
+    for(j=0; j<reached[i].size; ++j) {
+      q = reached[i][j];
+      for(k=0; k<delta[q].size; ++k) {
+	t = delta[q][k];
+	if(scope[i].contain(transitions[t+1]) && mark[transitions[t+2]] != i+1) {
+	  mark[transitions[t+2]] = i+1;
+	  reached[i+1].add(transitions[t+2]);
+	}
+      }
+    }
+  }
+
+  // node[q] (resp. next_node[q]) is the node of state q in the current 
+  // (resp. next) layer, or -1 if it does not lead to the terminal
+  int *node = new int[num_states];
+  int *next_node = new int[num_states];
+  std::fill(node, node+num_states, -1);
+  std::fill(next_node, next_node+num_states, -1);
+  for(k=0; k<final_states.size; ++k) 
+    if(mark[final_states[k]] == n) next_node[final_states[k]] = 1;
+
+  // bottom-up, the states with the same outgoing edges are merged
+  num_nodes = 2;
+  std::map< std::vector< std::pair< int, int > >, int > signatures;
+  std::map< std::vector< std::pair< int, int > >, int >::iterator it;
+  std::vector< std::pair< int, int > > sig;
+  for(i=n-1; i>=0; --i) {
+    signatures.clear();
+    for(j=0; j<reached[i].size; ++j) {
+      q = reached[i][j];
+      sig.clear();
+      for(k=0; k<delta[q].size; ++k) {
+	t = delta[q][k];
+	v = transitions[t+1];
+	if(scope[i].contain(v) && next_node[transitions[t+2]] >= 0) 
+	  sig.push_back(std::make_pair(v, next_node[transitions[t+2]]));
+      }
+      if(sig.empty()) continue;
+      std::sort(sig.begin(), sig.end());
+      sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+
+      it = signatures.find(sig);
+      if(it != signatures.end()) node[q] = it->second;
+      else {
+	node[q] = (i ? num_nodes++ : 0);
+	signatures[sig] = node[q];
+	for(k=0; k<sig.size(); ++k) {
+	  edge_from.add(node[q]);
+	  edge_to.add(sig[k].second);
+	  edge_layer.add(i);
+	  edge_value.add(sig[k].first);
+	}
+      }
+    }
+    for(j=0; j<reached[i+1].size; ++j) next_node[reached[i+1][j]] = -1;
+    for(j=0; j<reached[i].size; ++j) {
+      q = reached[i][j];
+      next_node[q] = node[q];
+      node[q] = -1;
+    }
+  }
+
+  delete [] delta;
+  delete [] reached;
+  delete [] mark;
+  delete [] node;
+  delete [] next_node;
+}
+
+void Mistral::ConstraintMDD::initialise() {
+  ConstraintImplementation::initialise();
+  for(unsigned int i=0; i<scope.size; ++i)
+    trigger_on(_DOMAIN_, scope[i]);
+  GlobalConstraint::initialise();
+
+  if(!num_nodes) compile();
+
+  int i, e, n = scope.size, m = edge_from.size;
+
+  in_edges = new Vector< int >[num_nodes];
+  out_edges = new Vector< int >[num_nodes];
+  in_count = new int[num_nodes];
+  out_count = new int[num_nodes];
+  std::fill(in_count, in_count+num_nodes, 0);
+  std::fill(out_count, out_count+num_nodes, 0);
+  alive = new char[m];
+  std::fill(alive, alive+m, 1);
+
+  min_value = new int[n];
+  max_value = new int[n];
+  std::fill(min_value, min_value+n, INFTY);
+  std::fill(max_value, max_value+n, -INFTY);
+  for(e=0; e<m; ++e) {
+    i = edge_layer[e];
+    if(edge_value[e] < min_value[i]) min_value[i] = edge_value[e];
+    if(edge_value[e] > max_value[i]) max_value[i] = edge_value[e];
+  }
+
+  value_edges = new Vector< int >*[n];
+  support_count = new int*[n];
+  for(i=0; i<n; ++i) {
+    if(min_value[i] > max_value[i]) {
+      min_value[i] = 0;
+      max_value[i] = -1;
+    }
+    value_edges[i] = new Vector< int >[max_value[i]-min_value[i]+1];
+    support_count[i] = new int[max_value[i]-min_value[i]+1];
+    std::fill(support_count[i], support_count[i]+max_value[i]-min_value[i]+1, 0);
+  }
+
+  for(e=0; e<m; ++e) {
+    i = edge_layer[e];
+    out_edges[edge_from[e]].add(e);
+    in_edges[edge_to[e]].add(e);
+    value_edges[i][edge_value[e]-min_value[i]].add(e);
+    ++out_count[edge_from[e]];
+    ++in_count[edge_to[e]];
+    ++support_count[i][edge_value[e]-min_value[i]];
+  }
+
+  trail_size.initialise(solver, 0);
+  synced.initialise(solver, 0);
+}
+
+Mistral::ConstraintMDD::~ConstraintMDD() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete mdd constraint" << std::endl;
+#endif
+  if(value_edges) {
+    for(unsigned int i=0; i<scope.size; ++i) {
+      delete [] value_edges[i];
+      delete [] support_count[i];
+    }
+  }
+  delete [] value_edges;
+  delete [] support_count;
+  delete [] in_edges;
+  delete [] out_edges;
+  delete [] in_count;
+  delete [] out_count;
+  delete [] min_value;
+  delete [] max_value;
+  delete [] alive;
+}
+
+void Mistral::ConstraintMDD::restore_edges() {
+  int e;
+  while((int)killed.size > trail_size) {
+    e = killed.pop();
+    alive[e] = 1;
+    ++out_count[edge_from[e]];
+    ++in_count[edge_to[e]];
+    ++support_count[edge_layer[e]][edge_value[e]-min_value[edge_layer[e]]];
+  }
+}
+
+void Mistral::ConstraintMDD::remove_value(const int i, const int a) {
+  Vector< int >& edges = value_edges[i][a-min_value[i]];
+  for(unsigned int k=0; k<edges.size; ++k) 
+    if(alive[edges[k]]) to_kill.add(edges[k]);
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintMDD::kill_edges() {
+  PropagationOutcome wiped = CONSISTENT;
+  int e, u, w, i, a, k;
+
+  while(IS_OK(wiped) && to_kill.size) {
+    e = to_kill.pop();
+    if(!alive[e]) continue;
+    alive[e] = 0;
+    killed.add(e);
+
+    u = edge_from[e];
+    w = edge_to[e];
+    i = edge_layer[e];
+    a = edge_value[e];
+
+    // u is no longer on a path to the terminal
+    if(!--out_count[u]) {
+      if(!u) wiped = FAILURE(i);
+      else for(k=in_edges[u].size; k--;)
+	     if(alive[in_edges[u][k]]) to_kill.add(in_edges[u][k]);
+    }
+    // w is no longer on a path from the root
+    if(!--in_count[w]) {
+      if(w == 1) wiped = FAILURE(i);
+      else for(k=out_edges[w].size; k--;)
+	     if(alive[out_edges[w][k]]) to_kill.add(out_edges[w][k]);
+    }
+    // x_i=a has no support left
+    if(!--support_count[i][a-min_value[i]] && scope[i].contain(a) && FAILED(scope[i].remove(a))) 
+      wiped = FAILURE(i);
+  }
+  to_kill.clear();
+
+  return wiped;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintMDD::propagate() 
+{
+  PropagationOutcome wiped = CONSISTENT;
+  int i, a, vnxt, n = scope.size;
+
+  restore_edges();
+  to_kill.clear();
+
+  if(!synced) {
+    // first call on this branch, every value is checked
+    for(i=0; IS_OK(wiped) && i<n; ++i) {
+      vnxt = scope[i].get_first();
+      do {
+	a = vnxt;
+	vnxt = scope[i].next(a);
+	if((a < min_value[i] || a > max_value[i] || !support_count[i][a-min_value[i]]) 
+	   && FAILED(scope[i].remove(a))) wiped = FAILURE(i);
+      } while(IS_OK(wiped) && a != vnxt);
+      for(a=min_value[i]; a<=max_value[i]; ++a) 
+	if(support_count[i][a-min_value[i]] && !scope[i].contain(a)) 
+	  remove_value(i, a);
+    }
+    changes.clear();
+    synced = 1;
+  } else {
+    while(!changes.empty()) {
+      i = changes.pop();
+      for(a=min_value[i]; a<=max_value[i]; ++a) 
+	if(support_count[i][a-min_value[i]] && !scope[i].contain(a)) 
+	  remove_value(i, a);
+    }
+  }
+
+  if(IS_OK(wiped)) wiped = kill_edges();
+
+  if((int)killed.size != trail_size) trail_size = killed.size;
+
+  return wiped;
+}
+
+int Mistral::ConstraintMDD::check( const int* s ) const 
+{
+  unsigned int j, k;
+  int e, n = scope.size;
+  Vector< int > layer, next_layer;
+  Vector< char > reached;
+  reached.initialise(num_nodes, num_nodes, 0);
+
+  // the diagram may be non-deterministic, all the paths are followed
+  layer.add(0);
+  for(int i=0; i<n; ++i) {
+    next_layer.clear();
+    for(j=0; j<layer.size; ++j) 
+      for(k=0; k<out_edges[layer[j]].size; ++k) {
+	e = out_edges[layer[j]][k];
+	if(edge_value[e] == s[i] && !reached[edge_to[e]]) {
+	  reached[edge_to[e]] = 1;
+	  next_layer.add(edge_to[e]);
+	}
+      }
+    layer = next_layer;
+  }
+
+  return !reached[1];
+}
+
+std::ostream& Mistral::ConstraintMDD::display(std::ostream& os) const {
+  os << "mdd(" << scope[0];
+  for(unsigned int i=1; i<scope.size; ++i)
+    os << ", " << scope[i];
+  os << ")[" << num_nodes << " nodes, " << edge_from.size << " edges]";
+  return os;
+}
+
+
+
+
+// Mistral::ConstraintBoolSumEqual::ConstraintBoolSumEqual(Vector< Variable >& scp, const int t)
+//   : GlobalConstraint(scp) { 
+//   priority = 1;
+//   total = t; 
+//   lower_bound = t;
+//   upper_bound = t;
+// }
+
+// void Mistral::ConstraintBoolSumEqual::initialise() {
+//   ConstraintImplementation::initialise();
+//   int _min_ = 0;
+//   int _max_ = scope.size;
+
+
+//   std::cout << "initialise: c" << id << " " << this << std::endl;
+
+
+//   for(unsigned int i=0; i<scope.size; ++i) {
+//     trigger_on(_VALUE_, scope[i]);
+//     if(scope[i].is_ground()) {
+//       if(scope[i].get_value()) ++_min_;
+//       else --_max_;
+//     }
+//   }
+
+//   min_.initialise(get_solver(), _min_);
+//   max_.initialise(get_solver(), _max_);
+
+//   GlobalConstraint::initialise();
+// }
+
+// void Mistral::ConstraintBoolSumEqual::mark_domain() {
+//   for(int i=scope.size; i;)
+//     get_solver()->forbid(scope[--i].id(), LIST_VAR);
+// }
+
+// Mistral::ConstraintBoolSumEqual::~ConstraintBoolSumEqual() 
+// {
+// #ifdef _DEBUG_MEMORY
+//   std::cout << "c delete boolsumequal constraint" << std::endl;
+// #endif
+// }
+
+// Mistral::PropagationOutcome Mistral::ConstraintBoolSumEqual::propagate() 
+// {
+//   PropagationOutcome wiped_idx = CONSISTENT;
+
+// #ifdef _DEBUG_CARD
+//   if(_DEBUG_CARD) {
+//     std::cout << "c" << id << ":\n";
+//     std::cout << "changes: " << changes << std::endl;
+//     std::cout << " events: " << events << std::endl;
+    
+//     int new_evt[scope.size];
+//     for(int i=0; i<scope.size; ++i) {
+//       new_evt[i]=0;
+//     }
+//     for(int i=0; i<events.size; ++i) {
+//       new_evt[events[i]] = 1;
+//     }
+//     std::cout << " propagate [" ;
+//     for(int i=0; i<scope.size; ++i) {
+//       std::cout << std::setw(5) << scope[i].get_domain();
+//     }
+//     std::cout << "]\n   changes [" ;
+//     for(int i=0; i<scope.size; ++i) {
+//       std::cout << std::setw(5) << (new_evt[i] ? scope[i].get_domain() : " ");
+//     }
+//     std::cout << "]\n was in [" << min_ << ".." << max_ << "] now in [";
+//   }
+// #endif
+
+
+
+//   while(!events.empty()) {
+//     //if(LB_CHANGED(event_type[events.pop()])) ++min_;
+//     if(scope[events.pop()].get_min()) ++min_;
+//     else --max_;
+//   }
+
+// #ifdef _DEBUG_CARD
 //   if(_DEBUG_CARD) {
 //   std::cout << min_ << ".." << max_ << "]\n";
 //  }
@@ -9046,7 +10265,7 @@ std::ostream& Mistral::ConstraintGAC3::display(std::ostream& os) const {
 
 Mistral::ConstraintBoolSumInterval::ConstraintBoolSumInterval(Vector< Variable >& scp, const int l, const int u)
   : GlobalConstraint(scp) { 
-  priority = 1;
+  priority = LINEAR_COST;
   lower_bound = l; 
   upper_bound = u; 
   init_prop = true;
@@ -9668,26 +10887,26 @@ std::ostream& Mistral::ConstraintBoolSumInterval::display(std::ostream& os) cons
 Mistral::PredicateBoolSum::PredicateBoolSum(Vector< Variable >& scp, Variable tot, const int o)
   : GlobalConstraint(scp) { 
   scope.add(tot);
-  priority = 1;
+  priority = LINEAR_COST;
   offset = o;
 }
 
 Mistral::PredicateBoolSum::PredicateBoolSum(std::vector< Variable >& scp, Variable tot, const int o)
   : GlobalConstraint(scp) {
   scope.add(tot);
-  priority = 1;
+  priority = LINEAR_COST;
   offset = o;
 }
 
 Mistral::PredicateBoolSum::PredicateBoolSum(Vector< Variable >& scp, const int o)
   : GlobalConstraint(scp) { 
-  priority = 1;
+  priority = LINEAR_COST;
   offset = o;
 }
 
 Mistral::PredicateBoolSum::PredicateBoolSum(std::vector< Variable >& scp, const int o)
   : GlobalConstraint(scp) { 
-  priority = 1;
+  priority = LINEAR_COST;
   offset = o;
 }
 
@@ -9917,7 +11136,7 @@ std::ostream& Mistral::PredicateBoolSum::display(std::ostream& os) const {
 Mistral::PredicateWeightedSum::PredicateWeightedSum(Vector< Variable >& scp, 
 const int L, const int U)
 : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-	priority = 1;
+	priority = LINEAR_COST;
 	for(unsigned int i=0; i<scope.size; ++i) {
 		weight.add(1);
 	}
@@ -9927,7 +11146,7 @@ Mistral::PredicateWeightedSum::PredicateWeightedSum(Vector< Variable >& scp,
 Vector< int >& wgt,
 const int L, const int U)
 : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-	priority = 1;
+	priority = LINEAR_COST;
 	for(unsigned int i=0; i<scope.size; ++i) {
 		weight.add(wgt[i]);
 	}
@@ -9937,7 +11156,7 @@ Mistral::PredicateWeightedSum::PredicateWeightedSum(std::vector< Variable >& scp
 std::vector< int >& wgt,
 const int L, const int U)
 : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-	priority = 1;
+	priority = LINEAR_COST;
 	for(unsigned int i=0; i<scope.size; ++i) {
 		weight.add(wgt[i]);
 	}
@@ -10000,6 +11219,21 @@ void Mistral::PredicateWeightedSum::initialise() {
 	up_bound = new int[scope.size];
 	span = new int[scope.size];
 
+	// the bounds are computed at the first call to propagate()
+	std::fill(lo_bound, lo_bound+scope.size, 0);
+	std::fill(up_bound, up_bound+scope.size, 0);
+	std::fill(span, span+scope.size, 0);
+	smin = smax = 0;
+	synced.initialise(solver, 0);
+
+	stamp = new int[scope.size];
+	std::fill(stamp, stamp+scope.size, -1);
+	trail_size.initialise(solver, 0);
+
+	by_span = new int[scope.size];
+	init_span = new int[scope.size];
+	max_span.initialise(solver, 0);
+
 	// //std::cout << (int*)env << std::endl;
 	// std::cout  << "-- " << (int*)solver << std::endl;
 
@@ -10057,11 +11291,53 @@ Mistral::PredicateWeightedSum::~PredicateWeightedSum()
 	delete [] lo_bound;
 	delete [] up_bound;
 	delete [] span;
+	delete [] stamp;
+	delete [] by_span;
+	delete [] init_span;
+}
+
+void Mistral::PredicateWeightedSum::set_bounds(const int i, const int lo, const int up) {
+	if(weight[i] > 0) {
+		smin += weight[i] * (lo - lo_bound[i]);
+		smax += weight[i] * (up - up_bound[i]);
+		span[i] = weight[i] * (up - lo);
+	} else {
+		smin += weight[i] * (up - up_bound[i]);
+		smax += weight[i] * (lo - lo_bound[i]);
+		span[i] = weight[i] * (lo - up);
+	}
+	lo_bound[i] = lo;
+	up_bound[i] = up;
+}
+
+void Mistral::PredicateWeightedSum::update_bounds(const int i) {
+	int lo = scope[i].get_min(), up = scope[i].get_max();
+	if(lo != lo_bound[i] || up != up_bound[i]) {
+		if(stamp[i] != solver->level) {
+			trail_index.add(i);
+			trail_lo.add(lo_bound[i]);
+			trail_up.add(up_bound[i]);
+			trail_stamp.add(stamp[i]);
+			stamp[i] = solver->level;
+		}
+		set_bounds(i, lo, up);
+	}
+}
+
+void Mistral::PredicateWeightedSum::restore_bounds() {
+	int i, lo, up;
+	while((int)trail_index.size > trail_size) {
+		i = trail_index.pop();
+		up = trail_up.pop();
+		lo = trail_lo.pop();
+		set_bounds(i, lo, up);
+		stamp[i] = trail_stamp.pop();
+	}
 }
 
 
 
-
+
 Mistral::PropagationOutcome Mistral::PredicateWeightedSum::rewrite() {
 
 #ifdef _DEBUG_REWRITE
@@ -10319,11 +11595,22 @@ void Mistral::PredicateWeightedSum::weight_conflict(double unit, Vector<double>&
 Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate() 
 {
   
-	int i, j;
-	// compute the max and th min
-	int tmin, smin=0, tmax, smax=0// , maxspan=0
-		, arity=scope.size;
+	int i, j, k, tmin, tmax, slack, bound, arity=scope.size;
 	PropagationOutcome wiped = CONSISTENT;
+
+	// bring the bounds up to date with the variables that changed
+	restore_bounds();
+	if(!synced) {
+		for(i=0; i<arity; ++i) {
+			update_bounds(i);
+			init_span[i] = span[i];
+		}
+		sort_tasks(by_span, init_span, arity);
+		max_span = (arity ? init_span[by_span[arity-1]] : 0);
+		synced = 1;
+	} else {
+		for(j=events.size; j--;) update_bounds(events[j]);
+	}
   
 #ifdef _DEBUG_WEIGHTEDSUM
 	if(_DEBUG_WEIGHTEDSUM) {
@@ -10331,54 +11618,9 @@ Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate()
 		for(i=0; i<arity; ++i) {
 			std::cout << " " << weight[i] << scope[i] << ":" << scope[i].get_domain();
 		}
-		std::cout << " <= " << upper_bound << std::endl << changes << std::endl;
-	}
-#endif
-  
-	for(i=0; i<wpos; ++i) {
-		smax += (up_bound[i] = scope[i].get_max());
-		smin += (lo_bound[i] = scope[i].get_min());
-		span[i] = (up_bound[i]-lo_bound[i]);
-
-#ifdef _DEBUG_WEIGHTEDSUM
-		if(_DEBUG_WEIGHTEDSUM) {
-			if(i)
-				std::cout << " + [" << lo_bound[i] << "," << up_bound[i] << "] = [" << smin << "," << smax << "] ";
-			else
-				std::cout << "[" << smin << "," << smax << "] ";
-		}
-#endif
-    
-	}
-	for(i=wpos; i<wneg; ++i) {
-		smax += weight[i] * (up_bound[i] = scope[i].get_max());
-		smin += weight[i] * (lo_bound[i] = scope[i].get_min());
-		span[i] = weight[i] * (up_bound[i]-lo_bound[i]);
-    
-#ifdef _DEBUG_WEIGHTEDSUM
-		if(_DEBUG_WEIGHTEDSUM) {
-			if(i)
-				std::cout << " + [" << lo_bound[i] << "," << up_bound[i] << "] = [" << smin << "," << smax << "] ";
-			else
-				std::cout << "[" << smin << "," << smax << "] ";
-		}
-#endif
-    
+		std::cout << " <= " << upper_bound << " [" << smin << "," << smax << "] " << std::endl << changes << std::endl;
 	}
-	for(i=wneg; i<arity; ++i) {
-		smax += weight[i] * (lo_bound[i] = scope[i].get_min());
-		smin += weight[i] * (up_bound[i] = scope[i].get_max());
-		span[i] = weight[i] * (lo_bound[i]-up_bound[i]);
-    
-#ifdef _DEBUG_WEIGHTEDSUM
-		if(_DEBUG_WEIGHTEDSUM) {
-			if(i)
-				std::cout << " + [" << lo_bound[i] << "," << up_bound[i] << "] = [" << smin << "," << smax << "] ";
-			else
-				std::cout << "[" << smin << "," << smax << "] ";
-		}
 #endif
-	}
 
   
 	while(IS_OK(wiped) && !events.empty()) {
@@ -10394,9 +11636,6 @@ Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate()
 			while( j-- ) {
 				i = events[j];
 
-				//std::cout << i << ": " << (span[i]) << " " << (unknown_parity.contain(i)) << std::endl;
-
-
 				if(span[i]==0 && unknown_parity.contain(i)) {
 					unknown_parity.reversible_remove(i);
 					if( lo_bound[i]%2 ) parity = 1-parity;
@@ -10437,13 +11676,8 @@ Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate()
 				}
 #endif
 	  
-				tmin = lo_bound[i];
-				if( FAILED(scope[i].set_min(++lo_bound[i])) ) wiped = FAILURE(i);
-				else {
-					lo_bound[i] = scope[i].get_min();
-					if(i<wneg) smin += ((lo_bound[i] - tmin)*weight[i]);
-					else smax += ((lo_bound[i] - tmin)*weight[i]);
-				}
+				if( FAILED(scope[i].set_min(lo_bound[i]+1)) ) wiped = FAILURE(i);
+				else update_bounds(i);
 
 #ifdef _DEBUG_WEIGHTEDSUM
 				if(_DEBUG_WEIGHTEDSUM) {
@@ -10461,13 +11695,8 @@ Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate()
 				}
 #endif
 	  
-				tmin = up_bound[i];
-				if( FAILED(scope[i].set_max(--up_bound[i])) ) wiped = FAILURE(i);
-				else {
-					up_bound[i] = scope[i].get_max();
-					if(i<wneg) smax -= ((tmin - up_bound[i])*weight[i]);
-					else smin -= ((tmin - up_bound[i])*weight[i]);
-				}
+				if( FAILED(scope[i].set_max(up_bound[i]-1)) ) wiped = FAILURE(i);
+				else update_bounds(i);
 
 #ifdef _DEBUG_WEIGHTEDSUM
 				if(_DEBUG_WEIGHTEDSUM) {
@@ -10493,189 +11722,69 @@ Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate()
 		else {
 			tmax = (smax - lower_bound);
 			tmin = (upper_bound - smin);
-	
-			for(i=0; IS_OK(wiped) && i<wpos; ++i) {
-	  
-				if( tmin < (up_bound[i] - lo_bound[i]) ) {
-
-#ifdef _DEBUG_WEIGHTEDSUM
-					if(_DEBUG_WEIGHTEDSUM) {
-						std::cout << scope[i] << " in " << scope[i].get_domain() << " <= " << (lo_bound[i] + tmin) << std::endl;
-					}
-#endif
-	    
-					if(FAILED(scope[i].set_max( lo_bound[i] + tmin ))) wiped = FAILURE(i);
-					else {
-	      
-						events.add(i);
-						event_type[i] = UB_EVENT;
-	    
+			slack = std::min(tmin, tmax);
+
+			// only the terms whose span exceeds the slack can be pruned, 
+			// they are visited by decreasing initial span (an upper bound 
+			// on their current span), and 'bound' collects the largest span
+			if(max_span > slack) {
+				bound = 0;
+				for(k=arity; IS_OK(wiped) && k--;) {
+					i = by_span[k];
+					if(init_span[i] <= slack) {
+						bound = std::max(bound, init_span[i]);
+						break;
 					}
-				}
-			}
-	
-			for(i=wpos; IS_OK(wiped) && i<wneg; ++i) {
-	  	  
-				if( tmin < (up_bound[i] - lo_bound[i]) * weight[i] ) {
+					bound = std::max(bound, span[i]);
 
-#ifdef _DEBUG_WEIGHTEDSUM
-					if(_DEBUG_WEIGHTEDSUM) {
-						std::cout << scope[i] << " in " << scope[i].get_domain() << " <= " << (lo_bound[i] + tmin/weight[i]) << std::endl;
-					}
-#endif
-	  	    
-					if(FAILED(scope[i].set_max( lo_bound[i] + tmin/weight[i] ))) wiped = FAILURE(i);
-	    
-					else {
-						events.add(i);
-						event_type[i] = UB_EVENT;
-					}
-				}
-			}
-	
-			for(i=wneg; IS_OK(wiped) && i<arity; ++i) {
-	  
-				if( tmin < (lo_bound[i] - up_bound[i]) * weight[i] ) {
+					if( tmin < span[i] ) {
 
 #ifdef _DEBUG_WEIGHTEDSUM
-					if(_DEBUG_WEIGHTEDSUM) {
-						std::cout << scope[i] << " in " << scope[i].get_domain() << " >= " << (up_bound[i] + tmin/weight[i]) << std::endl;
-					}
-#endif
-	    
-					if(FAILED(scope[i].set_min( up_bound[i] + tmin/weight[i] ))) wiped = FAILURE(i);
-	    
-					else {
-						events.add(i);
-						event_type[i] = LB_EVENT;
-					}
-				}
-			}
-	
-			for(i=0; IS_OK(wiped) && i<wpos; ++i) {
-	  
-				if( tmax < (up_bound[i] - lo_bound[i]) ) {
-	    
-#ifdef _DEBUG_WEIGHTEDSUM
-					if(_DEBUG_WEIGHTEDSUM) {
-						std::cout << scope[i] << " in " << scope[i].get_domain() << " >= " << (up_bound[i] - tmax) << std::endl;
-					}
-#endif
-
-					if(FAILED(scope[i].set_min( up_bound[i] - tmax ))) wiped = FAILURE(i);
-	    
-					else {
-	      
-						if(events.contain(i)) {
-							event_type[i] |= LB_EVENT;
-						} else {
-							events.add(i);
-							event_type[i] = LB_EVENT;
+						if(_DEBUG_WEIGHTEDSUM) {
+							std::cout << scope[i] << " in " << scope[i].get_domain() << (i<wneg ? " <= " : " >= ") 
+								  << (i<wneg ? lo_bound[i] + tmin/weight[i] : up_bound[i] + tmin/weight[i]) << std::endl;
 						}
-
-					}
-				}
-			}
-	
-			for(i=wpos; IS_OK(wiped) && i<wneg; ++i) {
-	  
-				if( tmax < (up_bound[i] - lo_bound[i]) * weight[i] ) {
-
-#ifdef _DEBUG_WEIGHTEDSUM
-					if(_DEBUG_WEIGHTEDSUM) {
-						std::cout << scope[i] << " in " << scope[i].get_domain() << " >= " << (up_bound[i] - tmax/weight[i]) << std::endl;
-					}
 #endif
-	    
-					if(FAILED(scope[i].set_min( up_bound[i] - tmax/weight[i] ))) wiped = FAILURE(i);
-	    
-					else {
-	      
-						if(events.contain(i)) {
-							event_type[i] |= LB_EVENT;
+
+						if(i<wneg) {
+							if(FAILED(scope[i].set_max( lo_bound[i] + tmin/weight[i] ))) wiped = FAILURE(i);
 						} else {
-							events.add(i);
-							event_type[i] = LB_EVENT;
+							if(FAILED(scope[i].set_min( up_bound[i] + tmin/weight[i] ))) wiped = FAILURE(i);
 						}
-	      
+						if(IS_OK(wiped)) events.add(i);
 					}
-				}
-			}
 
+					if( IS_OK(wiped) && tmax < span[i] ) {
 
-			for(i=wneg; IS_OK(wiped) && i<arity; ++i) {
-	  
-				if( tmax < (lo_bound[i] - up_bound[i]) * weight[i] ) {  
-	    
 #ifdef _DEBUG_WEIGHTEDSUM
-					if(_DEBUG_WEIGHTEDSUM) {
-						std::cout << scope[i] << " in " << scope[i].get_domain() << " <= " << (lo_bound[i] - tmax/weight[i]) << std::endl;
-					}
+						if(_DEBUG_WEIGHTEDSUM) {
+							std::cout << scope[i] << " in " << scope[i].get_domain() << (i<wneg ? " >= " : " <= ") 
+								  << (i<wneg ? up_bound[i] - tmax/weight[i] : lo_bound[i] - tmax/weight[i]) << std::endl;
+						}
 #endif
 
-					if(FAILED(scope[i].set_max( lo_bound[i] - tmax/weight[i] ))) wiped = FAILURE(i);
-	    
-					else {
-	      
-						if(events.contain(i)) {
-							event_type[i] |= UB_EVENT;
+						if(i<wneg) {
+							if(FAILED(scope[i].set_min( up_bound[i] - tmax/weight[i] ))) wiped = FAILURE(i);
 						} else {
-							events.add(i);
-							event_type[i] = UB_EVENT;
+							if(FAILED(scope[i].set_max( lo_bound[i] - tmax/weight[i] ))) wiped = FAILURE(i);
 						}
-
+						if(IS_OK(wiped) && !events.contain(i)) events.add(i);
 					}
 				}
+
+				if(IS_OK(wiped) && bound < max_span) max_span = bound;
 			}
 		}
       
 		/// update smin and smax
-		for(unsigned int j=0; IS_OK(wiped) && j<events.size; ++j) {
-			i = events[j];
-			if(i<wpos) {
-				if(LB_CHANGED(event_type[i])){ 
-					smin -= lo_bound[i];
-					lo_bound[i] = scope[i].get_min();
-					span[i] = (up_bound[i]-lo_bound[i]);
-					smin += lo_bound[i];
-				} 
-				if(UB_CHANGED(event_type[i])){ 
-					smax -= up_bound[i];
-					up_bound[i] = scope[i].get_max();
-					span[i] = (up_bound[i]-lo_bound[i]);
-					smax += up_bound[i];
-				}
-			} else if(i<wneg) {
-				if(LB_CHANGED(event_type[i])){ 
-					smin -= (lo_bound[i] * weight[i]);
-					lo_bound[i] = scope[i].get_min();
-					span[i] = weight[i] * (up_bound[i]-lo_bound[i]);
-					smin += (lo_bound[i] * weight[i]);
-				} 
-				if(UB_CHANGED(event_type[i])){ 
-					smax -= (up_bound[i] * weight[i]);
-					up_bound[i] = scope[i].get_max();
-					span[i] = weight[i] * (up_bound[i]-lo_bound[i]);
-					smax += (up_bound[i] * weight[i]);
-				}
-			} else {
-				if(LB_CHANGED(event_type[i])){ 
-					smax -= (lo_bound[i] * weight[i]);
-					lo_bound[i] = scope[i].get_min();
-					span[i] = weight[i] * (lo_bound[i]-up_bound[i]);
-					smax += (lo_bound[i] * weight[i]);
-				} 
-				if(UB_CHANGED(event_type[i])){ 
-					smin -= (up_bound[i] * weight[i]);
-					up_bound[i] = scope[i].get_max();
-					span[i] = weight[i] * (lo_bound[i]-up_bound[i]);
-					smin += (up_bound[i] * weight[i]);
-				}
-			}
+		for(j=0; IS_OK(wiped) && j<(int)events.size; ++j) {
+			update_bounds(events[j]);
 		}
 	}
 }
 
+if((int)trail_index.size != trail_size) trail_size = trail_index.size;
+
 #ifdef _DEBUG_WEIGHTEDSUM
 if(_DEBUG_WEIGHTEDSUM) {
 	std::cout << "result: ";
@@ -10689,6 +11798,54 @@ if(_DEBUG_WEIGHTEDSUM) {
 return wiped;
 }
 
+void Mistral::PredicateWeightedSum::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+						  const int upper, const int v) 
+{
+  int i, j=-1, arity=scope.size;
+  long long smin=0, smax=0, lo, up, w;
+  bool min_side = false, max_side = false;
+
+  // bounds of the sum of the other terms
+  for(i=0; i<arity; ++i) {
+    if(j<0 && x>=0 && scope[i].id() == x) {
+      j = i;
+      continue;
+    }
+    lo = lcg->get_lb(scope[i]);
+    up = lcg->get_ub(scope[i]);
+    if(weight[i] > 0) {
+      smin += weight[i] * lo;
+      smax += weight[i] * up;
+    } else {
+      smin += weight[i] * up;
+      smax += weight[i] * lo;
+    }
+  }
+
+  if(j < 0) {
+    if(x < 0) {
+      max_side = (smax < lower_bound);
+      min_side = (!max_side && smin > upper_bound);
+    }
+  } else {
+    // the value just beyond the new bound must be excluded by one side of the sum 
+    // (otherwise it was a parity deduction, which is explained by the whole scope)
+    w = weight[j];
+    lo = (upper ? v+1 : v-1);
+    min_side = ((w > 0) == (upper != 0) && w * lo + smin > upper_bound);
+    max_side = (!min_side && (w > 0) != (upper != 0) && w * lo + smax < lower_bound);
+  }
+
+  if(min_side || max_side) {
+    for(i=0; i<arity; ++i) if(i != j) {
+	if((weight[i] > 0) == min_side) lcg->add_lb(scope[i], lcg->get_lb(scope[i]));
+	else lcg->add_ub(scope[i], lcg->get_ub(scope[i]));
+      }
+  } else {
+    ConstraintImplementation::explain_bound(lcg, x, upper, v);
+  }
+}
+
 int Mistral::PredicateWeightedSum::check( const int* s ) const 
 {
 int i=scope.size, t=0;
@@ -10724,13 +11881,13 @@ return os;
 Mistral::ConstraintOrderedSum::ConstraintOrderedSum(Vector< Variable >& scp, 
 const int L, const int U)
 : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-	priority = 1;
+	priority = LINEAR_COST;
 }
 
 Mistral::ConstraintOrderedSum::ConstraintOrderedSum(std::vector< Variable >& scp, 
 const int L, const int U)
 : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-	priority = 1;
+	priority = LINEAR_COST;
 }
 
 
@@ -10989,7 +12146,7 @@ std::ostream& Mistral::ConstraintOrderedSum::display(std::ostream& os) const {
 
 Mistral::ConstraintParity::ConstraintParity(Vector< Variable >& scp, const int p)
   : GlobalConstraint(scp), target_parity(p) { 
-  priority = 1;
+  priority = LINEAR_COST;
   //init_prop = true;
 }
 
@@ -11051,6 +12208,9 @@ Mistral::PropagationOutcome Mistral::ConstraintParity::propagate()
 
     int parity = 0;
     for(int i=scope.size; --i>=0;) {
+      // the last active variable may already be assigned (if the
+      // constraint was postponed), it is the one we must set
+      if(active.size && i == (int)(active.back())) continue;
       parity ^= scope[i].get_min();
 
 #ifdef _DEBUG_PARITY
@@ -11110,6 +12270,312 @@ std::ostream& Mistral::ConstraintParity::display(std::ostream& os) const {
 }
 
 
+Mistral::ConstraintGaussJordan::ConstraintGaussJordan(Vector< Variable >& scp)
+  : GlobalConstraint(scp) { 
+  priority = QUADRATIC_COST;
+  enforce_nfc1 = false;
+  data = NULL;
+  row_of_pivot = stamp = index_of = NULL;
+  reason = NULL;
+}
+
+Mistral::ConstraintGaussJordan::ConstraintGaussJordan(Vector< Variable >& scp, 
+						      Vector< Vector< int > >& eqs, 
+						      Vector< int >& p)
+  : GlobalConstraint(scp) { 
+  priority = QUADRATIC_COST;
+  enforce_nfc1 = false;
+  data = NULL;
+  row_of_pivot = stamp = index_of = NULL;
+  reason = NULL;
+  for(unsigned int r=0; r<eqs.size; ++r) 
+    add_equation(eqs[r], p[r]);
+}
+
+void Mistral::ConstraintGaussJordan::add_equation(Vector< int >& cols, const int p) {
+  equations.add(cols);
+  parities.add(p);
+}
+
+void Mistral::ConstraintGaussJordan::initialise() {
+  ConstraintImplementation::initialise();
+  // the variables are Boolean, so a range event is an assignment, but 
+  // unlike _VALUE_ it also triggers the first propagation at the root
+  for(unsigned int i=0; i<scope.size; ++i) 
+    trigger_on(_RANGE_, scope[i]);
+  GlobalConstraint::initialise();
+
+  int n = scope.size;
+  num_rows = equations.size;
+  num_words = (n+63)/64;
+  block_size = num_words+2;
+  data = new word[(num_rows+2)*block_size];
+  std::fill(data, data+(num_rows+2)*block_size, 0);
+  row_of_pivot = new int[n];
+  std::fill(row_of_pivot, row_of_pivot+n, -1);
+
+  stamp = new int[num_rows+2];
+  std::fill(stamp, stamp+num_rows+2, -1);
+  trail_size.initialise(solver, 0);
+  synced.initialise(solver, 0);
+
+  to_process.initialise(0, n-1, n, false);
+  to_check.initialise(0, (num_rows ? num_rows-1 : 0), (num_rows ? num_rows : 1), false);
+
+  reason = new Vector< int >[n+1];
+  max_id = 0;
+  for(int i=0; i<n; ++i) 
+    if(scope[i].id() > max_id) max_id = scope[i].id();
+  index_of = new int[max_id+1];
+  std::fill(index_of, index_of+max_id+1, -1);
+  for(int i=0; i<n; ++i) 
+    index_of[scope[i].id()] = i;
+}
+
+Mistral::ConstraintGaussJordan::~ConstraintGaussJordan() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete gauss-jordan constraint" << std::endl;
+#endif
+  delete [] data;
+  delete [] row_of_pivot;
+  delete [] stamp;
+  delete [] reason;
+  delete [] index_of;
+}
+
+void Mistral::ConstraintGaussJordan::save_block(const int b) {
+  if(stamp[b] != solver->level) {
+    word *block = data + b*block_size;
+    trail_block.add(b);
+    trail_stamp.add(stamp[b]);
+    for(int k=0; k<block_size; ++k) trail_words.add(block[k]);
+    stamp[b] = solver->level;
+  }
+}
+
+void Mistral::ConstraintGaussJordan::restore_blocks() {
+  int b, p;
+  word *block;
+  while((int)trail_block.size > trail_size) {
+    b = trail_block.pop();
+    block = data + b*block_size;
+    if(b < num_rows) {
+      p = (int)(pivot(b))-1;
+      if(p >= 0 && row_of_pivot[p] == b) row_of_pivot[p] = -1;
+    }
+    for(int k=block_size; k--;) block[k] = trail_words.pop();
+    if(b < num_rows) {
+      p = (int)(pivot(b))-1;
+      if(p >= 0) row_of_pivot[p] = b;
+    }
+    stamp[b] = trail_stamp.pop();
+  }
+}
+
+void Mistral::ConstraintGaussJordan::reduce() {
+  int i, k, r, r2, c, n = scope.size;
+  word *wr, *wr2, *asg = assigned(), *val = values();
+
+  std::fill(data, data+(num_rows+2)*block_size, 0);
+  std::fill(row_of_pivot, row_of_pivot+n, -1);
+  std::fill(stamp, stamp+num_rows+2, -1);
+
+  for(i=0; i<n; ++i) if(scope[i].is_ground()) {
+      asg[i/64] |= ((word)1 << (i%64));
+      if(scope[i].get_value()) val[i/64] |= ((word)1 << (i%64));
+    }
+
+  // a column appearing twice in an equation cancels out
+  for(r=0; r<num_rows; ++r) {
+    wr = row(r);
+    for(k=equations[r].size; k--;) {
+      i = equations[r][k];
+      wr[i/64] ^= ((word)1 << (i%64));
+    }
+    rhs(r) = parities[r];
+  }
+
+  for(r=0; r<num_rows; ++r) {
+    wr = row(r);
+    c = -1;
+    for(k=0; c<0 && k<num_words; ++k) 
+      if(wr[k] & ~asg[k]) c = 64*k + __builtin_ctzll(wr[k] & ~asg[k]);
+    if(c >= 0) {
+      pivot(r) = c+1;
+      row_of_pivot[c] = r;
+      for(r2=0; r2<num_rows; ++r2) 
+	if(r2 != r && (row(r2)[c/64] & ((word)1 << (c%64)))) {
+	  wr2 = row(r2);
+	  for(k=0; k<num_words; ++k) wr2[k] ^= wr[k];
+	  rhs(r2) ^= rhs(r);
+	}
+    }
+    to_check.add(r);
+  }
+}
+
+void Mistral::ConstraintGaussJordan::assign(const int i) {
+  int k, r, r2, c, w = i/64;
+  word bit = ((word)1 << (i%64)), *wr, *wr2, *asg = assigned();
+
+  if(asg[w] & bit) return;
+
+  save_block(num_rows);
+  asg[w] |= bit;
+  if(scope[i].get_value()) {
+    save_block(num_rows+1);
+    values()[w] |= bit;
+  }
+
+  // find a new pivot for the row of i, and eliminate it from the other rows
+  r = row_of_pivot[i];
+  if(r >= 0) {
+    row_of_pivot[i] = -1;
+    save_block(r);
+    wr = row(r);
+    c = -1;
+    for(k=0; c<0 && k<num_words; ++k) 
+      if(wr[k] & ~asg[k]) c = 64*k + __builtin_ctzll(wr[k] & ~asg[k]);
+    pivot(r) = c+1;
+    if(c >= 0) {
+      row_of_pivot[c] = r;
+      for(r2=0; r2<num_rows; ++r2) 
+	if(r2 != r && (row(r2)[c/64] & ((word)1 << (c%64)))) {
+	  save_block(r2);
+	  wr2 = row(r2);
+	  for(k=0; k<num_words; ++k) wr2[k] ^= wr[k];
+	  rhs(r2) ^= rhs(r);
+	  if(!to_check.contain(r2)) to_check.add(r2);
+	}
+    }
+  }
+
+  for(r=0; r<num_rows; ++r) 
+    if((row(r)[w] & bit) && !to_check.contain(r)) to_check.add(r);
+}
+
+void Mistral::ConstraintGaussJordan::store_reason(const int r, const int i) {
+  word *wr = row(r), bits;
+  reason[i].clear();
+  for(int k=0; k<num_words; ++k) {
+    bits = wr[k];
+    while(bits) {
+      int j = 64*k + __builtin_ctzll(bits);
+      bits &= (bits-1);
+      if(j != i) reason[i].add(j);
+    }
+  }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintGaussJordan::propagate() 
+{
+  PropagationOutcome wiped = CONSISTENT;
+  int i, k, r, c, free_cols, par, n = scope.size;
+  word *wr, *asg, *val;
+
+  restore_blocks();
+  to_process.clear();
+  to_check.clear();
+
+  if(!synced) {
+    reduce();
+    synced = 1;
+  } else {
+    for(k=events.size; k--;) {
+      i = events[k];
+      if(scope[i].is_ground() && !(assigned()[i/64] & ((word)1 << (i%64)))) 
+	to_process.add(i);
+    }
+  }
+
+  while(IS_OK(wiped) && (!to_process.empty() || !to_check.empty())) {
+    while(!to_process.empty()) assign(to_process.pop());
+
+    asg = assigned();
+    val = values();
+    while(IS_OK(wiped) && !to_check.empty()) {
+      r = to_check.pop();
+      wr = row(r);
+      free_cols = 0;
+      par = (int)(rhs(r));
+      c = -1;
+      for(k=0; k<num_words; ++k) {
+	free_cols += __builtin_popcountll(wr[k] & ~asg[k]);
+	par ^= (__builtin_popcountll(wr[k] & val[k]) & 1);
+      }
+      if(free_cols == 0) {
+	// all the columns of the row are assigned, and their sum is wrong
+	if(par) {
+	  store_reason(r, n);
+	  wiped = FAILURE(reason[n].empty() ? 0 : reason[n][0]);
+	}
+      } else if(free_cols == 1) {
+	// the only free column is the pivot, it must fix the parity
+	c = (int)(pivot(r))-1;
+	if(scope[c].is_ground()) {
+	  // already assigned by another constraint, the event is pending
+	  if(scope[c].get_value() != par) {
+	    store_reason(r, n);
+	    wiped = FAILURE(c);
+	  }
+	} else {
+	  store_reason(r, c);
+	  if(FAILED(scope[c].set_domain(par))) wiped = FAILURE(c);
+	}
+	if(IS_OK(wiped) && !to_process.contain(c)) to_process.add(c);
+      }
+    }
+  }
+
+  if((int)trail_block.size != trail_size) trail_size = trail_block.size;
+
+  return wiped;
+}
+
+Mistral::Explanation::iterator Mistral::ConstraintGaussJordan::get_reason_for(const Atom a, const int lvl, Explanation::iterator& end) {
+  Vector< int >& cols = reason[(a == NULL_ATOM ? scope.size : index_of[a])];
+  explanation.clear();
+  for(unsigned int k=0; k<cols.size; ++k) 
+    explanation.add(NOT(literal(scope[cols[k]])));
+  end = explanation.end();
+  return explanation.begin();
+}
+
+void Mistral::ConstraintGaussJordan::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+						   const int upper, const int v) {
+  Vector< int >& cols = reason[(x < 0 || x > max_id || index_of[x] < 0 ? scope.size : index_of[x])];
+  for(unsigned int k=0; k<cols.size; ++k) {
+    if(lcg->get_lb(scope[cols[k]]) > 0) lcg->add_lb(scope[cols[k]], 1);
+    else lcg->add_ub(scope[cols[k]], 0);
+  }
+}
+
+int Mistral::ConstraintGaussJordan::check( const int* s ) const 
+{
+  for(unsigned int r=0; r<equations.size; ++r) {
+    int t = parities[r];
+    for(unsigned int k=0; k<equations[r].size; ++k) 
+      t ^= s[equations[r][k]];
+    if(t) return 1;
+  }
+  return 0;
+}
+
+std::ostream& Mistral::ConstraintGaussJordan::display(std::ostream& os) const {
+  os << "gauss-jordan(";
+  for(unsigned int r=0; r<equations.size; ++r) {
+    if(r) os << ", ";
+    os << (parities[r] ? "odd(" : "even(");
+    for(unsigned int k=0; k<equations[r].size; ++k) 
+      os << (k ? " " : "") << scope[equations[r][k]];
+    os << ")";
+  }
+  os << ")";
+  return os;
+}
+
+
 
 
 
@@ -11118,7 +12584,7 @@ std::ostream& Mistral::ConstraintParity::display(std::ostream& os) const {
 Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(Vector< Variable >& scp, 
 									      const int L, const int U)
   : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-  priority = 1;
+  priority = LINEAR_COST;
   for(unsigned int i=0; i<scope.size; ++i) {
     weight.add(1);
   }
@@ -11128,7 +12594,7 @@ Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(Ve
 									      Vector< int >& wgt,
 									      const int L, const int U)
   : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-  priority = 1;
+  priority = LINEAR_COST;
   for(unsigned int i=0; i<scope.size; ++i) {
     weight.add(wgt[i]);
   }
@@ -11138,7 +12604,7 @@ Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(st
 									      std::vector< int >& wgt,
 									      const int L, const int U)
   : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-  priority = 1;
+  priority = LINEAR_COST;
   for(unsigned int i=0; i<scope.size; ++i) {
     weight.add(wgt[i]);
   }
@@ -12124,7 +13590,7 @@ std::ostream& Mistral::ConstraintWeightedBoolSumInterval::display(std::ostream&
 Mistral::ConstraintIncrementalWeightedBoolSumInterval::ConstraintIncrementalWeightedBoolSumInterval(Vector< Variable >& scp, 
 												    const int L, const int U)
   : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-  priority = 1;
+  priority = LINEAR_COST;
  init_prop = true;
   for(unsigned int i=0; i<scope.size; ++i) {
     weight.add(1);
@@ -12135,7 +13601,7 @@ Mistral::ConstraintIncrementalWeightedBoolSumInterval::ConstraintIncrementalWeig
 												    Vector< int >& wgt,
 												    const int L, const int U)
   : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-  priority = 1;
+  priority = LINEAR_COST;
  init_prop = true;
   for(unsigned int i=0; i<wgt.size; ++i) {
     weight.add(wgt[i]);
@@ -12146,7 +13612,7 @@ Mistral::ConstraintIncrementalWeightedBoolSumInterval::ConstraintIncrementalWeig
 												    std::vector< int >& wgt,
 												    const int L, const int U)
   : GlobalConstraint(scp), lower_bound(L), upper_bound(U) { 
-  priority = 1;
+  priority = LINEAR_COST;
   for(unsigned int i=0; i<wgt.size(); ++i) {
     weight.add(wgt[i]);
   }
@@ -12903,47 +14369,370 @@ std::ostream& Mistral::ConstraintIncrementalWeightedBoolSumInterval::display(std
 
 
 
-
-
-
-
-Mistral::PredicateWeightedBoolSum::PredicateWeightedBoolSum(Vector< Variable >& scp, const int o)
-  : GlobalConstraint(scp) { 
-  priority = 1;
-  offset = o;
+Mistral::ConstraintWatchedBoolSum::ConstraintWatchedBoolSum(Vector< Variable >& scp,
+							    const int L, const int U)
+  : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
+  priority = LINEAR_COST;
+  enforce_nfc1 = false;
   init_prop = true;
-  for(unsigned int i=1; i<scope.size; ++i) {
+  domains = NULL;
+  for(unsigned int i=0; i<scope.size; ++i) {
     weight.add(1);
   }
 }
 
-Mistral::PredicateWeightedBoolSum::PredicateWeightedBoolSum(Vector< Variable >& scp, 
-							    Vector< int >& wgt, 
-							    const int o)
-  : GlobalConstraint(scp) { 
-  priority = 1;
-  offset = o;
+Mistral::ConstraintWatchedBoolSum::ConstraintWatchedBoolSum(Vector< Variable >& scp,
+							    Vector< int >& wgt,
+							    const int L, const int U)
+  : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
+  priority = LINEAR_COST;
+  enforce_nfc1 = false;
   init_prop = true;
+  domains = NULL;
   for(unsigned int i=0; i<wgt.size; ++i) {
     weight.add(wgt[i]);
   }
 }
 
-Mistral::PredicateWeightedBoolSum::PredicateWeightedBoolSum(std::vector< Variable >& scp, 
-							    std::vector< int >& wgt, 
-							    const int o)
-  : GlobalConstraint(scp) { 
-  priority = 1;
-  offset = o;
-  init_prop = true;
-  for(unsigned int i=0; i<wgt.size(); ++i) {
-    weight.add(wgt[i]);
+// computes the form sum(coefficient[i] * (x[i] == polarity[i])) >= bound,
+// returns false if the sum is bounded on both sides
+bool normalise_bool_sum(Vector< int >& weight, const int L, const int U,
+			Vector< int >& coefficient, Vector< int >& polarity,
+			int& bound, int& max_coefficient) {
+  int i, w, n = weight.size, min_sum = 0, max_sum = 0;
+  for(i=0; i<n; ++i) {
+    if(weight[i] < 0) min_sum += weight[i];
+    else max_sum += weight[i];
   }
-}
 
-void Mistral::PredicateWeightedBoolSum::initialise() {
-  ConstraintImplementation::initialise();
-  
+  // a1 * b1 + ... + an * bn <= U is -a1 * b1 - ... - an * bn >= -U
+  int sign = 1;
+  bound = L;
+  if(U < max_sum) {
+    if(L > min_sum) return false;
+    sign = -1;
+    bound = -U;
+  }
+
+  // a * b = a + |a| * (1-b) when a < 0
+  coefficient.clear();
+  polarity.clear();
+  for(i=0; i<n; ++i) {
+    w = sign * weight[i];
+    coefficient.add(std::abs(w));
+    polarity.add(w >= 0);
+    if(w < 0) bound -= w;
+  }
+
+  // a coefficient larger than the bound can be reduced to the bound
+  max_coefficient = 0;
+  for(i=0; i<n; ++i) {
+    if(bound > 0 && coefficient[i] > bound) coefficient[i] = bound;
+    if(max_coefficient < coefficient[i]) max_coefficient = coefficient[i];
+  }
+
+  return true;
+}
+
+bool Mistral::ConstraintWatchedBoolSum::is_worthwhile(Vector< Variable >& scp, Vector< int >& coefs,
+						      const int L, const int U) {
+  Vector< int > weight, coefficient, polarity;
+  int i, bound, max_coefficient, total = 0;
+
+  for(i=0; i<(int)(scp.size); ++i) {
+    // constants do not have a Boolean domain
+    if(scp[i].is_ground()) return false;
+    weight.add(coefs.empty() ? 1 : coefs[i]);
+  }
+
+  if(!normalise_bool_sum(weight, L, U, coefficient, polarity, bound, max_coefficient) || bound <= 0)
+    return false;
+
+  for(i=0; i<(int)(scp.size); ++i) total += coefficient[i];
+  return 2*(bound + max_coefficient) <= total;
+}
+
+void Mistral::ConstraintWatchedBoolSum::initialise() {
+  ConstraintImplementation::initialise();
+
+  for(unsigned int i=0; i<scope.size; ++i) {
+    trigger_on(_VALUE_, scope[i]);
+  }
+
+  normalise_bool_sum(weight, lower_bound, upper_bound,
+		     coefficient, polarity, bound, max_coefficient);
+
+  num_watched = scope.size;
+  cursor = 0;
+  check_all = true;
+  saturated.initialise(get_solver(), 0);
+  satisfied.initialise(get_solver(), 0);
+  for(unsigned int i=0; i<scope.size; ++i) {
+    watched.add(i);
+    position.add(i);
+  }
+
+  GlobalConstraint::initialise();
+
+  domains = new BoolDomain[scope.size];
+  for(unsigned int i=0; i<scope.size; ++i) {
+    Variable var = scope[i].get_var();
+    domains[i] = var.bool_domain;
+  }
+}
+
+void Mistral::ConstraintWatchedBoolSum::mark_domain() {
+  for(int i=scope.size; i;)
+    get_solver()->forbid(scope[--i].id(), LIST_VAR|BITSET_VAR|RANGE_VAR);
+}
+
+Mistral::ConstraintWatchedBoolSum::~ConstraintWatchedBoolSum()
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete watched boolsum constraint" << std::endl;
+#endif
+  delete [] domains;
+}
+
+// returns a non-false literal that is not watched (or -1 if there is none)
+int Mistral::ConstraintWatchedBoolSum::find_watch() {
+  int i, n = scope.size, m = n - num_watched;
+  while(m--) {
+    if(cursor < num_watched || cursor >= n) cursor = num_watched;
+    i = watched[cursor++];
+    if(coefficient[i] && !is_false(i)) return i;
+  }
+  return -1;
+}
+
+void Mistral::ConstraintWatchedBoolSum::watch(const int i) {
+  int j = watched[num_watched];
+  watched[position[i]] = j;
+  position[j] = position[i];
+  watched[num_watched] = i;
+  position[i] = num_watched++;
+  un_relax_from(i);
+}
+
+void Mistral::ConstraintWatchedBoolSum::unwatch(const int i) {
+  int j = watched[--num_watched];
+  watched[position[i]] = j;
+  position[j] = position[i];
+  watched[num_watched] = i;
+  position[i] = num_watched;
+  un_post_from(i);
+}
+
+Mistral::Explanation::iterator Mistral::ConstraintWatchedBoolSum::get_reason_for(const Atom a, const int lvl, Explanation::iterator& end) {
+  explanation.clear();
+
+  int *rank = get_solver()->assignment_order.stack_;
+  int a_rank = (a != NULL_ATOM ? rank[a] : INFTY-1);
+  unsigned int idx;
+
+  // the literals that were already false when 'a' was entailed
+  int i = scope.size;
+  while(i--) {
+    idx = scope[i].id();
+    if(idx != a && is_false(i) && rank[idx] < a_rank)
+      explanation.add(literal(scope[i], polarity[i]));
+  }
+
+  end = explanation.end();
+  return explanation.begin();
+}
+
+// the watches are still valid when the constraint is restored,
+// so it should be posted on the free watches only
+void Mistral::ConstraintWatchedBoolSum::relax_watches() {
+  active.save();
+  active.clear();
+  for(int k=0; k<num_watched; ++k) {
+    int i = watched[k];
+    if(!IS_GROUND(domains[i])) active.add(i);
+  }
+  relax();
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintWatchedBoolSum::propagate()
+{
+  PropagationOutcome wiped_idx = CONSISTENT;
+  int i, j, k, lost, gained = 0;
+
+  if(init_prop) {
+    // every variable is watched until the target is reached
+    init_prop = false;
+    for(i=scope.size; i--;)
+      if(index[i] < 0) un_relax_from(i);
+  }
+
+  if(bound <= 0) {
+    // entailed
+    changes.clear();
+    return wiped_idx;
+  }
+
+  for(k=changes.size; k--;) {
+    i = changes[k];
+    if(is_true(i)) gained += coefficient[i];
+  }
+  if(gained) {
+    satisfied += gained;
+    if(satisfied >= bound) {
+      relax_watches();
+      changes.clear();
+      return wiped_idx;
+    }
+    gained = 0;
+  }
+
+  int target = bound + max_coefficient;
+  // whether every non-false literal is watched
+  bool complete = saturated;
+
+  // replace the watches that became false by literals with at least the same coefficient
+  while(!check_all && !complete && !changes.empty()) {
+    i = changes.pop();
+    if(index[i] >= 0 && is_false(i)) {
+      lost = coefficient[i];
+      while(lost > 0 && (j = find_watch()) >= 0) {
+	watch(j);
+	lost -= coefficient[j];
+	if(is_true(j)) gained += coefficient[j];
+      }
+      if(lost > 0) complete = check_all = true;
+      else unwatch(i);
+    }
+  }
+  changes.clear();
+
+  if(check_all || complete) {
+    int total = 0;
+    for(k=0; k<num_watched; ++k) {
+      i = watched[k];
+      if(!is_false(i)) total += coefficient[i];
+    }
+    while(total < target && !complete) {
+      if((j = find_watch()) >= 0) {
+	watch(j);
+	total += coefficient[j];
+	if(is_true(j)) gained += coefficient[j];
+      } else complete = true;
+    }
+
+    if(total >= target) {
+      check_all = false;
+      // drop the watches that are not needed to reach the target
+      for(k=num_watched; !saturated && k--;) {
+	i = watched[k];
+	if(is_false(i)) {
+	  unwatch(i);
+	} else if(!is_true(i) && total - coefficient[i] >= target) {
+	  total -= coefficient[i];
+	  unwatch(i);
+	}
+      }
+    } else if(total < bound) {
+      wiped_idx = FAILURE(watched[0]);
+    } else {
+      // no watch is dropped below this point, so that every 
+      // non-false literal stays watched until we backtrack
+      saturated = 1;
+      int fixed = 0;
+      for(k=0; k<num_watched; ++k) {
+	i = watched[k];
+	if(!IS_GROUND(domains[i]) && total - coefficient[i] < bound)
+	  scope[i].set_domain(polarity[i]);
+	if(is_true(i)) fixed += coefficient[i];
+      }
+      // every true literal is watched, including those we just set
+      if(satisfied + gained < fixed) gained = fixed - satisfied;
+    }
+  }
+
+  // the true literals that we started watching
+  if(gained && IS_OK(wiped_idx)) {
+    satisfied += gained;
+    if(satisfied >= bound) relax_watches();
+  }
+
+  return wiped_idx;
+}
+
+int Mistral::ConstraintWatchedBoolSum::check( const int* s ) const
+{
+  int i=weight.size, t=0;
+  while(i--) {
+    t+=(weight[i]*s[i]);
+  }
+  return (t < lower_bound || t > upper_bound);
+}
+
+std::ostream& Mistral::ConstraintWatchedBoolSum::display(std::ostream& os) const {
+
+#ifdef _GET_SUM_NAME
+  os << " cwbs: (" << id << ") ";
+#endif
+
+  if(lower_bound > -INFTY)
+    os << lower_bound << " <= " ;
+
+  os << weight[0] << "*" << scope[0]/*.get_var()*/ << ":" << scope[0].get_domain();
+
+  for(unsigned int i=1; i<weight.size; ++i)
+    os << " + " << weight[i] << "*" << scope[i]/*.get_var()*/ << ":" << scope[i].get_domain();
+
+  if(upper_bound < INFTY)
+    os << " <= " << upper_bound;
+
+  return os;
+}
+
+
+
+
+
+
+
+
+
+Mistral::PredicateWeightedBoolSum::PredicateWeightedBoolSum(Vector< Variable >& scp, const int o)
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST;
+  offset = o;
+  init_prop = true;
+  for(unsigned int i=1; i<scope.size; ++i) {
+    weight.add(1);
+  }
+}
+
+Mistral::PredicateWeightedBoolSum::PredicateWeightedBoolSum(Vector< Variable >& scp, 
+							    Vector< int >& wgt, 
+							    const int o)
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST;
+  offset = o;
+  init_prop = true;
+  for(unsigned int i=0; i<wgt.size; ++i) {
+    weight.add(wgt[i]);
+  }
+}
+
+Mistral::PredicateWeightedBoolSum::PredicateWeightedBoolSum(std::vector< Variable >& scp, 
+							    std::vector< int >& wgt, 
+							    const int o)
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST;
+  offset = o;
+  init_prop = true;
+  for(unsigned int i=0; i<wgt.size(); ++i) {
+    weight.add(wgt[i]);
+  }
+}
+
+void Mistral::PredicateWeightedBoolSum::initialise() {
+  ConstraintImplementation::initialise();
+  
 
   int ordering[weight.size];
   for(unsigned int i=0; i<weight.size; ++i) {
@@ -13870,38 +15659,62 @@ std::ostream& Mistral::PredicateWeightedBoolSum::display(std::ostream& os) const
 Mistral::PredicateElement::PredicateElement(Vector< Variable >& scp, const int o)
   : GlobalConstraint(scp) {
   offset = o;
-  priority = 1;
+  priority = LINEAR_COST;
+  index_support = NULL;
+  value_support = NULL;
+  first_value = NULL;
+  next_value = NULL;
+  prev_value = NULL;
 }
 
 Mistral::PredicateElement::PredicateElement(std::vector< Variable >& scp, const int o)
   : GlobalConstraint(scp) { 
   offset = o;
-  priority = 1;
+  priority = LINEAR_COST;
+  index_support = NULL;
+  value_support = NULL;
+  first_value = NULL;
+  next_value = NULL;
+  prev_value = NULL;
 }
 
 void Mistral::PredicateElement::initialise() {
 	
-	//std::cout << "start init" << std::endl;
-	
   ConstraintImplementation::initialise();
 
-  int n = scope.size-1;
-  aux_dom.initialise( std::min( 0, scope[n].get_min() ), 
-		      std::max( n, scope[n].get_max() ), 
-		      BitSet::empt );
+  int i, n = scope.size-2;
 
-  for(unsigned int i=0; i<scope.size; ++i)
+  for(i=0; i<(int)(scope.size); ++i)
     trigger_on(_DOMAIN_, scope[i]);
   //set_idempotent(true);
 
   GlobalConstraint::initialise();
 
   /////
-  scope[n-1].set_min(0+offset);
-  scope[n-1].set_max(n-2+offset);
-	
-	//std::cout << "end init" << std::endl;
+  scope[n].set_min(0+offset);
+  scope[n].set_max(n-1+offset);
+
+  // the values of V that can have a support
+  min_value = INFTY;
+  max_value = -INFTY;
+  for(i=0; i<n; ++i) {
+    if(min_value > scope[i].get_min()) min_value = scope[i].get_min();
+    if(max_value < scope[i].get_max()) max_value = scope[i].get_max();
+  }
+  if(min_value < scope[n+1].get_min()) min_value = scope[n+1].get_min();
+  if(max_value > scope[n+1].get_max()) max_value = scope[n+1].get_max();
+  if(max_value < min_value) max_value = min_value;
+
+  int m = max_value-min_value+1;
+  index_support = new int[n];
+  for(i=0; i<n; ++i) index_support[i] = scope[i].get_min();
+  first_value = new int[n];
+  value_support = new int[m];
+  next_value = new int[m];
+  prev_value = new int[m];
 
+  live.initialise(solver, 0, n-1, n, true);
+  synced.initialise(solver, 0);
 }
 
 void Mistral::PredicateElement::mark_domain() {
@@ -13914,17 +15727,82 @@ Mistral::PredicateElement::~PredicateElement()
 #ifdef _DEBUG_MEMORY
   std::cout << "c delete element predicate" << std::endl;
 #endif
+  delete [] index_support;
+  delete [] value_support;
+  delete [] first_value;
+  delete [] next_value;
+  delete [] prev_value;
+}
+
+
+bool Mistral::PredicateElement::index_supported(const int i) 
+{
+  Variable V = scope[scope.size-1];
+  int v = index_support[i], vnxt;
+  if(scope[i].contain(v) && V.contain(v)) return true;
+
+  // go through the smaller of the two domains
+  Variable x = scope[i], y = V;
+  if(x.get_size() > y.get_size()) {
+    x = V;
+    y = scope[i];
+  }
+  vnxt = x.get_min();
+  do {
+    v = vnxt;
+    if(y.contain(v)) {
+      index_support[i] = v;
+      return true;
+    }
+    vnxt = x.next(v);
+  } while( v<vnxt );
+
+  return false;
+}
+
+int Mistral::PredicateElement::find_support(const int v) 
+{
+  // 'live' contains the indices of N
+  Variable N = scope[scope.size-2];
+  int i, k, m = live.size;
+  for(k=0; k<m; ++k) {
+    i = live.list_[k];
+    if(scope[i].contain(v) && N.contain(i+offset)) return i;
+  }
+
+  return -1;
 }
 
+Mistral::PropagationOutcome Mistral::PredicateElement::revise(const int i) 
+{
+  PropagationOutcome wiped = CONSISTENT;
+  int n = scope.size-2, k, knxt, j, v;
+  bool valid = scope[n].contain(i+offset);
+
+  for(k=first_value[i]; IS_OK(wiped) && k>=0; k=knxt) {
+    knxt = next_value[k];
+    v = k+min_value;
+    // values that are not in V anymore are left in the list 
+    if(!scope[n+1].contain(v) || (valid && scope[i].contain(v))) continue;
+    j = find_support(v);
+    if(j < 0) {
+      FILTER1( n+1, remove(v) );
+    } else {
+      set_support(k, j);
+    }
+  }
+
+  return wiped;
+}
 
 Mistral::PropagationOutcome Mistral::PredicateElement::propagate() 
 {
 
   PropagationOutcome wiped = CONSISTENT;
-  int i, n = scope.size-2, evt, nxt; //, lb, ub, val;
-  //Variable N = scope[n];
-  //Variable V = scope[n+1];
-  bool update_V = true;
+  int i, k, v, n = scope.size-2, evt, nxt;
+
+  // on the first call in this branch, every support is checked
+  bool check_indices = !synced;
 
 #ifdef _DEBUG_ELEMENT 
   if(_DEBUG_ELEMENT) {
@@ -13936,288 +15814,80 @@ Mistral::PropagationOutcome Mistral::PredicateElement::propagate()
   } 
 #endif
 
-  while(IS_OK(wiped) && update_V) {
-    update_V = false;
+  if(!synced) {
+    for(k=live.size; k--;) {
+      if(!scope[n].contain(live.list_[k]+offset)) live.reversible_remove(live.list_[k]);
+    }
+    std::fill(first_value, first_value+n, -1);
+    std::fill(value_support, value_support+max_value-min_value+1, -1);
+    nxt = scope[n+1].get_min();
+    do {
+      v = nxt;
+      nxt = scope[n+1].next(v);
+      i = (v < min_value || v > max_value ? -1 : find_support(v));
+      if(i < 0) {
+	FILTER1( n+1, remove(v) );
+      } else {
+	set_support(v-min_value, i);
+      }
+    } while( IS_OK(wiped) && v<nxt );
+    synced = 1;
+  }
+
+  do {
     while(IS_OK(wiped) && !changes.empty()) {
-    
-#ifdef _DEBUG_ELEMENT 
-      if(_DEBUG_ELEMENT) {
-	std::cout << changes << " " << events << std::endl;
-      } 
-#endif
       evt = changes.pop();
-  
-#ifdef _DEBUG_ELEMENT 
-      if(_DEBUG_ELEMENT) {
-	std::cout << "react to " << scope[evt] << " in " << scope[evt].get_domain() << std::endl;
-      } 
-#endif
-      if(evt < n && scope[n].contain(evt+offset)) {
-  
-#ifdef _DEBUG_ELEMENT 
-	if(_DEBUG_ELEMENT) {
-	  std::cout << "  update " << scope[n] << " in " << scope[n].get_domain() << ": "
-		    << scope[n+1] << " in " << scope[n+1].get_domain() << " inter "
-		    << scope[evt] << " in " << scope[evt].get_domain() << "?" << std::endl;
-	} 
-#endif
-	update_V = true;
-	// scope[n] may change if scope[n+1] changes, or any X changes
-	if( !scope[n+1].intersect(scope[evt]) ) {
-	  
-// 	  event_type[n] = scope[n].remove(evt+offset);
-// 	  if( FAILED(event_type[n]) ) {
-// 	    wiped = FAILURE(n);
-	    
-// #ifdef _DEBUG_ELEMENT 
-// 	    if(_DEBUG_ELEMENT) {
-// 	      std::cout << "  => FAIL" << std::endl;
-// 	    } 
-// #endif	
-// 	  } else if(!changes.contain(n)) {
-// 	    changes.add(n);
-
-// #ifdef _DEBUG_ELEMENT 
-// 	    if(_DEBUG_ELEMENT) {
-// 	      std::cout << "  => " << scope[n] << " in " << scope[n].get_domain() << std::endl;
-// 	    } 
-// #endif
-// 	  }
-
-	  FILTER1( n, remove(evt+offset) );
-
-
+      if(evt < n) {
+	if(scope[n].contain(evt+offset)) {
+	  // X[evt] may have lost its support in V, and the values of V it supported
+	  if(!index_supported(evt)) {
+	    FILTER1( n, remove(evt+offset) );
+	  }
+	  if(IS_OK(wiped)) wiped = revise(evt);
 	}
       } else if(evt == n) {
-	update_V = true;
-	if(ASSIGNED(event_type[n])) {
-	  // X may change if scope[n] becomes assigned 
+	if(scope[n].is_ground()) {
+	  // X[N] = V, before going through the values of the other indices
 	  i = scope[n].get_min()-offset;
-	  
-#ifdef _DEBUG_ELEMENT 
-	  if(_DEBUG_ELEMENT) {
-	    std::cout << scope[n+1] << " in " << scope[n+1].get_domain() << " == "
-		      << scope[i] << " in " << scope[i].get_domain() << std::endl;
-	  } 
-#endif
-	  
-	  event_type[i] = scope[i].set_domain(scope[n+1]);
-	  if( FAILED(event_type[i]) ) { 
-#ifdef _DEBUG_ELEMENT 
-	    if(_DEBUG_ELEMENT) {
-	      std::cout << "  => FAIL" << std::endl;
-	    } 
-#endif
-	    wiped = FAILURE(i);
-	  } else {
-	    if( event_type[i] != NO_EVENT && !changes.contain(i) ) {
-	      changes.add(i);
-#ifdef _DEBUG_ELEMENT 
-	      if(_DEBUG_ELEMENT) {
-		std::cout << "  => " << scope[i] << " in " << scope[i].get_domain() << std::endl;
-	      } 
-#endif
-	    }
-// 	    event_type[n+1] = scope[n+1].set_domain(scope[i]);
-// 	    if( FAILED(event_type[n+1]) ) {
-// #ifdef _DEBUG_ELEMENT 
-// 	      if(_DEBUG_ELEMENT) {
-// 		std::cout << "  => FAIL" << std::endl;
-// 	      } 
-// #endif
-// 	      wiped = FAILURE(n+1);
-// 	    } else if( event_type[n+1] != NO_EVENT && !changes.contain(n+1) ) {
-// 	      changes.add(n+1);
-// #ifdef _DEBUG_ELEMENT 
-// 	      if(_DEBUG_ELEMENT) {
-// 		std::cout << "  => " << scope[n+1] << " in " << scope[n+1].get_domain() << std::endl;
-// 	      } 
-// #endif
-// 	    }
+	  FILTER1( i, set_domain(scope[n+1]) );
+	  if(IS_OK(wiped)) {
+	    FILTER1( n+1, set_domain(scope[i]) );
+	  }
+	}
+	// the values of V supported by an index removed from N
+	for(k=live.size; IS_OK(wiped) && k--;) {
+	  i = live.list_[k];
+	  if(!scope[n].contain(i+offset)) {
+	    live.reversible_remove(i);
+	    wiped = revise(i);
+	  }
+	}
+      } else {
+	// the indices supported by a value removed from V
+	check_indices = true;
+      }
+    }
 
-	    FILTER1( n+1 , set_domain(scope[i]) );
+    if(IS_OK(wiped) && scope[n].is_ground()) {
+      // X[N] = V
+      i = scope[n].get_min()-offset;
+      FILTER1( i, set_domain(scope[n+1]) );
+      if(IS_OK(wiped)) {
+	FILTER1( n+1, set_domain(scope[i]) );
+      }
+    }
 
-	  }
+    if(IS_OK(wiped) && check_indices) {
+      check_indices = false;
+      for(k=live.size; IS_OK(wiped) && k--;) {
+	i = live.list_[k];
+	if(scope[n].contain(i+offset) && !index_supported(i)) {
+	  FILTER1( n, remove(i+offset) );
 	}
-      } else if(evt == n+1) {
-#ifdef _DEBUG_ELEMENT 
-	if(_DEBUG_ELEMENT) {
-	  std::cout << "  update " << scope[n] << " in " << scope[n].get_domain() << ": "
-		    << scope[n+1] << " in " << scope[n+1].get_domain() << " inter " << std::endl;
-	} 
-#endif
-	
-	if( scope[n].is_ground() ) {
-#ifdef _DEBUG_ELEMENT 
-	  if(_DEBUG_ELEMENT) {
-	    std::cout << "  update " << scope[n+1] << " in " << scope[n+1].get_domain() << std::endl;
-	  } 
-#endif
-	  
-	  i = scope[n].get_min()-offset;
-// 	  event_type[i] = scope[i].set_domain(scope[n+1]);
-// 	  if( FAILED(event_type[i]) ) { 
-// #ifdef _DEBUG_ELEMENT 
-// 	    if(_DEBUG_ELEMENT) {
-// 	      std::cout << "  => FAIL" << std::endl;
-// 	    } 
-// #endif
-// 	    wiped = FAILURE(i);
-// 	  } else {
-// 	    if( event_type[i] != NO_EVENT && !changes.contain(i) ) {
-// 	      changes.add(i);
-// #ifdef _DEBUG_ELEMENT 
-// 	      if(_DEBUG_ELEMENT) {
-// 		std::cout << "  => " << scope[i] << " in " << scope[i].get_domain() << std::endl;
-// 	      } 
-// #endif
-// 	    }
-// 	  }
-
-	  FILTER1( i, set_domain(scope[n+1]) );
-
-	}
-
-	// nxt = N.get_min();
-	// do {
-	//   i = nxt;
-	  
-	//   std::cout << " " << i ;
-	  
-	//   nxt = N.next(i);
-	// } while( i<nxt );
-	
-	// std::cout << std::endl;
-
-	  
-	nxt = scope[n].get_min();
-	do {
-	  i = nxt;
-	  nxt = scope[n].next(i);
-
-#ifdef _DEBUG_ELEMENT 
-	  if(_DEBUG_ELEMENT) {
-	    std::cout << "  " << scope[i-offset] << " in " << scope[i-offset].get_domain() << "?" ;
-	  } 
-#endif
-	  if( !scope[n+1].intersect(scope[i-offset]) ) {
-#ifdef _DEBUG_ELEMENT 
-	    if(_DEBUG_ELEMENT) {
-	      std::cout << " NO" << std::endl;
-	    } 
-#endif	 
-
-	    //std::cout << n << " " << N << " " << N.get_domain() << " " << i << std::endl;
-
-// 	    event_type[n] = scope[n].remove(i);
-// 	    if( FAILED(event_type[n]) ) {
-// #ifdef _DEBUG_ELEMENT 
-// 	      if(_DEBUG_ELEMENT) {
-// 		std::cout << "  => FAIL" << std::endl;
-// 	      } 
-// #endif
-// 	      wiped = FAILURE(n);
-// 	    } else if( event_type[n] != NO_EVENT && !changes.contain(n) ) {
-// 	      changes.add(n);
-// #ifdef _DEBUG_ELEMENT 
-// 	      if(_DEBUG_ELEMENT) {
-// 		std::cout << "  => " << scope[n] << " in " << scope[n].get_domain() << std::endl;
-// 	      } 
-// #endif
-// 	    }
-
-	    FILTER1( n, remove(i) );
-	    
-#ifdef _DEBUG_ELEMENT 
-	    if(_DEBUG_ELEMENT) {
-	      if(event_type[n] == NO_EVENT) {
-		std::cout << "  => NO EVENT" << std::endl;
-	      }
-	    } 
-#endif	    
-	  } 
-#ifdef _DEBUG_ELEMENT 
-	  
-	  else if(_DEBUG_ELEMENT) {
-	    std::cout << " YES" << std::endl;
-	  }
-#endif
-	} while( i<nxt );
-      }
-    }
-    
-    if(IS_OK(wiped) && update_V) {
-#ifdef _DEBUG_ELEMENT 
-      if(_DEBUG_ELEMENT) {
-	std::cout << "  update " << scope[n+1] << " in " << scope[n+1].get_domain() << std::endl;
-      } 
-#endif
-      aux_dom.clear();
-      //lb=INFTY; ub=-INFTY;
-      
-      // std::cout << "N " << n << ": " << scope[n] << " in " << scope[n].get_domain() << std::endl;
-      // if(scope[n].domain_type == BITSET_VAR) {
-      // 	scope[n].bitset_domain->debug_print();
-      // }
-
-      nxt = scope[n].get_min();
-      do {
-	i = nxt;
-	// if(scope[i-offset].is_range()) {
-	//   val = scope[i-offset].get_min();
-	//   if(lb>val) lb = val;
-	//   val = scope[i-offset].get_max();
-	//   if(ub<val) ub = val;
-	// } else {
-
-	
-
-	// std::cout << i << "-" << offset << " = " << (i-offset) << std::endl;
-
-	// std::cout << scope << std::endl;
-
-
-	scope[i-offset].union_to(aux_dom);
-	//}
-	nxt = scope[n].next(i);
-#ifdef _DEBUG_ELEMENT 
-	if(_DEBUG_ELEMENT) {
-	  std::cout << " + " << scope[i-offset] << " in " << scope[i-offset].get_domain() << ": " << aux_dom << std::endl; 
-	} 
-#endif
-      } while( i<nxt );
-      // if(lb<=ub) aux_dom.fill(lb,ub);
-      // std::cout << aux_dom << std::endl;
-      
-//       event_type[n+1] = scope[n+1].set_domain(aux_dom);
-//       if( FAILED(event_type[n+1]) ) { 
-// #ifdef _DEBUG_ELEMENT 
-// 	if(_DEBUG_ELEMENT) {
-// 	  std::cout << "  => FAIL" << std::endl;
-// 	} 
-// #endif
-// 	wiped = FAILURE(n+1);
-//       } else if( event_type[n+1] != NO_EVENT && !changes.contain(n+1) ) {
-// 	changes.add(n+1);
- #ifdef _DEBUG_ELEMENT 
- 	if(_DEBUG_ELEMENT) {
- 	  std::cout << "     " << scope[n+1] << " in " << scope[n+1].get_domain() << " = " << aux_dom << std::endl;
- 	} 
- #endif
-//       }
-
-      FILTER1(n+1, set_domain(aux_dom) );
-
- #ifdef _DEBUG_ELEMENT 
- 	if(_DEBUG_ELEMENT) {
- 	  std::cout << "  => " << scope[n+1] << " in " << scope[n+1].get_domain() << std::endl;
- 	} 
- #endif
-
-
-    }
-  }
-
+      }
+    }
+  } while( IS_OK(wiped) && !changes.empty() );
+
 #ifdef _DEBUG_ELEMENT 
   if(_DEBUG_ELEMENT) { 
     std::cout << "return " << wiped << std::endl;
@@ -14229,20 +15899,6 @@ Mistral::PropagationOutcome Mistral::PredicateElement::propagate()
   } 
 #endif 
 
-  //exit(1);
-
-
-  // if(!(IS_OK(wiped))) {
-
-  //   std::cout << "\nFAILURE " << offset << " (\n";
-  //   for(int i=0; i<n; ++i) {
-  //     std::cout << " " << scope[i] << " in " << scope[i].get_domain() << (scope[n].contain(i+offset) ? "*" : " ") << std::endl;
-  //   }
-  //   std::cout << ")[" << scope[n].get_domain() <<"] = " << scope[n+1].get_domain() << "\n";
-
-  // }
-
-
   return wiped;
 }
 
@@ -14292,6 +15948,70 @@ void Mistral::PredicateElement::weight_conflict(double unit, Vector<double>& wei
 }
 #endif
 
+void Mistral::PredicateElement::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+					      const int upper, const int v) {
+  int i, k, n = scope.size-2, lb, ub, vlb, vub;
+  Variable N = scope[n];
+  Variable V = scope[n+1];
+  bool ok = (x >= 0);
+
+  if(ok) {
+    lb = lcg->get_lb(N);
+    ub = lcg->get_ub(N);
+    vlb = lcg->get_lb(V);
+    vub = lcg->get_ub(V);
+
+    if(x == V.id()) {
+      // every X[i] that N can point to entails the bound
+      lcg->add_lb(N, lb);
+      lcg->add_ub(N, ub);
+      for(k=lb; ok && k<=ub; ++k) {
+	// holes in the domain of N are accounted for by the lazy clause base
+	if(N.get_min() < k && k < N.get_max() && !N.contain(k)) continue;
+	i = k-offset;
+	if(i < 0 || i >= n) ok = false;
+	else if(upper) {
+	  if(lcg->get_ub(scope[i]) <= v) lcg->add_ub(scope[i], v);
+	  else ok = false;
+	} else {
+	  if(lcg->get_lb(scope[i]) >= v) lcg->add_lb(scope[i], v);
+	  else ok = false;
+	}
+      }
+    } else if(x == N.id()) {
+      // the values of N skipped by the new bound point to an X[i] disjoint from V
+      if(upper) {
+	lcg->add_ub(N, ub);
+	lb = v+1;
+      } else {
+	lcg->add_lb(N, lb);
+	ub = v-1;
+      }
+      for(k=lb; ok && k<=ub; ++k) {
+	if(N.get_min() < k && k < N.get_max() && !N.contain(k)) continue;
+	i = k-offset;
+	if(i < 0 || i >= n) ok = false;
+	else if(lcg->get_ub(scope[i]) < vlb) {
+	  lcg->add_ub(scope[i], vlb-1);
+	  lcg->add_lb(V, vlb);
+	} else if(lcg->get_lb(scope[i]) > vub) {
+	  lcg->add_lb(scope[i], vub+1);
+	  lcg->add_ub(V, vub);
+	} else ok = false;
+      }
+    } else if(lb == ub && lb-offset >= 0 && lb-offset < n && x == scope[lb-offset].id()) {
+      // X[N] = V
+      lcg->add_lb(N, lb);
+      lcg->add_ub(N, lb);
+      if(upper && vub <= v) lcg->add_ub(V, v);
+      else if(!upper && vlb >= v) lcg->add_lb(V, v);
+      else ok = false;
+    } else ok = false;
+  }
+
+  if(!ok) ConstraintImplementation::explain_bound(lcg, x, upper, v);
+}
+
 std::ostream& Mistral::PredicateElement::display(std::ostream& os) const {
   os << "(" << scope[0]/*.get_var()*/;
   for(unsigned int i=1; i<scope.size-2; ++i) {
@@ -14302,8 +16022,151 @@ std::ostream& Mistral::PredicateElement::display(std::ostream& os) const {
 }
 
 
+// order on the indices of an array, by value then by index
+struct value_order {
+  const int *values;
+  value_order(const int *v) : values(v) {}
+  bool operator()(const int i, const int j) const {
+    return (values[i] == values[j] ? i < j : values[i] < values[j]);
+  }
+};
+
+Mistral::PredicateConstantElement::PredicateConstantElement(Vector< Variable >& scp, const Vector< int >& vals, const int o)
+  : GlobalConstraint(scp) {
+  values = vals;
+  offset = o;
+  priority = LINEAR_COST;
+}
+
+void Mistral::PredicateConstantElement::initialise() {
+  ConstraintImplementation::initialise();
+
+  trigger_on(_DOMAIN_, scope[0]);
+  trigger_on(_DOMAIN_, scope[1]);
+
+  GlobalConstraint::initialise();
+
+  scope[0].set_min(0+offset);
+  scope[0].set_max(values.size-1+offset);
+
+  // group the indices by value, in increasing order of the values
+  int i, r, n = values.size;
+  Vector< int > order;
+  for(i=0; i<n; ++i) order.add(i);
+  std::sort(order.begin(), order.end(), value_order(values.stack_));
+  for(i=0; i<n; ++i) {
+    if(!i || values[order[i]] != sorted_values.back()) {
+      sorted_values.add(values[order[i]]);
+      first.add(i);
+    }
+    indices.add(order[i]);
+  }
+  first.add(n);
+  for(r=0; r<(int)(sorted_values.size); ++r) residue.add(first[r]);
+
+  lb_rank.initialise(solver, 0);
+  ub_rank.initialise(solver, sorted_values.size-1);
+}
+
+void Mistral::PredicateConstantElement::mark_domain() {
+  for(int i=scope.size; i;)
+    get_solver()->forbid(scope[--i].id(), LIST_VAR);
+}
+
+Mistral::PredicateConstantElement::~PredicateConstantElement() 
+{ 
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete constant element predicate" << std::endl;
+#endif
+}
+
+Mistral::PropagationOutcome Mistral::PredicateConstantElement::propagate() 
+{
+  PropagationOutcome wiped = CONSISTENT;
+  int i, k, r, lb, ub, nxt;
+  Variable N = scope[0];
+  Variable V = scope[1];
+
+  // on the first call, both variables are considered changed
+  bool index_changed = changes.empty(), value_changed = changes.empty();
+
+  do {
+    while(!changes.empty()) {
+      if(changes.pop()) value_changed = true;
+      else index_changed = true;
+    }
+
+    // the ranks of the values within the bounds of V (binary search)
+    lb = std::lower_bound(sorted_values.begin()+lb_rank, sorted_values.begin()+ub_rank+1, V.get_min()) - sorted_values.begin();
+    ub = std::upper_bound(sorted_values.begin()+lb, sorted_values.begin()+ub_rank+1, V.get_max()) - sorted_values.begin() - 1;
+
+    // the indices of the ranks that left the bounds of V are removed from N
+    for(r=lb_rank; IS_OK(wiped) && r<lb; ++r) 
+      for(k=first[r]; IS_OK(wiped) && k<first[r+1]; ++k) {
+	FILTER1( 0, remove(indices[k]+offset) );
+      }
+    for(r=ub_rank; IS_OK(wiped) && r>ub; --r) 
+      for(k=first[r]; IS_OK(wiped) && k<first[r+1]; ++k) {
+	FILTER1( 0, remove(indices[k]+offset) );
+      }
+    if(!IS_OK(wiped)) break;
+
+    // the bounds of V must be supported by an index of N
+    while(lb <= ub && !supported(lb)) ++lb;
+    while(ub > lb && !supported(ub)) --ub;
+    if(lb > ub) {
+      wiped = FAILURE(1);
+      break;
+    }
+    if(lb_rank != lb) lb_rank = lb;
+    if(ub_rank != ub) ub_rank = ub;
+    FILTER1( 1, set_min(sorted_values[lb]) );
+    if(IS_OK(wiped)) {
+      FILTER1( 1, set_max(sorted_values[ub]) );
+    }
+
+    // interior values of V
+    if(IS_OK(wiped) && index_changed) {
+      for(r=lb+1; IS_OK(wiped) && r<ub; ++r) 
+	if(V.contain(sorted_values[r]) && !supported(r)) {
+	  FILTER1( 1, remove(sorted_values[r]) );
+	}
+    }
+
+    // interior values of N, when V has holes
+    if(IS_OK(wiped) && value_changed && !V.is_range()) {
+      nxt = N.get_min();
+      do {
+	i = nxt;
+	nxt = N.next(i);
+	if(!V.contain(values[i-offset])) {
+	  FILTER1( 0, remove(i) );
+	}
+      } while( IS_OK(wiped) && i<nxt );
+    }
+
+    index_changed = value_changed = false;
+  } while( IS_OK(wiped) && !changes.empty() );
+  return wiped;
+}
+
+int Mistral::PredicateConstantElement::check( const int* s ) const 
+{
+  return (values[s[0]-offset] != s[1]);
+}
+
+std::ostream& Mistral::PredicateConstantElement::display(std::ostream& os) const {
+  os << "(" << values[0];
+  for(unsigned int i=1; i<values.size; ++i) {
+    os << " " << values[i];
+  }
+  os << ")[" << scope[0]/*.get_var()*/ << "] == " << scope[1]/*.get_var()*/;
+  return os;
+}
+
+
 Mistral::ConstraintCliqueNotEqual::ConstraintCliqueNotEqual(Vector< Variable >& scp)
-  : GlobalConstraint(scp) { priority = 2; }
+  : GlobalConstraint(scp) { priority = LINEAR_COST; }
 
 
 void Mistral::ConstraintCliqueNotEqual::initialise() {
@@ -14532,7 +16395,7 @@ void Mistral::ConstraintCliqueNotEqual::weight_conflict(double unit, Vector<doub
  **********************************************/
 
 void Mistral::ConstraintMultiAtMostSeqCard::initialise_struct(const int k, const int d, const int* p, const int* q) {
-  priority = 0;  
+  priority = QUADRATIC_COST;  
 
   _k = k;
   _d = d;
@@ -15776,10 +17639,10 @@ const int CHANGES      = 1;
 const int NO_CHANGES   = 2;
 
 Mistral::ConstraintAllDiff::ConstraintAllDiff(Vector< Variable >& scp)
-  : GlobalConstraint(scp) { priority = 0; }
+  : GlobalConstraint(scp) { priority = QUADRATIC_COST; }
 
 Mistral::ConstraintAllDiff::ConstraintAllDiff(std::vector< Variable >& scp)
-  : GlobalConstraint(scp) { priority = 0; }
+  : GlobalConstraint(scp) { priority = QUADRATIC_COST; }
 
 
 void Mistral::ConstraintAllDiff::initialise() {
@@ -16115,6 +17978,53 @@ Mistral::PropagationOutcome Mistral::ConstraintAllDiff::propagate()
   return CONSISTENT;
 }
 
+static int increasing_value(const void *x, const void *y) {
+  return (*(int*)x > *(int*)y) - (*(int*)x < *(int*)y);
+}
+
+void Mistral::ConstraintAllDiff::explain_bound(ConstraintLazyClauseBase *lcg, const int x, 
+					       const int upper, const int v) {
+  int i, j=-1, k, a, b=0, n=scope.size;
+  bool found = false;
+  Vector< int > lo, up, ends;
+
+  for(i=0; i<n; ++i) {
+    lo.add(lcg->get_lb(scope[i]));
+    up.add(lcg->get_ub(scope[i]));
+    if(j<0 && x>=0 && scope[i].id() == x) j = i;
+  }
+
+  // look for a Hall interval [a,b] among the other variables that contains the 
+  // pruned values of x (or that is overloaded, for a failure)
+  for(k=0; !found && k<n; ++k) if(k != j) {
+      a = lo[k];
+      if(j >= 0 && (upper ? a > v+1 : a > lo[j])) continue;
+      ends.clear();
+      for(i=0; i<n; ++i) if(i != j && lo[i] >= a) ends.add(up[i]);
+      qsort(ends.stack_, ends.size, sizeof(int), increasing_value);
+      for(i=0; !found && i<(int)(ends.size); ++i) {
+	b = ends[i];
+	if(i+1 < (int)(ends.size) && ends[i+1] == b) continue;
+	if(j < 0) found = (i+1 > b-a+1);
+	else found = (i+1 >= b-a+1 && (upper ? b >= up[j] : b >= v-1));
+      }
+    }
+
+  if(found) {
+    a = lo[k-1];
+    for(i=0; i<n; ++i) if(i != j && lo[i] >= a && up[i] <= b) {
+	lcg->add_lb(scope[i], a);
+	lcg->add_ub(scope[i], b);
+      }
+    if(j >= 0) {
+      if(upper) lcg->add_ub(scope[j], b);
+      else lcg->add_lb(scope[j], a);
+    }
+  } else {
+    ConstraintImplementation::explain_bound(lcg, x, upper, v);
+  }
+}
+
 int Mistral::ConstraintAllDiff::check( const int* s ) const 
 {
   int i=scope.size, j;
@@ -16134,6 +18044,682 @@ std::ostream& Mistral::ConstraintAllDiff::display(std::ostream& os) const {
   return os;
 }
 
+Mistral::ConstraintAllDiffGAC::ConstraintAllDiffGAC(Vector< Variable >& scp)
+  : GlobalConstraint(scp) { priority = QUADRATIC_COST; }
+
+Mistral::ConstraintAllDiffGAC::ConstraintAllDiffGAC(std::vector< Variable >& scp)
+  : GlobalConstraint(scp) { priority = QUADRATIC_COST; }
+
+void Mistral::ConstraintAllDiffGAC::initialise() {
+  ConstraintImplementation::initialise();
+  for(unsigned int i=0; i<scope.size; ++i) {
+    trigger_on(_DOMAIN_, scope[i]);
+  }
+  GlobalConstraint::initialise();
+
+  int i, n = scope.size, maxval;
+  minval = scope[0].get_min();
+  maxval = scope[0].get_max();
+  for(i=1; i<n; ++i) {
+    if(minval > scope[i].get_min()) minval = scope[i].get_min();
+    if(maxval < scope[i].get_max()) maxval = scope[i].get_max();
+  }
+  num_values = maxval-minval+1;
+
+  var_match = new int[n];
+  std::fill(var_match, var_match+n, -1);
+  val_match = new int[num_values];
+  std::fill(val_match, val_match+num_values, -1);
+  reach_free = new int[num_values];
+
+  visited = new int[n];
+  std::fill(visited, visited+n, 0);
+  stamp = 0;
+
+  component = new int[n+num_values];
+  lowlink = new int[n+num_values];
+  order = new int[n+num_values];
+  next_edge.initialise(n+num_values, n+num_values);
+}
+
+void Mistral::ConstraintAllDiffGAC::mark_domain() {
+  for(unsigned int i=0; i<scope.size; ++i) {
+    get_solver()->forbid(scope[i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintAllDiffGAC::~ConstraintAllDiffGAC() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete alldiff-gac constraint" << std::endl;
+#endif
+  delete [] var_match;
+  delete [] val_match;
+  delete [] reach_free;
+  delete [] visited;
+  delete [] component;
+  delete [] lowlink;
+  delete [] order;
+}
+
+bool Mistral::ConstraintAllDiffGAC::augment(const int x) {
+  int v, vnext = scope[x].get_min(), y;
+  visited[x] = stamp;
+
+  // a free value ends the path
+  do {
+    v = vnext;
+    if(val_match[v-minval] < 0) {
+      var_match[x] = v-minval;
+      val_match[v-minval] = x;
+      return true;
+    }
+    vnext = scope[x].next(v);
+  } while( v < vnext );
+
+  // otherwise, try to re-match the variable that holds the value
+  vnext = scope[x].get_min();
+  do {
+    v = vnext;
+    y = val_match[v-minval];
+    if(visited[y] != stamp && augment(y)) {
+      var_match[x] = v-minval;
+      val_match[v-minval] = x;
+      return true;
+    }
+    vnext = scope[x].next(v);
+  } while( v < vnext );
+
+  return false;
+}
+
+void Mistral::ConstraintAllDiffGAC::compute_components() {
+  int n = scope.size, u, w, r, index = 0, num_components = 0;
+
+  // component[u] is -1 for unvisited nodes, and -2 while u is on the stack
+  for(u=0; u<n+num_values; ++u) component[u] = -1;
+
+  for(r=0; r<n; ++r) if(component[r] == -1) {
+      order[r] = lowlink[r] = index++;
+      component[r] = -2;
+      next_edge[r] = scope[r].get_min();
+      tarjan_stack.add(r);
+      call_stack.add(r);
+
+      while(!call_stack.empty()) {
+	u = call_stack.back();
+
+	// next successor of u
+	w = -1;
+	if(u < n) {
+	  // var -> value, out of the matching
+	  while(w < 0 && next_edge[u] != NOVAL) {
+	    int v = next_edge[u];
+	    next_edge[u] = (v < scope[u].get_max() ? scope[u].next(v) : NOVAL);
+	    if(v-minval != var_match[u]) w = n+v-minval;
+	  }
+	} else if(next_edge[u]) {
+	  // value -> var, in the matching
+	  next_edge[u] = 0;
+	  w = val_match[u-n];
+	}
+
+	if(w >= 0) {
+	  if(component[w] == -1) {
+	    order[w] = lowlink[w] = index++;
+	    component[w] = -2;
+	    next_edge[w] = (w < n ? scope[w].get_min() : 1);
+	    tarjan_stack.add(w);
+	    call_stack.add(w);
+	  } else if(component[w] == -2 && order[w] < lowlink[u]) {
+	    lowlink[u] = order[w];
+	  }
+	} else {
+	  call_stack.pop();
+	  if(!call_stack.empty() && lowlink[u] < lowlink[call_stack.back()]) 
+	    lowlink[call_stack.back()] = lowlink[u];
+	  if(lowlink[u] == order[u]) {
+	    do {
+	      w = tarjan_stack.pop();
+	      component[w] = num_components;
+	    } while(w != u);
+	    ++num_components;
+	  }
+	}
+      }
+    }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintAllDiffGAC::propagate() 
+{
+  int i, j, k, v, vnext, n = scope.size;
+  PropagationOutcome wiped = CONSISTENT;
+
+  // repair the matching
+  for(i=0; i<n; ++i) {
+    j = var_match[i];
+    if(j >= 0 && !scope[i].contain(j+minval)) {
+      val_match[j] = -1;
+      var_match[i] = -1;
+    }
+  }
+  for(i=0; i<n; ++i) {
+    if(var_match[i] < 0) {
+      ++stamp;
+      if(!augment(i)) return FAILURE(i);
+    }
+  }
+
+  // values from which a free value can be reached ('pruning' is used as a queue)
+  pruning.clear();
+  for(j=0; j<num_values; ++j) {
+    reach_free[j] = (val_match[j] < 0);
+    if(reach_free[j]) pruning.add(j);
+  }
+  for(k=0; k<(int)(pruning.size); ++k) {
+    j = pruning[k];
+    for(i=0; i<n; ++i) {
+      if(var_match[i] != j && !reach_free[var_match[i]] && scope[i].contain(j+minval)) {
+	reach_free[var_match[i]] = 1;
+	pruning.add(var_match[i]);
+      }
+    }
+  }
+
+  compute_components();
+
+  // the edges that belong to no alternating cycle or path are removed
+  pruning.clear();
+  for(i=0; i<n; ++i) {
+    vnext = scope[i].get_min();
+    do {
+      v = vnext;
+      j = v-minval;
+      if(j != var_match[i] && !reach_free[j] && component[i] != component[n+j]) {
+	pruning.add(i);
+	pruning.add(v);
+      }
+      vnext = scope[i].next(v);
+    } while( v < vnext );
+  }
+  for(k=0; IS_OK(wiped) && k<(int)(pruning.size); k+=2) {
+    if(FAILED(scope[pruning[k]].remove(pruning[k+1]))) wiped = FAILURE(pruning[k]);
+  }
+
+  return wiped;
+}
+
+int Mistral::ConstraintAllDiffGAC::check( const int* s ) const 
+{
+  int i=scope.size, j;
+  while(--i) {
+    j=i;
+    while(j--)
+      if( s[i] == s[j] ) return 1;
+  }
+  return 0; 
+}
+
+std::ostream& Mistral::ConstraintAllDiffGAC::display(std::ostream& os) const {
+  os << "alldiff-gac(" << scope[0];
+  for(unsigned int i=1; i<scope.size; ++i) 
+    os << ", " << scope[i];
+  os << ")" ;
+  return os;
+}
+
+
+Mistral::ConstraintCircuit::ConstraintCircuit(Vector< Variable >& scp)
+  : GlobalConstraint(scp) { 
+  priority = QUADRATIC_COST; 
+  successors = predecessors = children = NULL;
+  pred = idom = rank = preorder = last = NULL;
+}
+
+void Mistral::ConstraintCircuit::initialise() {
+  ConstraintImplementation::initialise();
+  for(unsigned int i=0; i<scope.size; ++i) {
+    trigger_on(_DOMAIN_, scope[i]);
+  }
+  GlobalConstraint::initialise();
+
+  int n = scope.size;
+  successors = new Vector< int >[n];
+  predecessors = new Vector< int >[n];
+  children = new Vector< int >[n];
+  pred = new int[n];
+  idom = new int[n];
+  rank = new int[n];
+  preorder = new int[n];
+  last = new int[n];
+  next_edge.initialise(n, n);
+}
+
+void Mistral::ConstraintCircuit::mark_domain() {
+  for(unsigned int i=0; i<scope.size; ++i) {
+    get_solver()->forbid(scope[i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintCircuit::~ConstraintCircuit() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete circuit constraint" << std::endl;
+#endif
+  delete [] successors;
+  delete [] predecessors;
+  delete [] children;
+  delete [] pred;
+  delete [] idom;
+  delete [] rank;
+  delete [] preorder;
+  delete [] last;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintCircuit::filter_chains(int& num_assigned) {
+  int i, j, k, s, e, v, vnext, length, n = scope.size;
+
+  num_assigned = 0;
+  std::fill(pred, pred+n, -1);
+  for(i=0; i<n; ++i) {
+    if(scope[i].is_ground()) {
+      j = scope[i].get_value();
+      if(pred[j] >= 0) return FAILURE(i);
+      pred[j] = i;
+      ++num_assigned;
+    }
+  }
+
+  pruning.clear();
+  if(num_assigned < n) {
+    // the values taken by the assigned successors
+    for(i=0; i<n; ++i) {
+      if(!scope[i].is_ground()) {
+	vnext = scope[i].get_min();
+	do {
+	  v = vnext;
+	  if(pred[v] >= 0) {
+	    pruning.add(i);
+	    pruning.add(v);
+	  }
+	  vnext = scope[i].next(v);
+	} while( v < vnext );
+      }
+    }
+
+    // the chains of assigned successors cannot be closed unless they go through every node
+    // ('rank' marks the nodes on a chain, the others assigned nodes are on a subtour)
+    std::fill(rank, rank+n, 0);
+    for(s=0; s<n; ++s) if(pred[s] < 0) {
+	e = s;
+	length = 1;
+	rank[e] = 1;
+	while(scope[e].is_ground()) {
+	  e = scope[e].get_value();
+	  rank[e] = 1;
+	  ++length;
+	}
+	if(length < n && scope[e].contain(s)) {
+	  pruning.add(e);
+	  pruning.add(s);
+	}
+      }
+    for(i=0; i<n; ++i) if(!rank[i]) return FAILURE(i);
+  } else {
+    for(i=scope[0].get_value(), k=1; i; i=scope[i].get_value()) ++k;
+    if(k < n) return FAILURE(0);
+  }
+
+  for(k=0; k<(int)(pruning.size); k+=2) {
+    if(FAILED(scope[pruning[k]].remove(pruning[k+1]))) return FAILURE(pruning[k]);
+  }
+
+  return CONSISTENT;
+}
+
+bool Mistral::ConstraintCircuit::compute_dominators(const bool reverse) {
+  int i, k, u, w, a, b, n = scope.size, changed = true;
+  Vector< int > *out = (reverse ? predecessors : successors);
+  Vector< int > *in = (reverse ? successors : predecessors);
+
+  // postorder numbering of a depth first search from node 0
+  ordering.clear();
+  std::fill(rank, rank+n, -1);
+  rank[0] = -2;
+  next_edge[0] = 0;
+  dfs_stack.add(0);
+  while(!dfs_stack.empty()) {
+    u = dfs_stack.back();
+    if(next_edge[u] < (int)(out[u].size)) {
+      w = out[u][next_edge[u]++];
+      if(rank[w] == -1) {
+	rank[w] = -2;
+	next_edge[w] = 0;
+	dfs_stack.add(w);
+      }
+    } else {
+      dfs_stack.pop();
+      rank[u] = ordering.size;
+      ordering.add(u);
+    }
+  }
+  if((int)(ordering.size) < n) return false;
+
+  // immediate dominators (Cooper, Harvey & Kennedy), in reverse postorder
+  std::fill(idom, idom+n, -1);
+  idom[0] = 0;
+  while(changed) {
+    changed = false;
+    for(k=n-1; --k>=0;) {
+      u = ordering[k];
+      w = -1;
+      for(i=in[u].size; --i>=0;) {
+	a = in[u][i];
+	if(idom[a] >= 0) {
+	  if(w < 0) w = a;
+	  else {
+	    b = w;
+	    while(a != b) {
+	      while(rank[a] < rank[b]) a = idom[a];
+	      while(rank[b] < rank[a]) b = idom[b];
+	    }
+	    w = a;
+	  }
+	}
+      }
+      if(idom[u] != w) {
+	idom[u] = w;
+	changed = true;
+      }
+    }
+  }
+
+  // preorder numbering of the dominator tree, last[u] is the highest number in the subtree of u
+  for(u=0; u<n; ++u) children[u].clear();
+  for(u=1; u<n; ++u) children[idom[u]].add(u);
+  k = 0;
+  preorder[0] = k++;
+  next_edge[0] = 0;
+  dfs_stack.add(0);
+  while(!dfs_stack.empty()) {
+    u = dfs_stack.back();
+    if(next_edge[u] < (int)(children[u].size)) {
+      w = children[u][next_edge[u]++];
+      preorder[w] = k++;
+      next_edge[w] = 0;
+      dfs_stack.add(w);
+    } else {
+      dfs_stack.pop();
+      last[u] = k-1;
+    }
+  }
+
+  return true;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintCircuit::propagate() 
+{
+  int i, j, k, v, vnext, num_assigned, n = scope.size;
+  PropagationOutcome wiped = CONSISTENT;
+
+  for(i=0; i<n; ++i) {
+    if(FAILED(scope[i].set_min(0)) || 
+       FAILED(scope[i].set_max(n-1)) || 
+       FAILED(scope[i].remove(i))) return FAILURE(i);
+  }
+
+  while(IS_OK(wiped)) {
+    wiped = filter_chains(num_assigned);
+    if(!IS_OK(wiped) || !pruning.empty()) continue;
+    if(num_assigned == n) break;
+
+    // the graph of the domains
+    for(i=0; i<n; ++i) {
+      successors[i].clear();
+      predecessors[i].clear();
+    }
+    for(i=0; i<n; ++i) {
+      vnext = scope[i].get_min();
+      do {
+	v = vnext;
+	successors[i].add(v);
+	predecessors[v].add(i);
+	vnext = scope[i].next(v);
+      } while( v < vnext );
+    }
+
+    // the tour from node 0 visits j before i if j dominates i, and i before j 
+    // if i dominates j in the reversed graph: the arc i -> j is then inconsistent
+    pruning.clear();
+    if(!compute_dominators(false)) return FAILURE(0);
+    for(i=1; i<n; ++i) {
+      for(k=successors[i].size; --k>=0;) {
+	j = successors[i][k];
+	if(j && dominates(j, i)) {
+	  pruning.add(i);
+	  pruning.add(j);
+	}
+      }
+    }
+    if(!compute_dominators(true)) return FAILURE(0);
+    for(i=1; i<n; ++i) {
+      for(k=successors[i].size; --k>=0;) {
+	j = successors[i][k];
+	if(dominates(i, j)) {
+	  pruning.add(i);
+	  pruning.add(j);
+	}
+      }
+    }
+    if(pruning.empty()) break;
+
+    for(k=0; IS_OK(wiped) && k<(int)(pruning.size); k+=2) {
+      if(FAILED(scope[pruning[k]].remove(pruning[k+1]))) wiped = FAILURE(pruning[k]);
+    }
+  }
+
+  return wiped;
+}
+
+int Mistral::ConstraintCircuit::check( const int* s ) const 
+{
+  int i=0, k=0, n=scope.size;
+  do {
+    if(s[i] < 0 || s[i] >= n) return 1;
+    i = s[i];
+    ++k;
+  } while(i && k < n);
+  return (i || k < n);
+}
+
+std::ostream& Mistral::ConstraintCircuit::display(std::ostream& os) const {
+  os << "circuit(" << scope[0];
+  for(unsigned int i=1; i<scope.size; ++i) 
+    os << ", " << scope[i];
+  os << ")" ;
+  return os;
+}
+
+
+Mistral::ConstraintWeightedCircuit::ConstraintWeightedCircuit(Vector< Variable >& scp, Vector< int >& wgt)
+  : GlobalConstraint(scp) { 
+  priority = CUBIC_COST; 
+  num_nodes = scope.size-1;
+  weight = new int*[num_nodes];
+  for(int i=0; i<num_nodes; ++i) {
+    weight[i] = new int[num_nodes];
+    for(int j=0; j<num_nodes; ++j) 
+      weight[i][j] = wgt[i*num_nodes+j];
+  }
+  row_dual = col_dual = col_match = slack = slack_row = NULL;
+  used = NULL;
+}
+
+Mistral::Constraint Mistral::ConstraintWeightedCircuit::clone() { 
+  Vector< int > wgt;
+  for(int i=0; i<num_nodes; ++i) 
+    for(int j=0; j<num_nodes; ++j) 
+      wgt.add(weight[i][j]);
+  return Constraint(new ConstraintWeightedCircuit(scope, wgt)); 
+}
+
+void Mistral::ConstraintWeightedCircuit::initialise() {
+  ConstraintImplementation::initialise();
+  for(int i=0; i<num_nodes; ++i) {
+    trigger_on(_DOMAIN_, scope[i]);
+  }
+  trigger_on(_RANGE_, scope[num_nodes]);
+  GlobalConstraint::initialise();
+
+  row_dual = new int[num_nodes+1];
+  col_dual = new int[num_nodes+1];
+  col_match = new int[num_nodes+1];
+  slack = new int[num_nodes+1];
+  slack_row = new int[num_nodes+1];
+  used = new bool[num_nodes+1];
+}
+
+void Mistral::ConstraintWeightedCircuit::mark_domain() {
+  for(int i=0; i<num_nodes; ++i) {
+    get_solver()->forbid(scope[i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintWeightedCircuit::~ConstraintWeightedCircuit() 
+{
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete weighted circuit constraint" << std::endl;
+#endif
+  for(int i=0; i<num_nodes; ++i) 
+    delete [] weight[i];
+  delete [] weight;
+  delete [] row_dual;
+  delete [] col_dual;
+  delete [] col_match;
+  delete [] slack;
+  delete [] slack_row;
+  delete [] used;
+}
+
+int Mistral::ConstraintWeightedCircuit::solve_assignment() {
+  // the rows are the successor variables and the columns the nodes, both 
+  // numbered from 1, col_match[j] is the row assigned to column j (0 if none)
+  int i, j, i0, j0, j1, delta, cur, n = num_nodes;
+
+  std::fill(row_dual, row_dual+n+1, 0);
+  std::fill(col_dual, col_dual+n+1, 0);
+  std::fill(col_match, col_match+n+1, 0);
+  for(i=1; i<=n; ++i) {
+    col_match[0] = i;
+    j0 = 0;
+    std::fill(slack, slack+n+1, INFTY);
+    std::fill(used, used+n+1, false);
+
+    // shortest augmenting path from row i, Dijkstra-like on the reduced costs
+    do {
+      used[j0] = true;
+      i0 = col_match[j0];
+      delta = INFTY;
+      j1 = 0;
+      for(j=1; j<=n; ++j) if(!used[j]) {
+	  if(scope[i0-1].contain(j-1)) {
+	    cur = weight[i0-1][j-1] - row_dual[i0] - col_dual[j];
+	    if(cur < slack[j]) {
+	      slack[j] = cur;
+	      slack_row[j] = j0;
+	    }
+	  }
+	  if(slack[j] < delta) {
+	    delta = slack[j];
+	    j1 = j;
+	  }
+	}
+      if(delta == INFTY) return INFTY;
+      for(j=0; j<=n; ++j) {
+	if(used[j]) {
+	  row_dual[col_match[j]] += delta;
+	  col_dual[j] -= delta;
+	} else if(slack[j] != INFTY) slack[j] -= delta;
+      }
+      j0 = j1;
+    } while(col_match[j0]);
+
+    do {
+      j1 = slack_row[j0];
+      col_match[j0] = col_match[j1];
+      j0 = j1;
+    } while(j0);
+  }
+
+  return -col_dual[0];
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintWeightedCircuit::propagate() 
+{
+  int i, k, v, vnext, lb, ub, max_weight, n = num_nodes;
+  Variable cost = scope[n];
+
+  for(i=0; i<n; ++i) {
+    if(FAILED(scope[i].set_min(0)) || 
+       FAILED(scope[i].set_max(n-1))) return FAILURE(i);
+  }
+
+  lb = solve_assignment();
+  if(lb == INFTY) return FAILURE(0);
+  if(FAILED(cost.set_min(lb))) return FAILURE(n);
+
+  // reduced cost filtering: the duals stay feasible when an arc is 
+  // removed, so the bound of the relaxation without it is at least lb + its reduced cost
+  pruning.clear();
+  for(i=0; i<n; ++i) {
+    vnext = scope[i].get_min();
+    do {
+      v = vnext;
+      if(lb + weight[i][v] - row_dual[i+1] - col_dual[v+1] > cost.get_max()) {
+	pruning.add(i);
+	pruning.add(v);
+      }
+      vnext = scope[i].next(v);
+    } while( v < vnext );
+  }
+  for(k=0; k<(int)(pruning.size); k+=2) {
+    if(FAILED(scope[pruning[k]].remove(pruning[k+1]))) return FAILURE(pruning[k]);
+  }
+
+  ub = 0;
+  for(i=0; i<n; ++i) {
+    vnext = scope[i].get_min();
+    max_weight = weight[i][vnext];
+    do {
+      v = vnext;
+      if(max_weight < weight[i][v]) max_weight = weight[i][v];
+      vnext = scope[i].next(v);
+    } while( v < vnext );
+    ub += max_weight;
+  }
+  if(FAILED(cost.set_max(ub))) return FAILURE(n);
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintWeightedCircuit::check( const int* s ) const 
+{
+  int i, total = 0;
+  for(i=0; i<num_nodes; ++i) {
+    if(s[i] < 0 || s[i] >= num_nodes) return 1;
+    total += weight[i][s[i]];
+  }
+  return (total != s[num_nodes]);
+}
+
+std::ostream& Mistral::ConstraintWeightedCircuit::display(std::ostream& os) const {
+  os << "weighted-circuit(" << scope[0];
+  for(int i=1; i<num_nodes; ++i) 
+    os << ", " << scope[i];
+  os << " | " << scope[num_nodes] << ")" ;
+  return os;
+}
+
 #ifdef _ALLDIFF_WC
 void Mistral::ConstraintAllDiff::weight_conflict(double unit, Vector<double>& weights)  {
   //std::cout << "\nWEIGHT AFTER FAILURE ON ALLDIFF " << expl_note << "\n";
@@ -16263,7 +18849,7 @@ void Mistral::ConstraintAllDiff::print_structs() {
 
 Mistral::PredicateVertexCover::PredicateVertexCover(Mistral::Vector< Variable >& scp, Graph& g) 
 : _G(g), GlobalConstraint(scp) { 	
-	priority = 1; 
+	priority = LINEAR_COST; 
 }
 
 Mistral::PredicateVertexCover::~PredicateVertexCover() {
@@ -16361,7 +18947,7 @@ std::ostream& Mistral::PredicateVertexCover::display(std::ostream& os) const {
 
 Mistral::PredicateFootrule::PredicateFootrule(Mistral::Vector< Variable >& scp) 
 : GlobalConstraint(scp) { 	
-	priority = 1;
+	priority = LINEAR_COST;
 	N = scope.size/2;
 	uncorrelated_distance = N*N/4;
 	init_prop = true;
@@ -16932,7 +19518,7 @@ std::ostream& Mistral::PredicateFootrule::display(std::ostream& os) const {
 
 
 
-Mistral::PredicateMin::PredicateMin(Vector< Variable >& scp) : GlobalConstraint(scp) { priority = 1; }
+Mistral::PredicateMin::PredicateMin(Vector< Variable >& scp) : GlobalConstraint(scp) { priority = LINEAR_COST; }
 
 Mistral::PredicateMin::~PredicateMin() {
 #ifdef _DEBUG_MEMORY
@@ -17577,7 +20163,7 @@ std::ostream& Mistral::PredicateMin::display(std::ostream& os) const {
 
 
 
-Mistral::PredicateMax::PredicateMax(Vector< Variable >& scp) : GlobalConstraint(scp) { priority = 1; }
+Mistral::PredicateMax::PredicateMax(Vector< Variable >& scp) : GlobalConstraint(scp) { priority = LINEAR_COST; }
 
 Mistral::PredicateMax::~PredicateMax() {
 #ifdef _DEBUG_MEMORY
@@ -19460,7 +22046,7 @@ ConstraintOccurrences::ConstraintOccurrences(Vector< Variable >& scp,
 					     const int* minOccurrences,
 					     const int* maxOccurrences )
   : GlobalConstraint(scp) { 
-  priority = 0; 
+  priority = CUBIC_COST; 
   
   int range = lastDomainValue - firstDomainValue + 1;
   l = initializePartialSum(firstDomainValue, range, minOccurrences);
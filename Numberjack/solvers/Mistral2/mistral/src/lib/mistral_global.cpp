@@ -37,6 +37,12 @@
 #include <sstream>
 #include <cstring>
 
+#ifdef _UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 /*************** TIMING AND MEMORY USAGE ROUTINES, FROM MINISAT ******/
 #define __STDC_FORMAT_MACROS
@@ -369,6 +375,95 @@ void Mistral::get_command_line(const char** int_ident,
 }
 
 
+/**********************************************
+ * Input file
+ *********************************************/
+
+#define INPUT_BUFFER_SIZE 1048576
+
+Mistral::InputFile::InputFile(const char* filename) {
+  cur = end = NULL;
+  stream = NULL;
+  piped = false;
+  buffer = NULL;
+  map = NULL;
+  map_size = 0;
+
+  size_t len = strlen(filename);
+  const char *decompressor = NULL;
+  if(len > 3 && !strcmp(filename+len-3, ".gz")) decompressor = "gzip";
+  else if(len > 3 && !strcmp(filename+len-3, ".xz")) decompressor = "xz";
+
+  if(decompressor) {
+#ifdef _UNIX
+    // the file must exist, otherwise the error would only come from the shell
+    if(access(filename, R_OK)) return;
+    std::string command(decompressor);
+    command += " -dc '";
+    for(const char *c=filename; *c; ++c) {
+      if(*c == '\'') command += "'\\''";
+      else command += *c;
+    }
+    command += "'";
+    stream = popen(command.c_str(), "r");
+    piped = true;
+#endif
+  } else {
+#ifdef _UNIX
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return;
+    struct stat st;
+    if(!fstat(fd, &st) && S_ISREG(st.st_mode)) {
+      if(st.st_size > 0) {
+	void *mem = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if(mem != MAP_FAILED) {
+	  map = (char*)mem;
+	  map_size = st.st_size;
+#ifdef MADV_SEQUENTIAL
+	  madvise(mem, map_size, MADV_SEQUENTIAL);
+#endif
+	  cur = map;
+	  end = map + map_size;
+	}
+      }
+    }
+    close(fd);
+    if(map) return;
+#endif
+    stream = fopen(filename, "r");
+  }
+
+  if(stream) buffer = (char*)malloc(INPUT_BUFFER_SIZE);
+}
+
+Mistral::InputFile::~InputFile() {
+#ifdef _UNIX
+  if(map) munmap(map, map_size);
+  if(stream && piped) pclose(stream);
+#endif
+  if(stream && !piped) fclose(stream);
+  free(buffer);
+}
+
+bool Mistral::InputFile::refill() {
+  if(!stream) return false;
+  size_t n = fread(buffer, 1, INPUT_BUFFER_SIZE, stream);
+  cur = buffer;
+  end = buffer + n;
+  return n > 0;
+}
+
+void Mistral::InputFile::read_word(std::string& word) {
+  word.clear();
+  skip_blanks();
+  int c;
+  while((c = peek()) != EOF && c != ' ' && (unsigned int)(c - '\t') >= 5) {
+    word += (char)c;
+    ++cur;
+  }
+}
+
+
 int Mistral::log2_( const unsigned int v ) {
 //   union {float f; unsigned int i; } t;
 //   unsigned int b = v & -v;
@@ -313,25 +313,29 @@ void SatSolver::init_watchers()
 
 void SatSolver::parse_dimacs(const char* filename) 
 {
-  unsigned int LARGENUMBER = 131072;
-  ifstream infile( filename );
-  char c=' ';
+  InputFile input( filename );
   string word;
   int N, M, l=0, lit, cs;
 
+  if(!input.is_open()) {
+    cerr << "Error: cannot read " << filename << endl;
+    exit(1);
+  }
+
   // skip comments
-  infile >> c;
-  while( c != 'p' ) {
-    infile.ignore( LARGENUMBER, '\n' );
-    infile >> c;
+  input.skip_blanks();
+  while( input.peek() != 'p' && input.peek() != EOF ) {
+    input.skip_line();
+    input.skip_blanks();
   }
 
-  infile >> word;
+  input.get();
+  input.read_word(word);
   assert( word == "cnf" );
   
   // get number of atoms and clauses
-  infile >> N;
-  infile >> M;
+  N = input.read_int();
+  M = input.read_int();
 
   //init(N, M);
   init_vars(N, M);
@@ -340,14 +344,11 @@ void SatSolver::parse_dimacs(const char* filename)
   for(int i=0; i<M; ++i)
     {
       learnt_clause.clear();
-      do {
-	infile >> l;
-	if(l!=0) {
-	  if(l>0) lit = (l-1)*2+1;
-	  else lit = (l+1)*-2;
-	  learnt_clause.add(lit);
-	}
-      } while(l && infile.good());
+      while( (l = input.read_int()) ) {
+	if(l>0) lit = (l-1)*2+1;
+	else lit = (l+1)*-2;
+	learnt_clause.add(lit);
+      }
 
 
       if(params.init_activity == 1) {
@@ -400,10 +401,108 @@ int SatSolver::check_solution()
 
 
 
+#define ARENA_BLOCK_SIZE 1048576
+
+Mistral::ClauseArena::ClauseArena() {
+  used = 0;
+  capacity = 0;
+  allocated = 0;
+  wasted = 0;
+}
+
+Mistral::ClauseArena::~ClauseArena() {
+  release();
+}
+
+void Mistral::ClauseArena::release() {
+  for(unsigned int i=0; i<blocks.size; ++i) {
+    free(blocks[i]);
+  }
+  blocks.clear();
+  block_size.clear();
+  used = 0;
+  capacity = 0;
+  allocated = 0;
+  wasted = 0;
+}
+
+void Mistral::ClauseArena::swap(ClauseArena& a) {
+  std::swap(blocks.stack_, a.blocks.stack_);
+  std::swap(blocks.size, a.blocks.size);
+  std::swap(blocks.capacity, a.blocks.capacity);
+  std::swap(block_size.stack_, a.block_size.stack_);
+  std::swap(block_size.size, a.block_size.size);
+  std::swap(block_size.capacity, a.block_size.capacity);
+  std::swap(used, a.used);
+  std::swap(capacity, a.capacity);
+  std::swap(allocated, a.allocated);
+  std::swap(wasted, a.wasted);
+}
+
+Mistral::Clause* Mistral::ClauseArena::allocate(const Vector< Literal >& lits, const bool learnt) {
+  return allocate(lits.stack_, lits.size, learnt);
+}
+
+void Mistral::ClauseArena::reserve(const size_t n) {
+  if(used + n > capacity) {
+    // the remainder of the current block is lost
+    capacity = (n > ARENA_BLOCK_SIZE ? n : ARENA_BLOCK_SIZE);
+    blocks.add((char*)malloc(capacity));
+    block_size.add(capacity);
+    used = 0;
+  }
+}
+
+Mistral::Clause* Mistral::ClauseArena::allocate(const Literal* lits, const unsigned int size, const bool learnt) {
+  size_t n = footprint(size);
+
+  reserve(n);
+
+  char *mem = blocks.back()+used;
+  used += n;
+  allocated += n;
+
+  ClauseInfo *info = (ClauseInfo*)mem;
+  info->activity = 0;
+  info->lbd = size;
+  info->tier = LOCAL_TIER;
+  info->learnt = learnt;
+  info->used = 0;
+  info->deleted = 0;
+  info->relocated = 0;
+
+  return new (mem+sizeof(ClauseInfo)) Clause(lits, size);
+}
+
+void Mistral::ClauseArena::free_clause(Clause* cl) {
+  info(cl)->deleted = 1;
+  wasted += footprint(cl->size);
+}
+
+bool Mistral::ClauseArena::contain(const void* ptr) const {
+  const char *p = (const char*)ptr;
+  for(unsigned int i=0; i<blocks.size; ++i) {
+    if(p >= blocks[i] && p < blocks[i]+block_size[i]) return true;
+  }
+  return false;
+}
+
+std::ostream& Mistral::operator<< (std::ostream& os, const Mistral::Watcher& x) {
+  print_clause(os, x.clause);
+  os << "/";
+  print_literal(os, x.blocker);
+  return os;
+}
+
+
 Mistral::ConstraintClauseBase::ConstraintClauseBase(Vector< Variable >& scp) 
   : GlobalConstraint(scp) { 
   conflict = NULL;
-  priority = 1;
+  priority = LINEAR_COST;
+  clause_increment = 1;
+  num_reductions = 0;
+  next_reduction = 0;
+  lbd_stamp = 0;
 }
 
 void Mistral::ConstraintClauseBase::mark_domain() {
@@ -448,12 +547,7 @@ void Mistral::ConstraintClauseBase::initialise() {
 }
 
 Mistral::ConstraintClauseBase::~ConstraintClauseBase() {
-  for(unsigned int i=0; i<clauses.size; ++i) {
-    free(clauses[i]);
-  }
-  for(unsigned int i=0; i<learnt.size; ++i) {
-    free(learnt[i]);
-  }
+  // the clauses are released with the arena
 }
 
 void Mistral::ConstraintClauseBase::add(Variable x) {
@@ -491,10 +585,10 @@ void Mistral::ConstraintClauseBase::add(Variable x) {
 
 void Mistral::ConstraintClauseBase::add( Vector < Literal >& clause, double activity_increment ) {
  if(clause.size > 1) {
-   Clause *cl = (Clause*)(Clause::Array_new(clause));
+   Clause *cl = arena.allocate(clause, false);
    clauses.add( cl );
-   is_watched_by[clause[0]].add(cl);
-   is_watched_by[clause[1]].add(cl);
+   is_watched_by[clause[0]].add(Watcher(cl, clause[1]));
+   is_watched_by[clause[1]].add(Watcher(cl, clause[0]));
 
    // // should we split the increment?
    // activity_increment /= clause.size;
@@ -515,9 +609,57 @@ void Mistral::ConstraintClauseBase::add( Vector < Literal >& clause, double acti
  }
 }
 
+void Mistral::ConstraintClauseBase::add( Vector < Literal >& lits, Vector < unsigned int >& ends ) {
+  unsigned int i, j, n, num_lits = 2*scope.size;
+  size_t mem = 0;
+  Vector< unsigned int > num_watchers;
+  num_watchers.initialise(num_lits, num_lits, 0);
+
+  // count the new watchers of each literal, and the memory needed by the clauses
+  for(i=0, j=0; i<ends.size; j=ends[i++]) {
+    n = ends[i]-j;
+    if(n > 1) {
+      mem += ClauseArena::footprint(n);
+      ++num_watchers[lits[j]];
+      ++num_watchers[lits[j+1]];
+    }
+  }
+
+  // the lists grow at least geometrically, since the clauses may come in several batches
+  for(i=0; i<num_lits; ++i) {
+    Vector< Watcher >& watch_list = is_watched_by[i];
+    if(watch_list.size + num_watchers[i] > watch_list.capacity)
+      watch_list.extendStack(std::max(watch_list.size + num_watchers[i] - watch_list.capacity, watch_list.capacity));
+  }
+  arena.reserve(mem);
+  if(clauses.size + ends.size > clauses.capacity)
+    clauses.extendStack(std::max(clauses.size + ends.size - clauses.capacity, clauses.capacity));
+
+  for(i=0, j=0; i<ends.size; j=ends[i++]) {
+    n = ends[i]-j;
+    if(n > 1) {
+      Clause *cl = arena.allocate(lits.stack_+j, n, false);
+      clauses.add( cl );
+      is_watched_by[lits[j]].add(Watcher(cl, lits[j+1]));
+      is_watched_by[lits[j+1]].add(Watcher(cl, lits[j]));
+    } else if(n) {
+      scope[UNSIGNED(lits[j])].set_domain(SIGN(lits[j]));
+    }
+  }
+}
+
 void Mistral::ConstraintClauseBase::learn( Vector < Literal >& clause, double activity_increment ) {
  if(clause.size > 1) {
-   Clause *cl = (Clause*)(Clause::Array_new(clause));
+   Clause *cl = arena.allocate(clause, true);
+   ClauseInfo *info = ClauseArena::info(cl);
+   SolverParameters& params = get_solver()->parameters;
+
+   info->lbd = compute_lbd(clause.stack_, clause.size);
+   info->tier = (info->lbd <= (unsigned int)(params.lbd_core) ? CORE_TIER :
+		 (info->lbd <= (unsigned int)(params.lbd_mid) ? MID_TIER : LOCAL_TIER));
+   info->activity = clause_increment;
+   decay_clause_activity();
+
    learnt.add( cl );
 
    // // should we split the increment?
@@ -531,8 +673,8 @@ void Mistral::ConstraintClauseBase::learn( Vector < Literal >& clause, double ac
    //   }
    // }
 
-   is_watched_by[clause[0]].add(cl);
-   is_watched_by[clause[1]].add(cl);
+   is_watched_by[clause[0]].add(Watcher(cl, clause[1]));
+   is_watched_by[clause[1]].add(Watcher(cl, clause[0]));
  } else {
    scope[UNSIGNED(clause[0])].set_domain(SIGN(clause[0]));
  }
@@ -604,7 +746,7 @@ Mistral::PropagationOutcome Mistral::ConstraintClauseBase::propagate() {
   PropagationOutcome wiped = CONSISTENT;
 
   int x, v, cw;
-  Literal p;
+  Literal p, b;
 
   while( !conflict && !changes.empty() ) {
     x = changes.pop();
@@ -620,6 +762,10 @@ Mistral::PropagationOutcome Mistral::ConstraintClauseBase::propagate() {
 
     cw = is_watched_by[p].size;
     while(cw-- && !conflict) {
+      // the clause is satisfied by its blocker, no need to look at it
+      b = is_watched_by[p][cw].blocker;
+      if(*(scope[UNSIGNED(b)].bool_domain) == (int)SIGN(b)+1) continue;
+
       conflict = update_watcher(cw, p, wiped);
     }
   }
@@ -688,7 +834,7 @@ Mistral::Clause* Mistral::ConstraintClauseBase::update_watcher(const int cw,
 							       const Literal p,
 							       PropagationOutcome& po)
 {
-  Clause *cl = is_watched_by[p][cw];
+  Clause *cl = is_watched_by[p][cw].clause;
   Clause& clause = *cl;
   unsigned int j;
 
@@ -738,7 +884,7 @@ Mistral::Clause* Mistral::ConstraintClauseBase::update_watcher(const int cw,
 	clause[1] = r;
 	clause[j] = p;
 	is_watched_by[p].remove(cw);
-	is_watched_by[r].add(cl);
+	is_watched_by[r].add(Watcher(cl, q));
 
 #ifdef _DEBUG_WATCH
 	std::cout << "    ok!" // << clause << " " << (cl)
@@ -758,7 +904,7 @@ Mistral::Clause* Mistral::ConstraintClauseBase::update_watcher(const int cw,
 	clause[1] = r;
 	clause[j] = p;
 	is_watched_by[p].remove(cw);
-	is_watched_by[r].add(cl);
+	is_watched_by[r].add(Watcher(cl, q));
 
 	break;
       }
@@ -802,6 +948,9 @@ Mistral::Clause* Mistral::ConstraintClauseBase::update_watcher(const int cw,
 	    return cl;
 	  }
       }
+  } else {
+    // the clause is satisfied by q, which becomes the blocker
+    is_watched_by[p][cw].blocker = q;
   }
 
   return NULL;
@@ -810,159 +959,229 @@ Mistral::Clause* Mistral::ConstraintClauseBase::update_watcher(const int cw,
 void Mistral::ConstraintClauseBase::remove( const int cidx )
 {
   Clause *clause = learnt[cidx];
+  Watcher w(clause, 0);
 
   // std::cout << "forget " ;
   // print_clause(std::cout, clause);
   // std::cout << std::endl;
 
-
-  is_watched_by[clause->data[0]].remove_elt( clause );
-  is_watched_by[clause->data[1]].remove_elt( clause );
+  is_watched_by[clause->data[0]].remove_elt( w );
+  is_watched_by[clause->data[1]].remove_elt( w );
   learnt.remove( cidx );
 
-  free(clause);
+  arena.free_clause(clause);
 }
 
-//#define _DEBUG_FORGET true
 
+unsigned int Mistral::ConstraintClauseBase::compute_lbd( const Literal* lits, const unsigned int n ) {
+  int *level = get_solver()->assignment_level.stack_;
+  unsigned int lbd = 0, i, l;
 
-int Mistral::ConstraintClauseBase::forget(const double forgetfulness, 
-					  const double *var_activity,
-					  const double *lit_activity
-					  //const Vector< double >& lit_activity
-					  )
-{
+  if(!++lbd_stamp) {
+    // the stamp wrapped around
+    for(i=0; i<level_stamp.size; ++i) level_stamp[i] = 0;
+    lbd_stamp = 1;
+  }
 
-  int removed = 0;
-  int * solution = get_solver()->last_solution_lb.stack_;
+  for(i=0; i<n; ++i) {
+    l = level[UNSIGNED(lits[i])];
+    while(level_stamp.size <= l) level_stamp.add(0);
+    if(level_stamp[l] != lbd_stamp) {
+      level_stamp[l] = lbd_stamp;
+      ++lbd;
+    }
+  }
 
+  return lbd;
+}
 
-  int nlearnt = learnt.size;
-  int keep=1;
-  int i=0;
-  Atom a;
-  
+void Mistral::ConstraintClauseBase::bump( Clause* cl ) {
+  if(!cl) return;
 
-  if( forgetfulness > 0.0 ) {
-    // int nlearnt = learnt.size;
-    double sa[nlearnt];
-    Clause *tmp[nlearnt];
-    int j, order[nlearnt], real_size;
-    initSort(&(sa[0]));
-    for(i=0; i<nlearnt; ++i)
-      {
-	order[i] = i;
-	if(lit_activity) {
-	  sa[i] = 0.0;
-	  Clause& clause = *(learnt[i]);
-	  real_size = j = clause.size;
-	  while(j--) // THE ACTIVITY OF A LITERAL IS A MEASURE OF HOW MUCH IT IS "WANTED" BY THE FORMULA - SHORT CLAUSE WITH UNWANTED LITERALS ARE THEREFORE GOOD
-	    {
-	      a = UNSIGNED(clause[j]);
-	      // real_size is the number of free literal in hte clause.
-	      // For correcteness, we need to not forget any clause that currently explains a literal.
-	      // It seems like a good idea to keep clauses with small real size anyway (they matter the most right now)
-	      //if(scope[UNSIGNED(clause[j])].is_ground()) --real_size;
-	      if(solution[a] != -INFTY && solution[a] != (int)(SIGN(clause[j]))) --real_size;
-	      //else 
-	      sa[i] += (var_activity[a] + lit_activity[NOT(clause[j])]);
-	    }
-	  // if(real_size) {
-	  //   sa[i] /= (double)(real_size);
-	  //   sa[i] /= (double)(clause.size *clause.size);
-	  // //(real_size * real_size); //
-	  // //(clause.size * clause.size);
-	  // }
-	  // else
-	  //   sa[i] = INFTY;
-	  sa[i] /= (double)((real_size+1) *clause.size *clause.size);
-	  //sa[i] /= (double)(clause.size *clause.size *clause.size);
-	} else {
-	  sa[i] = 1.0/(double)(learnt[i]->size);
-	}
-      }
+  ClauseInfo *info = ClauseArena::info(cl);
+  if(info->learnt) {
+    info->used = 1;
 
-    keep = (int)((double)nlearnt * (1.0-forgetfulness));
-
-    if(lit_activity)
-      qsort(order, nlearnt, sizeof(int), compar);
-    else {
-      int swap;
-      for(i=0; i<keep; ++i) {
-	j = i + randint(nlearnt-i);
-	swap = order[i];
-	order[i] = order[j];
-	order[j] = swap;
-      }
+    if((info->activity += clause_increment) > 1e20) {
+      // rescale to avoid overflows
+      for(unsigned int i=0; i<learnt.size; ++i)
+	ClauseArena::info(learnt[i])->activity *= 1e-20;
+      clause_increment *= 1e-20;
     }
 
-    for(i=0; i<nlearnt; ++i)
-      tmp[i] = learnt[order[i]]; 
-    for(i=0; i<nlearnt; ++i) {
-      learnt[i] = tmp[i];
+    if(info->tier != CORE_TIER) {
+      // the lbd may only improve, and the clause may only move up the tiers
+      unsigned int lbd = compute_lbd(cl->data, cl->size);
+      if(lbd < info->lbd) {
+	SolverParameters& params = get_solver()->parameters;
+	info->lbd = lbd;
+	if(lbd <= (unsigned int)(params.lbd_core)) info->tier = CORE_TIER;
+	else if(lbd <= (unsigned int)(params.lbd_mid)) info->tier = MID_TIER;
+      }
     }
-    
+  }
+}
 
-#ifdef _DEBUG_FORGET
-    //bool weird = true;
-    for(i=nlearnt; --i>=0;) {
-      double weight = 0;
-      Clause& clause = *(learnt[i]);
-      real_size = j = clause.size;
-      while(j--)
-	{
-	  a = UNSIGNED(clause[j]);
-	  if(solution[a] != -INFTY && solution[a] != (int)(SIGN(clause[j]))) --real_size;
-	  // else 
-	  weight += lit_activity[NOT(clause[j])];
-	}
+void Mistral::ConstraintClauseBase::decay_clause_activity() {
+  clause_increment /= .999;
+}
 
-      std::cout << setw(3) << i << ": " << learnt[i]->size << " " << real_size << " " << sa[order[i]] << "/" << weight/(double)((real_size+1) * clause.size * clause.size) << std::endl;
-      if(i==keep) std::cout << "=================================\n";
+bool Mistral::ConstraintClauseBase::locked( Clause* cl ) {
+  Solver *s = get_solver();
+  Atom a;
 
-      // if(weird && i<keep && i && sa[order[i]] != sa[order[i-1]]) {
-      // 	std::cout << "=================================\n";
-      // 	weird = false;
-      // }
+  if((void*)cl == (void*)(s->taboo_constraint)) return true;
+  for(int i=0; i<2; ++i) {
+    a = UNSIGNED(cl->data[i]);
+    if(scope[a].is_ground() && (reason_for[a] == cl || s->reason_for[a] == cl)) return true;
+  }
+  return false;
+}
+
+// (is_watched_by and reason_for are indexed beyond their size, hence the loops up to the capacity)
+void Mistral::ConstraintClauseBase::detach_deleted() {
+  Solver *s = get_solver();
+  unsigned int i, j, k;
+  Explanation *e;
+
+  for(i=0; i<is_watched_by.capacity; ++i) {
+    Vector< Watcher >& watchers = is_watched_by[i];
+    for(j=0, k=0; j<watchers.size; ++j) {
+      if(!ClauseArena::info(watchers[j].clause)->deleted) watchers[k++] = watchers[j];
     }
-#endif
+    watchers.size = k;
+  }
+
+  for(i=0; i<reason_for.capacity; ++i) {
+    if(reason_for[i] && ClauseArena::info(reason_for[i])->deleted) reason_for[i] = NULL;
+  }
+
+  // the solver may refer to learnt clauses directly
+  for(i=0; i<s->reason_for.size; ++i) {
+    e = s->reason_for[i];
+    if(e && arena.contain(e) && ClauseArena::info((Clause*)e)->deleted) s->reason_for[i] = NULL;
+  }
+}
 
+// returns the new address of a clause (it must have been relocated)
+static inline Mistral::Clause* relocated_address(Mistral::Clause* cl) {
+  return (Mistral::ClauseArena::info(cl)->relocated ? *((Mistral::Clause**)cl) : cl);
+}
 
-    for(i=nlearnt; i>keep && sa[order[i-1]] != INFTY;) {
-      removed += learnt[i-1]->size;
-      remove( --i );
+void Mistral::ConstraintClauseBase::collect() {
+  Solver *s = get_solver();
+  ClauseArena to;
+  unsigned int i, j;
+  Explanation *e;
+
+  // copy the live clauses, and leave a forwarding address behind
+  for(int l=0; l<2; ++l) {
+    Vector< Clause* >& list = (l ? learnt : clauses);
+    for(i=0; i<list.size; ++i) {
+      Clause *cl = list[i];
+      ClauseInfo *info = ClauseArena::info(cl);
+
+      lit_buffer.clear();
+      for(j=0; j<cl->size; ++j) lit_buffer.add(cl->data[j]);
+
+      Clause *copy = to.allocate(lit_buffer, info->learnt);
+      ClauseInfo *copy_info = ClauseArena::info(copy);
+      copy_info->activity = info->activity;
+      copy_info->lbd = info->lbd;
+      copy_info->tier = info->tier;
+      copy_info->used = info->used;
+
+      info->relocated = 1;
+      *((Clause**)cl) = copy;
+      list[i] = copy;
     }
+  }
 
-    
-    // /// PIECE OF CODE THAT I CAN'T UNDERSTAND!!!!
-    // while(i>1 && sa[order[i-1]] != INFTY) {
-    //   --i;
-    //   if(sa[order[i]] == sa[order[i-1]]) {
-	
-    // 	// std::cout << "REMOVE  ";
-    // 	// print_clause(std::cout, learnt[i]) ;
-    // 	// std::cout << "\nBECAUSE ";
-    // 	// print_clause(std::cout, learnt[i-1]) ;
-    // 	// std::cout << std::endl;
+  // relocate the references
+  for(i=0; i<is_watched_by.capacity; ++i) {
+    Vector< Watcher >& watchers = is_watched_by[i];
+    for(j=0; j<watchers.size; ++j)
+      watchers[j].clause = relocated_address(watchers[j].clause);
+  }
+  for(i=0; i<reason_for.capacity; ++i) {
+    if(reason_for[i]) reason_for[i] = relocated_address(reason_for[i]);
+  }
+  for(i=0; i<s->reason_for.size; ++i) {
+    e = s->reason_for[i];
+    if(e && arena.contain(e)) s->reason_for[i] = relocated_address((Clause*)e);
+  }
+  if(s->taboo_constraint && arena.contain(s->taboo_constraint))
+    s->taboo_constraint = (ConstraintImplementation*)(relocated_address((Clause*)(s->taboo_constraint)));
+  conflict = NULL;
 
-    // 	avg_rem2_size += learnt[i]->size;
+  // the old blocks are released with 'to'
+  arena.swap(to);
+}
 
-    // 	removed += learnt[i]->size;
-    // 	remove( i );
-    //   }
-    // }
 
-    // for(int kk=i; kk; ) {
+//#define _DEBUG_FORGET true
+
+static int less_active(const void *x, const void *y) {
+  float ax = Mistral::ClauseArena::info(*(Mistral::Clause**)x)->activity;
+  float ay = Mistral::ClauseArena::info(*(Mistral::Clause**)y)->activity;
+  return (ax < ay ? -1 : (ax > ay ? 1 : 0));
+}
+
+int Mistral::ConstraintClauseBase::forget( const double forgetfulness )
+{
+  Solver *s = get_solver();
+  SolverParameters& params = s->parameters;
+  int removed = 0;
+  unsigned int i, j, keep;
+  Clause *cl;
+  ClauseInfo *info;
+
+  if(!next_reduction) next_reduction = params.reduce_base;
+
+  if( forgetfulness > 0.0 && s->statistics.num_failures >= next_reduction ) {
+
+    ++num_reductions;
+    next_reduction = s->statistics.num_failures + params.reduce_base + num_reductions * params.reduce_increment;
+
+    // the candidates are the local clauses that are not reasons.
+    // mid-tier clauses that were not used since the last reduction are demoted
+    Vector< Clause* > candidates;
+    for(i=0; i<learnt.size; ++i) {
+      cl = learnt[i];
+      info = ClauseArena::info(cl);
+      if(info->tier == LOCAL_TIER) {
+	if(!locked(cl)) candidates.add(cl);
+      } else if(info->tier == MID_TIER && !info->used) {
+	info->tier = LOCAL_TIER;
+      }
+      info->used = 0;
+    }
 
-    //   // std::cout << sa[order[kk-1]] << " keep " ;
-    //   // print_clause(std::cout, learnt[kk-1]) ;
-    //   // std::cout << std::endl;
+    // the least active ones are forgotten
+    qsort(candidates.stack_, candidates.size, sizeof(Clause*), less_active);
+    keep = candidates.size - (unsigned int)((double)(candidates.size) * forgetfulness);
 
-    //   --kk;
-      
-    //   avg_kept_size += learnt[kk]->size;
-    // }
+#ifdef _DEBUG_FORGET
+    std::cout << "reduce #" << num_reductions << ": " << learnt.size << " learnt, "
+	      << candidates.size << " candidates, forget " << (candidates.size-keep) << std::endl;
+#endif
 
+    for(i=0; i+keep<candidates.size; ++i) {
+      cl = candidates[i];
+      removed += cl->size;
+      arena.free_clause(cl);
+    }
+
+    if(removed) {
+      for(i=0, j=0; i<learnt.size; ++i) {
+	if(!ClauseArena::info(learnt[i])->deleted) learnt[j++] = learnt[i];
+      }
+      learnt.size = j;
+
+      detach_deleted();
+
+      if(arena.wasted > arena.allocated/2) collect();
+    }
   }
 
   return removed;
@@ -995,6 +1214,637 @@ std::ostream& Mistral::ConstraintClauseBase::display(std::ostream& os) const {
 
 
 
+void Mistral::Environment::record_bound_change(const int var) {
+  lazy_base->record(var);
+}
+
+
+Mistral::ConstraintLazyClauseBase::ConstraintLazyClauseBase(Vector< Variable >& scp) 
+  : GlobalConstraint(scp) { 
+  priority = LINEAR_COST;
+  enforce_nfc1 = false;
+  qhead = 0;
+  init_level = 0;
+  cause = NULL;
+  clause_increment = 1;
+  num_reductions = 0;
+  next_reduction = 0;
+  learnt_root = -1;
+  conflict = NULL;
+  asserting = NULL;
+  num_conflicts = 0;
+  explain_time = 0;
+  explanation_ok = true;
+  conflict_level = 0;
+  root_level = 0;
+  pathC = 0;
+}
+
+void Mistral::ConstraintLazyClauseBase::initialise() {
+  for(unsigned int i=0; i<scope.size; ++i) {
+    trigger_on(_RANGE_, scope[i]);
+  }
+
+  GlobalConstraint::initialise();
+
+  // the scope is the set of variables of the solver, indexed by their ids
+  init_level = get_solver()->level;
+  last_lb.initialise(scope.size, scope.size, -1);
+  last_ub.initialise(scope.size, scope.size, -1);
+  init_lb.initialise(scope.size, scope.size);
+  init_ub.initialise(scope.size, scope.size);
+  needed_lb.initialise(scope.size, scope.size, -INFTY);
+  needed_ub.initialise(scope.size, scope.size, INFTY);
+  atoms_of.initialise(scope.size, scope.size);
+  interval.initialise(scope.size, scope.size);
+  for(unsigned int i=0; i<scope.size; ++i) {
+    init_lb[i] = scope[i].get_min();
+    init_ub[i] = scope[i].get_max();
+    interval[i] = (scope[i].get_size() == (unsigned int)(init_ub[i]-init_lb[i]+1));
+    atoms_of[i] = new Vector< int >;
+  }
+}
+
+Mistral::ConstraintLazyClauseBase::~ConstraintLazyClauseBase() {
+  // the clauses are released with the arena
+  for(unsigned int i=0; i<atoms_of.size; ++i) delete atoms_of[i];
+  for(unsigned int i=0; i<is_watched_by.size; ++i) delete is_watched_by[i];
+}
+
+
+void Mistral::ConstraintLazyClauseBase::record(const int x) {
+  if(x >= (int)(last_lb.size)) return;
+
+  Solver *s = get_solver();
+  Variable X = s->variables[x];
+  int lb = X.get_min(), ub = X.get_max();
+  bool bound_change = false;
+
+  if(lb > current_lb(x)) {
+    trail.add(BoundChange(x, lb, 0, s->level, last_lb[x], cause));
+    last_lb[x] = trail.size-1;
+    bound_change = true;
+  }
+  if(ub < current_ub(x)) {
+    trail.add(BoundChange(x, ub, 1, s->level, last_ub[x], cause));
+    last_ub[x] = trail.size-1;
+    bound_change = true;
+  }
+  while(seen.size < trail.size) {
+    seen.add(0);
+    need.add(0);
+  }
+
+  // a hole was made in the domain of x (when the domain was an interval, we can also
+  // see the holes made together with a bound change)
+  if(s->level > s->search_root && s->level > 0 && 
+     (!bound_change || (interval[x] && X.get_size() < (unsigned int)(ub-lb+1))) &&
+     (hole_levels.empty() || hole_levels.back() < s->level))
+    hole_levels.add(s->level);
+}
+
+void Mistral::ConstraintLazyClauseBase::cancel_until(const int lvl) {
+  while(trail.size && trail.back().level > lvl) {
+    BoundChange& c = trail.back();
+    if(c.upper) last_ub[c.var] = c.prev;
+    else last_lb[c.var] = c.prev;
+    trail.pop();
+  }
+  seen.size = need.size = trail.size;
+  if(qhead > (int)(trail.size)) qhead = trail.size;
+
+  while(!hole_levels.empty() && hole_levels.back() > lvl) hole_levels.pop();
+
+  // the learnt clauses may depend on facts of the root level
+  if(lvl < learnt_root) clear_learnt();
+
+  if(lvl < init_level) {
+    // the domains are now larger than when the trail was started
+    for(unsigned int i=0; i<init_lb.size; ++i) {
+      init_lb[i] = scope[i].get_min();
+      init_ub[i] = scope[i].get_max();
+      interval[i] = (scope[i].get_size() == (unsigned int)(init_ub[i]-init_lb[i]+1));
+    }
+    init_level = lvl;
+  }
+}
+
+
+int Mistral::ConstraintLazyClauseBase::get_atom(const int x, const int v) {
+  Vector< int >& atoms = *(atoms_of[x]);
+  unsigned int lo = 0, hi = atoms.size, mid;
+
+  while(lo < hi) {
+    mid = (lo+hi)/2;
+    if(atom_value[atoms[mid]] < v) lo = mid+1;
+    else hi = mid;
+  }
+  if(lo < atoms.size && atom_value[atoms[lo]] == v) return atoms[lo];
+
+  int a = atom_var.size;
+  atom_var.add(x);
+  atom_value.add(v);
+  is_watched_by.add(new Vector< Watcher >);
+  is_watched_by.add(new Vector< Watcher >);
+
+  atoms.add(a);
+  for(hi=atoms.size-1; hi>lo; --hi) atoms[hi] = atoms[hi-1];
+  atoms[lo] = a;
+
+  return a;
+}
+
+int Mistral::ConstraintLazyClauseBase::literal_value(const Literal l) const {
+  int a = UNSIGNED(l), x = atom_var[a], v = atom_value[a];
+
+  if(current_ub(x) <= v) return (SIGN(l) ? V_TRUE : V_FALSE);
+  if(current_lb(x) >  v) return (SIGN(l) ? V_FALSE : V_TRUE);
+  return V_UNKNOWN;
+}
+
+int Mistral::ConstraintLazyClauseBase::entailing_change(const int x, const int v, const int upper) const {
+  int e = (upper ? last_ub[x] : last_lb[x]);
+  while(e >= (int)explain_time) e = trail[e].prev;
+
+  if(upper) {
+    if(v >= init_ub[x]) return -1;
+    if(e < 0 || trail[e].value > v) return -2;
+    while(trail[e].prev >= 0 && trail[trail[e].prev].value <= v) e = trail[e].prev;
+  } else {
+    if(v <= init_lb[x]) return -1;
+    if(e < 0 || trail[e].value < v) return -2;
+    while(trail[e].prev >= 0 && trail[trail[e].prev].value >= v) e = trail[e].prev;
+  }
+
+  return e;
+}
+
+
+Mistral::PropagationOutcome Mistral::ConstraintLazyClauseBase::propagate() {
+  Explanation *outer_cause = cause;
+  int x, lo, hi, upper, p, w;
+  unsigned int i, j, k, n;
+  Literal q, b, first;
+  Clause *cl;
+  Event evt;
+
+  conflict = NULL;
+  while(!conflict && qhead < (int)(trail.size)) {
+    x = trail[qhead].var;
+    upper = trail[qhead].upper;
+    p = trail[qhead].prev;
+    // a new lower bound falsifies the atoms [x <= lb_before..lb-1], 
+    // a new upper bound falsifies the atoms [x >= ub..ub_before-1]
+    if(upper) {
+      lo = trail[qhead].value;
+      hi = (p < 0 ? init_ub[x] : trail[p].value)-1;
+    } else {
+      lo = (p < 0 ? init_lb[x] : trail[p].value);
+      hi = trail[qhead].value-1;
+    }
+    ++qhead;
+
+    Vector< int >& atoms = *(atoms_of[x]);
+    for(n=0; !conflict && n<atoms.size; ++n) {
+      w = atom_value[atoms[n]];
+      if(w < lo) continue;
+      if(w > hi) break;
+
+      // visit the clauses watching the falsified literal q
+      q = (upper ? NEG(atoms[n]) : POS(atoms[n]));
+      Vector< Watcher >& ws = *(is_watched_by[q]);
+      for(i=j=0; i<ws.size; ) {
+	b = ws[i].blocker;
+	if(literal_value(b) == V_TRUE) {
+	  ws[j++] = ws[i++];
+	  continue;
+	}
+
+	cl = ws[i++].clause;
+	Clause& clause = *cl;
+	if(clause[0] == q) {
+	  clause[0] = clause[1];
+	  clause[1] = q;
+	}
+	first = clause[0];
+	Watcher wt(cl, first);
+	if(first != b && literal_value(first) == V_TRUE) {
+	  ws[j++] = wt;
+	  continue;
+	}
+
+	// look for a new literal to watch
+	for(k=2; k<clause.size; ++k) {
+	  if(literal_value(clause[k]) != V_FALSE) {
+	    clause[1] = clause[k];
+	    clause[k] = q;
+	    is_watched_by[clause[1]]->add(wt);
+	    break;
+	  }
+	}
+	if(k < clause.size) continue;
+
+	// the clause is unit or falsified
+	ws[j++] = wt;
+	if(literal_value(first) == V_FALSE) {
+	  conflict = cl;
+	} else {
+	  cause = cl;
+	  if(SIGN(first)) evt = get_solver()->variables[atom_var[UNSIGNED(first)]].set_max(atom_value[UNSIGNED(first)]);
+	  else evt = get_solver()->variables[atom_var[UNSIGNED(first)]].set_min(atom_value[UNSIGNED(first)]+1);
+	  cause = outer_cause;
+	  if(FAILED(evt)) conflict = cl;
+	}
+	if(conflict) {
+	  while(i<ws.size) ws[j++] = ws[i++];
+	}
+      }
+      ws.size = j;
+    }
+  }
+
+  return (conflict ? FAILURE(atom_var[UNSIGNED(conflict->data[0])]) : CONSISTENT);
+}
+
+
+int Mistral::ConstraintLazyClauseBase::get_lb(const int x) {
+  if(x >= (int)(last_lb.size)) return get_solver()->variables[x].get_min();
+  int e = last_lb[x];
+  while(e >= (int)explain_time) e = trail[e].prev;
+  return (e < 0 ? init_lb[x] : trail[e].value);
+}
+
+int Mistral::ConstraintLazyClauseBase::get_ub(const int x) {
+  if(x >= (int)(last_ub.size)) return get_solver()->variables[x].get_max();
+  int e = last_ub[x];
+  while(e >= (int)explain_time) e = trail[e].prev;
+  return (e < 0 ? init_ub[x] : trail[e].value);
+}
+
+void Mistral::ConstraintLazyClauseBase::add_lb(const int x, const int v) {
+  if(!explanation_ok) return;
+  if(x >= (int)(last_lb.size)) {
+    explanation_ok = false;
+    return;
+  }
+
+  int e = entailing_change(x, v, 0);
+  if(e == -1) return;
+  if(e == -2) {
+    // the literal does not hold, the explanation is wrong
+    explanation_ok = false;
+    return;
+  }
+
+  // facts of the root level and bounds of the objective
+  if(trail[e].level <= root_level || trail[e].reason == this) return;
+
+  if(trail[e].level >= conflict_level) {
+    if(!seen[e]) {
+      seen[e] = 1;
+      need[e] = v;
+      ++pathC;
+    } else if(need[e] < v) need[e] = v;
+  } else {
+    if(needed_lb[x] == -INFTY && needed_ub[x] == INFTY) touched.add(x);
+    if(needed_lb[x] < v) needed_lb[x] = v;
+  }
+}
+
+void Mistral::ConstraintLazyClauseBase::add_ub(const int x, const int v) {
+  if(!explanation_ok) return;
+  if(x >= (int)(last_ub.size)) {
+    explanation_ok = false;
+    return;
+  }
+
+  int e = entailing_change(x, v, 1);
+  if(e == -1) return;
+  if(e == -2) {
+    explanation_ok = false;
+    return;
+  }
+
+  if(trail[e].level <= root_level || trail[e].reason == this) return;
+
+  if(trail[e].level >= conflict_level) {
+    if(!seen[e]) {
+      seen[e] = 1;
+      need[e] = v;
+      ++pathC;
+    } else if(need[e] > v) need[e] = v;
+  } else {
+    if(needed_lb[x] == -INFTY && needed_ub[x] == INFTY) touched.add(x);
+    if(needed_ub[x] > v) needed_ub[x] = v;
+  }
+}
+
+void Mistral::ConstraintLazyClauseBase::explain(Explanation *e, const int x, const int upper, const int v) {
+  if(e->is_clause()) {
+    // every literal but the one on x is false
+    Clause& clause = *((Clause*)e);
+    Literal l;
+    for(unsigned int i=0; i<clause.size; ++i) {
+      l = clause[i];
+      if(atom_var[UNSIGNED(l)] == x && (int)SIGN(l) == upper) continue;
+      if(SIGN(l)) add_lb(atom_var[UNSIGNED(l)], atom_value[UNSIGNED(l)]+1);
+      else add_ub(atom_var[UNSIGNED(l)], atom_value[UNSIGNED(l)]);
+    }
+    bump((Clause*)e);
+  } else {
+    ((ConstraintImplementation*)e)->explain_bound(this, x, upper, v);
+  }
+}
+
+
+//#define _DEBUG_LAZY_NOGOOD true
+
+bool Mistral::ConstraintLazyClauseBase::learn_nogood(Explanation *failure) {
+  Solver *s = get_solver();
+  int index, uip = -1, x, e, lvl, max_level, max_pos = 0, hole_level;
+  unsigned int i;
+
+  asserting = NULL;
+  conflict_level = s->level;
+  root_level = (s->search_root > 0 ? s->search_root : 0);
+  hole_level = (hole_levels.empty() ? root_level : hole_levels.back());
+  if(failure == this) failure = conflict;
+  if(!failure || conflict_level <= root_level || hole_level >= conflict_level) return false;
+
+  explanation_ok = true;
+  pathC = 0;
+  explain_time = trail.size;
+
+  // explain the failure, then resolve the bound changes of the current level
+  explain(failure, -1, 0, 0);
+
+  index = trail.size;
+  while(explanation_ok) {
+    if(!pathC) {
+      // no literal of the current level
+      explanation_ok = false;
+      break;
+    }
+    while(!seen[--index]);
+    seen[index] = 0;
+    if(!--pathC) {
+      uip = index;
+      break;
+    }
+    if(!trail[index].reason) {
+      // another decision was made at this level
+      explanation_ok = false;
+      break;
+    }
+    explain_time = index;
+    explain(trail[index].reason, trail[index].var, trail[index].upper, need[index]);
+  }
+
+  if(explanation_ok && hole_level > root_level) {
+    // the holes are entailed by the decisions down to their level
+    explain_time = trail.size;
+    for(x=0; x<hole_level-s->search_root; ++x) {
+      Decision d = s->decisions[x];
+      if(d._data_ == -1) explanation_ok = false;
+      else if(d.type() == Decision::LOWERBOUND) add_lb(d.var.id(), d.value()+1);
+      else if(d.type() == Decision::UPPERBOUND) add_ub(d.var.id(), d.value());
+      else explanation_ok = false;
+    }
+  }
+
+  if(explanation_ok) {
+    // the first literal is the negation of the UIP
+    lit_buffer.clear();
+    x = trail[uip].var;
+    if(trail[uip].upper) lit_buffer.add(geq_literal(x, need[uip]+1));
+    else lit_buffer.add(leq_literal(x, need[uip]-1));
+    
+    explain_time = trail.size;
+    max_level = root_level;
+    for(i=0; i<touched.size; ++i) {
+      x = touched[i];
+      if(needed_lb[x] > -INFTY && !(x == trail[uip].var && !trail[uip].upper)) {
+	e = entailing_change(x, needed_lb[x], 0);
+	lvl = trail[e].level;
+	lit_buffer.add(leq_literal(x, needed_lb[x]-1));
+	if(lvl > max_level) {
+	  max_level = lvl;
+	  max_pos = lit_buffer.size-1;
+	}
+      }
+      if(needed_ub[x] < INFTY && !(x == trail[uip].var && trail[uip].upper)) {
+	e = entailing_change(x, needed_ub[x], 1);
+	lvl = trail[e].level;
+	lit_buffer.add(geq_literal(x, needed_ub[x]+1));
+	if(lvl > max_level) {
+	  max_level = lvl;
+	  max_pos = lit_buffer.size-1;
+	}
+      }
+    }
+    if(max_pos > 1) {
+      Literal l = lit_buffer[1];
+      lit_buffer[1] = lit_buffer[max_pos];
+      lit_buffer[max_pos] = l;
+    }
+    s->backtrack_level = max_level;
+
+#ifdef _DEBUG_LAZY_NOGOOD
+    std::cout << "learn (";
+    for(i=0; i<lit_buffer.size; ++i) {
+      std::cout << " ";
+      display_literal(std::cout, lit_buffer[i]);
+    }
+    std::cout << " ) and backjump to " << max_level << std::endl;
+#endif
+
+    if(lit_buffer.size > 1) {
+      asserting = arena.allocate(lit_buffer, true);
+      ClauseInfo *info = ClauseArena::info(asserting);
+      info->lbd = lit_buffer.size;
+      info->tier = LOCAL_TIER;
+      info->activity = clause_increment;
+      learnt.add(asserting);
+      is_watched_by[lit_buffer[0]]->add(Watcher(asserting, lit_buffer[1]));
+      is_watched_by[lit_buffer[1]]->add(Watcher(asserting, lit_buffer[0]));
+      if(learnt_root < root_level) learnt_root = root_level;
+    }
+
+    s->statistics.size_learned += lit_buffer.size;
+    s->statistics.avg_learned_size = 
+      ((s->statistics.avg_learned_size * (double)num_conflicts) + (double)(lit_buffer.size))
+      / ((double)(++num_conflicts));
+    clause_increment /= .999;
+  } else {
+    while(pathC) {
+      if(seen[--index]) {
+	seen[index] = 0;
+	--pathC;
+      }
+    }
+  }
+
+  for(i=0; i<touched.size; ++i) {
+    needed_lb[touched[i]] = -INFTY;
+    needed_ub[touched[i]] = INFTY;
+  }
+  touched.clear();
+
+  return explanation_ok;
+}
+
+Mistral::Decision Mistral::ConstraintLazyClauseBase::get_deduction() {
+  Literal l = lit_buffer[0];
+  Variable x = get_solver()->variables[atom_var[UNSIGNED(l)]];
+  if(SIGN(l)) return Decision(x, Decision::UPPERBOUND, atom_value[UNSIGNED(l)]);
+  return Decision(x, Decision::LOWERBOUND, atom_value[UNSIGNED(l)]+1);
+}
+
+
+void Mistral::ConstraintLazyClauseBase::bump( Clause* cl ) {
+  ClauseInfo *info = ClauseArena::info(cl);
+  info->used = 1;
+  if((info->activity += clause_increment) > 1e20) {
+    // rescale to avoid overflows
+    for(unsigned int i=0; i<learnt.size; ++i)
+      ClauseArena::info(learnt[i])->activity *= 1e-20;
+    clause_increment *= 1e-20;
+  }
+}
+
+bool Mistral::ConstraintLazyClauseBase::locked( Clause* cl ) {
+  if(cl == asserting || cl == conflict) return true;
+
+  // the first literal is the one that the clause propagated
+  Literal l = cl->data[0];
+  if(literal_value(l) != V_TRUE) return false;
+  int saved_time = explain_time;
+  explain_time = trail.size;
+  int e = (SIGN(l) ? entailing_change(atom_var[UNSIGNED(l)], atom_value[UNSIGNED(l)], 1) :
+	   entailing_change(atom_var[UNSIGNED(l)], atom_value[UNSIGNED(l)]+1, 0));
+  explain_time = saved_time;
+  return (e >= 0 && trail[e].reason == cl);
+}
+
+void Mistral::ConstraintLazyClauseBase::collect() {
+  ClauseArena to;
+  unsigned int i, j;
+
+  // copy the live clauses, and leave a forwarding address behind
+  for(i=0; i<learnt.size; ++i) {
+    Clause *cl = learnt[i];
+    ClauseInfo *info = ClauseArena::info(cl);
+
+    lit_buffer.clear();
+    for(j=0; j<cl->size; ++j) lit_buffer.add(cl->data[j]);
+
+    Clause *copy = to.allocate(lit_buffer, true);
+    ClauseInfo *copy_info = ClauseArena::info(copy);
+    copy_info->activity = info->activity;
+    copy_info->lbd = info->lbd;
+    copy_info->tier = info->tier;
+    copy_info->used = info->used;
+
+    info->relocated = 1;
+    *((Clause**)cl) = copy;
+    learnt[i] = copy;
+  }
+
+  // relocate the references
+  for(i=0; i<is_watched_by.size; ++i) {
+    Vector< Watcher >& watchers = *(is_watched_by[i]);
+    for(j=0; j<watchers.size; ++j)
+      watchers[j].clause = relocated_address(watchers[j].clause);
+  }
+  for(i=0; i<trail.size; ++i) {
+    if(trail[i].reason && arena.contain(trail[i].reason))
+      trail[i].reason = relocated_address((Clause*)(trail[i].reason));
+  }
+  if(asserting) asserting = relocated_address(asserting);
+  conflict = NULL;
+
+  arena.swap(to);
+}
+
+int Mistral::ConstraintLazyClauseBase::forget( const double forgetfulness )
+{
+  Solver *s = get_solver();
+  SolverParameters& params = s->parameters;
+  int removed = 0;
+  unsigned int i, j, keep;
+  Clause *cl;
+
+  if(!next_reduction) next_reduction = params.reduce_base;
+
+  if( forgetfulness > 0.0 && s->statistics.num_failures >= next_reduction ) {
+
+    ++num_reductions;
+    next_reduction = s->statistics.num_failures + params.reduce_base + num_reductions * params.reduce_increment;
+
+    // the least active clauses that are not reasons are forgotten
+    Vector< Clause* > candidates;
+    for(i=0; i<learnt.size; ++i) {
+      if(!locked(learnt[i])) candidates.add(learnt[i]);
+    }
+    qsort(candidates.stack_, candidates.size, sizeof(Clause*), less_active);
+    keep = candidates.size - (unsigned int)((double)(candidates.size) * forgetfulness);
+
+    for(i=0; i+keep<candidates.size; ++i) {
+      cl = candidates[i];
+      removed += cl->size;
+      arena.free_clause(cl);
+    }
+
+    if(removed) {
+      for(i=0, j=0; i<learnt.size; ++i) {
+	if(!ClauseArena::info(learnt[i])->deleted) learnt[j++] = learnt[i];
+      }
+      learnt.size = j;
+
+      for(i=0; i<is_watched_by.size; ++i) {
+	Vector< Watcher >& watchers = *(is_watched_by[i]);
+	for(j=0, keep=0; j<watchers.size; ++j) {
+	  if(!ClauseArena::info(watchers[j].clause)->deleted) watchers[keep++] = watchers[j];
+	}
+	watchers.size = keep;
+      }
+
+      if(arena.wasted > arena.allocated/2) collect();
+    }
+  }
+
+  return removed;
+}
+
+void Mistral::ConstraintLazyClauseBase::clear_learnt() {
+  ClauseArena empty;
+  unsigned int i;
+
+  for(i=0; i<trail.size; ++i) {
+    // these bound changes can no longer be explained
+    if(trail[i].reason && arena.contain(trail[i].reason)) trail[i].reason = NULL;
+  }
+  for(i=0; i<is_watched_by.size; ++i) is_watched_by[i]->clear();
+  learnt.clear();
+  arena.swap(empty);
+  asserting = conflict = NULL;
+  learnt_root = -1;
+}
+
+
+std::ostream& Mistral::ConstraintLazyClauseBase::display_literal(std::ostream& os, const Literal l) {
+  os << "[" << get_solver()->variables[atom_var[UNSIGNED(l)]] 
+     << (SIGN(l) ? " <= " : " > ") << atom_value[UNSIGNED(l)] << "]";
+  return os;
+}
+
+std::ostream& Mistral::ConstraintLazyClauseBase::display(std::ostream& os) const {
+  os << "lazy clauses (" << atom_var.size << " atoms, " << learnt.size << " learnt)";
+  return os;
+}
+
+
+
 
 
 
@@ -249,7 +249,7 @@ const char* ParameterList::int_ident[ParameterList::nia] =
 	{"-ub", "-lb", "-check", "-seed", "-cutoff", "-dichotomy", 
 "-base", "-randomized", "-verbose", "-optimise", "-nogood", 
 "-dyncutoff", "-nodes", "-hlimit", "-init", "-neighbor", 
-"-initstep", "-fixtasks", "-order", "-ngdt"};
+"-initstep", "-fixtasks", "-order", "-ngdt", "-unary"};
 
 const char* ParameterList::str_ident[ParameterList::nsa] = 
 	{"-heuristic", "-restart", "-factor", "-decay", "-type", 
@@ -329,6 +329,7 @@ ParameterList::ParameterList(int length, char **commandline) {
 	FixTasks  = 0;
 	NgdType   = 2;
 	OrderTasks = 1;
+	Unary     = 0;
 
 
 
@@ -392,6 +393,7 @@ ParameterList::ParameterList(int length, char **commandline) {
 	if(int_param[17] != NOVAL) FixTasks    = int_param[17]; 
 	if(int_param[18] != NOVAL) OrderTasks  = int_param[18]; 
 	if(int_param[19] != NOVAL) NgdType     = int_param[19]; 
+	if(int_param[20] != NOVAL) Unary       = int_param[20]; 
 
 	if(strcmp(str_param[0 ],"nil")) Heuristic  = str_param[0];
 	if(strcmp(str_param[1 ],"nil")) Policy     = str_param[1];
@@ -435,6 +437,7 @@ std::ostream& ParameterList::print(std::ostream& os) {
 	os << std::left << std::setw(30) << " c | time cutoff " << ":" << std::right << std::setw(15) << Cutoff << " |" << std::endl;
 	os << std::left << std::setw(30) << " c | node cutoff " << ":" << std::right << std::setw(15) << NodeCutoff << " |" << std::endl;
 	os << std::left << std::setw(30) << " c | dichotomy " << ":" << std::right << std::setw(15) << (Dichotomy ? "yes" : "no") << " |" << std::endl;
+	os << std::left << std::setw(30) << " c | resource model " << ":" << std::right << std::setw(15) << (Unary ? (Unary>1 ? "unary" : "disjuncts+unary") : "disjuncts") << " |" << std::endl;
 	os << std::left << std::setw(30) << " c | restart policy " << ":" << std::right << std::setw(15) << Policy << " |" << std::endl;
 	os << std::left << std::setw(30) << " c | base " << ":" << std::right << std::setw(15) << Base << " |" << std::endl;
 	os << std::left << std::setw(30) << " c | factor " << ":" << std::right << std::setw(15) << Factor << " |" << std::endl;
@@ -1725,7 +1728,26 @@ void SchedulingSolver::setup() {
 
 
 	// mutual exclusion constraints
-	for(k=0; k<data->nMachines(); ++k) {
+	if(params->Unary > 1 && data->hasSetupTime()) {
+		std::cout << " c Warning: setup times are not handled by the unary resource constraint, keeping the disjuncts" << std::endl;
+		params->Unary = 1;
+	}
+
+	if(params->Unary) {
+		for(k=0; k<data->nMachines(); ++k) {
+			VarArray machine_tasks;
+			Vector< int > durations;
+			for(i=0; i<data->nTasksInMachine(k); ++i) {
+				ti = data->getMachineTask(k,i);
+				machine_tasks.add(tasks[ti]);
+				durations.add(data->getDuration(ti));
+			}
+			if(machine_tasks.size > 1)
+				add( UnaryResource(machine_tasks, durations) );
+		}
+	}
+
+	for(k=0; params->Unary<2 && k<data->nMachines(); ++k) {
 		for(i=0; i<data->nTasksInMachine(k); ++i) {
 			for(j=i+1; j<data->nTasksInMachine(k); ++j) {
 				ti = data->getMachineTask(k,i);
@@ -2146,14 +2168,21 @@ void SchedulingSolver::dichotomic_search()
   
 
 
-	BranchingHeuristic *heu = new SchedulingWeightedDegree < TaskDomOverBoolWeight, Guided< MinValue >, 2 > (this, disjunct_map);
+	BranchingHeuristic *heu;
 
 	//BranchingHeuristic *heu = new GenericHeuristic < NoOrder, MinValue > (this);
 
 	RestartPolicy *pol = new Geometric();
 
 
-	initialise_search(disjuncts, heu, pol);
+	if(disjuncts.size) {
+		heu = new SchedulingWeightedDegree < TaskDomOverBoolWeight, Guided< MinValue >, 2 > (this, disjunct_map);
+		initialise_search(disjuncts, heu, pol);
+	} else {
+		// no disjuncts (unary resource model), search on the start times
+		heu = new GenericHeuristic < GenericDVO < MinDomainOverWeight, 1, FailureCountManager >, Guided< MinValue > > (this);
+		initialise_search(tasks, heu, pol);
+	}
 
 
 	//propagate the bounds, with respect to the initial upper bound
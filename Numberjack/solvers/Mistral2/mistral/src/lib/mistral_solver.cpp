@@ -21,6 +21,8 @@
 
 #include <sstream>
 #include <fstream>
+#include <map>
+#include <algorithm>
 #include <signal.h>
 #include <assert.h>
 
@@ -139,11 +141,17 @@ void Mistral::SolverParameters::initialise() {
   normalize_activity = 0;
   init_activity = 1;
   forgetfulness = .75;
+  lbd_core = 2;
+  lbd_mid = 6;
+  reduce_base = 2000;
+  reduce_increment = 300;
   randomization = 1; //2;
   shuffle = false; //true;
   activity_decay = 0.96;
   checked = 1;
+  profiling = 0;
   backjump = 0;
+  lazy_generation = 0;
   value_selection = 2;
   dynamic_value = 0; //1;
 
@@ -170,11 +178,17 @@ void Mistral::SolverParameters::copy(const SolverParameters& sp) {
   normalize_activity = sp.normalize_activity;
   init_activity = sp.init_activity;
   forgetfulness = sp.forgetfulness;
+  lbd_core = sp.lbd_core;
+  lbd_mid = sp.lbd_mid;
+  reduce_base = sp.reduce_base;
+  reduce_increment = sp.reduce_increment;
   randomization = sp.randomization;
   shuffle = sp.shuffle;
   activity_decay = sp.activity_decay;
   checked = sp.checked;
+  profiling = sp.profiling;
   backjump = sp.backjump;
+  lazy_generation = sp.lazy_generation;
   value_selection = sp.value_selection;
   dynamic_value = sp.dynamic_value;
 
@@ -257,6 +271,11 @@ void Mistral::SolverStatistics::initialise(Solver *s) {
   num_propagations = 0;
   num_solutions = 0;
   num_filterings = 0;
+  for(int i=0; i<NUM_COST_CLASSES; ++i) {
+    num_class_propagations[i] = 0;
+    num_class_prunings[i] = 0;
+    num_class_failures[i] = 0;
+  }
   //start_time = 0.0;
   creation_time = get_run_time();
   end_time = -1.0;
@@ -288,6 +307,8 @@ void Mistral::SolverStatistics::init_prof() {
   total_propag_time = 0;
   total_branching_time = 0;
   total_restore_time = 0;
+  for(int i=0; i<NUM_COST_CLASSES; ++i) 
+    class_propag_time[i] = 0;
 
 #ifdef _PROFILING_PRIMITIVE
 
@@ -487,10 +508,85 @@ std::ostream& Mistral::SolverStatistics::print_full(std::ostream& os) const {
     //<< std::right << std::setw(46) << (num_amsc_explanations ? avg_amsc_expl_size/num_amsc_explanations : 0) << std::endl
     //<< std::left << " " << solver->parameters.prefix_statistics << std::setw(44-lps) << "  NEGWEIGHT"
     //<< std::right << std::setw(46) << negative_weight << std::endl
-     << " " << solver->parameters.prefix_comment << " +" << std::setw(89) << std::setfill('=') << "+" << std::endl << std::setfill(' ');
+    ;
+
+  // calls/prunings/failures of each cost class of propagators 
+  const char* cost_name[NUM_COST_CLASSES] = {"CUBIC", "QUADRATIC", "LINEAR", "BINARY"};
+  for(int i=NUM_COST_CLASSES; i--;) {
+    if(num_class_propagations[i]) {
+      std::string cname(cost_name[i]);
+      os << std::left << " " << solver->parameters.prefix_statistics << std::setw(44-lps) << ("  " + cname + "PROPAGATIONS")
+	 << std::right << std::setw(46) << num_class_propagations[i] << std::endl
+	 << std::left << " " << solver->parameters.prefix_statistics << std::setw(44-lps) << ("  " + cname + "PRUNINGS")
+	 << std::right << std::setw(46) << num_class_prunings[i] << std::endl
+	 << std::left << " " << solver->parameters.prefix_statistics << std::setw(44-lps) << ("  " + cname + "FAILURES")
+	 << std::right << std::setw(46) << num_class_failures[i] << std::endl;
+#ifdef _PROFILING
+      os << std::left << " " << solver->parameters.prefix_statistics << std::setw(44-lps) << ("  " + cname + "TIME")
+	 << std::right << std::setw(46) << class_propag_time[i] << std::endl;
+#endif
+    }
+  }
+
+  if(solver->parameters.profiling) print_propagator_profile(os);
+
+  os << " " << solver->parameters.prefix_comment << " +" << std::setw(89) << std::setfill('=') << "+" << std::endl << std::setfill(' ');
   //<< " " << parameters.prefix_comment << " +=============================================================================+" << std::endl;
   return os;
 }
+bool more_cycles(const Mistral::PropagatorProfile& p, const Mistral::PropagatorProfile& q) {
+  return p.num_cycles > q.num_cycles;
+}
+
+void Mistral::SolverStatistics::get_propagator_profile(std::vector< PropagatorProfile >& profile) const {
+  std::map< std::string, int > rank;
+  std::map< std::string, int >::iterator it;
+  ConstraintImplementation *con;
+  std::string cname;
+
+  profile.clear();
+  for(unsigned int i=0; i<solver->constraints.size; ++i) {
+    con = solver->constraints[i].propagator;
+    if(!con) continue;
+
+    cname = con->name();
+    it = rank.find(cname);
+    if(it == rank.end()) {
+      rank[cname] = profile.size();
+      profile.push_back(PropagatorProfile(cname));
+    }
+
+    PropagatorProfile& p = profile[rank[cname]];
+    ++p.num_propagators;
+    p.num_calls += con->num_calls;
+    p.num_prunings += con->num_prunings;
+    p.num_failures += con->num_failures;
+    p.num_cycles += con->num_cycles;
+  }
+
+  std::sort(profile.begin(), profile.end(), more_cycles);
+}
+
+std::ostream& Mistral::SolverStatistics::print_propagator_profile(std::ostream& os) const {
+  std::vector< PropagatorProfile > profile;
+  get_propagator_profile(profile);
+
+  std::string ps = solver->parameters.prefix_statistics;
+
+  os << " " << ps << "  " << std::left << std::setw(24) << "PROPAGATOR" << std::right 
+     << std::setw(8) << "#" << std::setw(14) << "CALLS" << std::setw(14) << "PRUNINGS" 
+     << std::setw(10) << "FAILURES" << std::setw(18) << "CYCLES" << std::endl;
+  for(unsigned int i=0; i<profile.size(); ++i) {
+    os << " " << ps << "  " << std::left << std::setw(24) << profile[i].name << std::right 
+       << std::setw(8) << profile[i].num_propagators 
+       << std::setw(14) << profile[i].num_calls
+       << std::setw(14) << profile[i].num_prunings
+       << std::setw(10) << profile[i].num_failures
+       << std::setw(18) << profile[i].num_cycles << std::endl;
+  }
+  return os;
+}
+
 std::ostream& Mistral::SolverStatistics::print_short(std::ostream& os) const {
   os << " " << solver->parameters.prefix_comment << " |";
 
@@ -554,6 +650,11 @@ void Mistral::SolverStatistics::copy(const SolverStatistics& sp) {
   num_propagations = sp.num_propagations;
   num_solutions = sp.num_solutions;
   num_filterings = sp.num_filterings;
+  for(int i=0; i<NUM_COST_CLASSES; ++i) {
+    num_class_propagations[i] = sp.num_class_propagations[i];
+    num_class_prunings[i] = sp.num_class_prunings[i];
+    num_class_failures[i] = sp.num_class_failures[i];
+  }
   start_time = sp.start_time;
   end_time = sp.end_time;
 }
@@ -567,6 +668,11 @@ void Mistral::SolverStatistics::update(const SolverStatistics& sp) {
   num_propagations += sp.num_propagations;
   num_solutions += sp.num_solutions;
   num_filterings += sp.num_filterings;
+  for(int i=0; i<NUM_COST_CLASSES; ++i) {
+    num_class_propagations[i] += sp.num_class_propagations[i];
+    num_class_prunings[i] += sp.num_class_prunings[i];
+    num_class_failures[i] += sp.num_class_failures[i];
+  }
   if(end_time < sp.end_time) end_time = sp.end_time;
 }
 
@@ -659,14 +765,19 @@ void Mistral::ConstraintQueue::declare(Constraint c, Solver *s) {
      
     if(!triggers[cons_priority].is_initialised()) {
       triggers[cons_priority].initialise(cons_idx, cons_idx+7);
+    } else if(cons_idx >= triggers[cons_priority]._head) {
+      // constraints are declared one at a time, so the queue grows geometrically
+      // (otherwise declaring n constraints is quadratic)
+      triggers[cons_priority].extend(2*cons_idx - triggers[cons_priority].offset);
     } else {
       triggers[cons_priority].extend(cons_idx);
     }
   }
   
-  if(_set_.table)
-    _set_.extend(cons_idx);
-  else 
+  if(_set_.table) {
+    if((cons_idx >> BitSet::EXP) >= _set_.pos_words)
+      _set_.extend(2*cons_idx);
+  } else 
     _set_.initialise(cons_idx, cons_idx, BitSet::empt);
 
 }
@@ -765,8 +876,8 @@ void Mistral::ConstraintQueue::add(ConstraintImplementation *cons)//;
   int cons_id = cons->id;
   if(!_set_.fast_contain(cons_id)) {
     _set_.fast_add(cons_id);
-    triggers[2].add(cons_id);
-    if(2 > higher_priority) higher_priority = 2;
+    triggers[BINARY_COST].add(cons_id);
+    if(BINARY_COST > higher_priority) higher_priority = BINARY_COST;
   }
 }
 
@@ -980,35 +1091,38 @@ Mistral::Solver::Solver()
 }
 
 void Mistral::Solver::parse_pbo(const char* filename) {
-  unsigned int LARGENUMBER = 131072;
-  std::ifstream infile( filename );
-  char c=' ';
+  InputFile input( filename );
+  int c=' ';
   std::string word;
   //int N, M, l=0;
   Literal lit;
-  Vector< Vector< Literal > > clauses;
+  // the clauses are stored one after the other and added at once
+  Vector< Literal > clauses;
+  Vector< unsigned int > clause_ends;
   Vector< Literal > new_clause;
   Vector< int >         weight;
   Vector< Variable >     scope;
 
   new_clause.initialise(0,10);
 
+  if(!input.is_open()) {
+    std::cerr << "Error: cannot read " << filename << std::endl;
+    exit(1);
+  }
 
   Variable Goal;
   int obj_dir = 0;
 
   // skip comments
-  infile >> c;
-  while( c == '*' ) {
-    infile.ignore( LARGENUMBER, '\n' );
-    infile >> c;
+  input.skip_blanks();
+  while( input.peek() == '*' ) {
+    input.skip_line();
+    input.skip_blanks();
   }
 
-  infile.unget();
-
   int aux, parse_objective;
 
-  bool should_continue = infile.good();
+  bool should_continue = (input.peek() != EOF);
 
   while(should_continue) {
 
@@ -1023,9 +1137,10 @@ void Mistral::Solver::parse_pbo(const char* filename) {
     
     parse_objective = 0;
     do {
-      infile >> c;
+      input.skip_blanks();
+      c = input.peek();
 
-      should_continue = infile.good();
+      should_continue = (c != EOF);
 
 
       if(should_continue) {
@@ -1034,23 +1149,24 @@ void Mistral::Solver::parse_pbo(const char* filename) {
 
 	  //std::cout << " obj" ;
 
-	  infile >> word;
+	  input.read_word(word);
 
-	  if(word == "in:") {
+	  if(word == "min:") {
 	    parse_objective = 1;
-	  } else if(word == "ax:") {
+	  } else if(word == "max:") {
 	    parse_objective = 2;
 	  }
 	  
-	  infile.ignore( LARGENUMBER, ' ' );
-	  infile >> c;
+	  input.skip_blanks();
+	  c = input.peek();
 	}
 	 
 	if(c == '+' || c == '-') {
 
 	  //std::cout << " trm" ;
 
-	  infile >> aux;
+	  input.get();
+	  aux = input.read_int();
 	  weight.add((c == '+' ? aux : -aux));
 
 	  all_pones &= (weight.back() ==  1);
@@ -1059,12 +1175,12 @@ void Mistral::Solver::parse_pbo(const char* filename) {
 	  //std::cout << " " << weight.back() << std::endl;
 
 	  
-	  infile.ignore( LARGENUMBER, ' ' );
-	  infile >> c;
+	  input.skip_blanks();
+	  c = input.get();
 	  
 	  assert( c == 'x' );
 	  
-	  infile >> aux;
+	  aux = input.read_int();
 	  while(aux > (int)(variables.size)) {
 	    Variable x(0,1);
 	    add(x);
@@ -1076,16 +1192,14 @@ void Mistral::Solver::parse_pbo(const char* filename) {
 
 	  //std::cout << " end" ;
 	  
-	  infile.unget();
-	  
 	  if(!parse_objective) {
 
 	    //std::cout << " CON" ;
 
 
-	    infile >> word;
-	    infile >> aux;
-	    infile.ignore( LARGENUMBER, '\n' );
+	    input.read_word(word);
+	    aux = input.read_int();
+	    input.skip_line();
 	    
 	    int bounds[2] = {-INFTY, INFTY};
 	  
@@ -1149,7 +1263,9 @@ void Mistral::Solver::parse_pbo(const char* filename) {
 	    
 	    
 	    if(is_clause) {
-	      clauses.add(new_clause);
+	      for(unsigned int i=0; i<new_clause.size; ++i)
+		clauses.add(new_clause[i]);
+	      clause_ends.add(clauses.size);
 	    } else {
 
 	      if(all_mones) {
@@ -1224,7 +1340,7 @@ void Mistral::Solver::parse_pbo(const char* filename) {
 	    obj_dir = parse_objective;
 	    //objective = new Goal(Goal::MINIMIZATION,  );
 
-	    infile.ignore( LARGENUMBER, '\n' );
+	    input.skip_line();
 	    //std::cout << "OBJECTIVE!" << std::endl;
 	    //exit(1);
 	    
@@ -1240,16 +1356,12 @@ void Mistral::Solver::parse_pbo(const char* filename) {
   
   //std::cout << clauses << std::endl;
 
-  if(parameters.backjump || clauses.size) {
+  if(parameters.backjump || clause_ends.size) {
     base = new ConstraintClauseBase(variables);
     add(base);
   }
  
-  for(unsigned int i=0; i<clauses.size; ++i) {
-
-    add(clauses[i]);
-
-  }
+  if(clause_ends.size) base->add(clauses, clause_ends);
 
 
   if(!Goal.is_void()) {
@@ -1263,68 +1375,533 @@ void Mistral::Solver::parse_pbo(const char* filename) {
 }
 
 
+// number of literals read before the clauses are added to the base
+#define DIMACS_BATCH_SIZE 1048576
+
 void Mistral::Solver::parse_dimacs(const char* filename) {
-  unsigned int LARGENUMBER = 131072;
-  std::ifstream infile( filename );
-  char c=' ';
+  InputFile input( filename );
   std::string word;
   int N, M, l=0;
-  Literal lit;
-  Vector< Literal > new_clause;
+  // the clauses are read by batches, stored one after the other, and added at once
+  Vector< Literal > lits;
+  Vector< unsigned int > ends;
+
+  if(!input.is_open()) {
+    std::cerr << "Error: cannot read " << filename << std::endl;
+    exit(1);
+  }
 
   // skip comments
-  infile >> c;
-  while( c != 'p' ) {
-    infile.ignore( LARGENUMBER, '\n' );
-    infile >> c;
+  input.skip_blanks();
+  while( input.peek() != 'p' && input.peek() != EOF ) {
+    input.skip_line();
+    input.skip_blanks();
   }
 
-  infile >> word;
+  input.get();
+  input.read_word(word);
   assert( word == "cnf" );
   
   // get number of atoms and clauses
-  infile >> N;
-  infile >> M;
+  N = input.read_int();
+  M = input.read_int();
 
   for(int i=0; i<N; ++i) {
     Variable x(0,1);
     add(x);
   }
 
-  new_clause.initialise(0,N);
-  // ConstraintClauseBase *cbase = new ConstraintClauseBase(variables);
-  // base->reason = reason.stack_;
-  // add(cbase);
+  if(M > 0 && !base) {
+    base = new ConstraintClauseBase(variables);
+    add(base);
+  }
+
+  lits.initialise(0, DIMACS_BATCH_SIZE+N);
+  ends.initialise(0, DIMACS_BATCH_SIZE/2);
 
   for(int i=0; i<M; ++i)
     {
-      new_clause.clear();
-      do {
-	infile >> l;
-	if(l!=0) {
-	  if(l>0) lit = (l-1)*2+1;
-	  else lit = (l+1)*-2;
-	  new_clause.add(lit);
-	  // if(parameters.init_activity == 1)
-	  //   base->activity[lit] += parameters.activity_increment;
-	}
-      } while(l && infile.good());
-      //cbase->add( new_clause );
-      add( new_clause );
+      input.skip_blanks();
+      while( input.peek() == 'c' ) {
+	input.skip_line();
+	input.skip_blanks();
+      }
 
-      //std::cout << new_clause << std::endl;
-      
-      //if(params.checked) add_original_clause( new_clause );
+      while( (l = input.read_int()) ) {
+	lits.add( l>0 ? (l-1)*2+1 : (l+1)*-2 );
+      }
+      ends.add( lits.size );
+
+      if( lits.size >= DIMACS_BATCH_SIZE || i == M-1 ) {
+	base->add( lits, ends );
+	lits.clear();
+	ends.clear();
+      }
     }
-  
-  //init_watchers();
-  
-  //if(params.normalize_activity != 0)
-  //normalize_activity(params.normalize_activity);
-  
-  //  std::cout << base << std::endl;
+}
+
+
+/**********************************************
+ * XCSP 2.1 reader
+ **********************************************/
+
+// the kinds of tag returned by read_xml_tag()
+#define XML_EOF   0
+#define XML_OPEN  1
+#define XML_CLOSE 2
+#define XML_EMPTY 3
+
+// skips everything up to the next element tag and reads its name and
+// attributes, the declaration, processing instructions and comments are skipped
+static int read_xml_tag(Mistral::InputFile& input, std::string& name,
+			std::map< std::string, std::string >& attributes) {
+  int c, kind = XML_OPEN, dashes;
+  std::string key, value;
+
+  name.clear();
+  attributes.clear();
+
+  while(true) {
+    while((c = input.get()) != '<')
+      if(c == EOF) return XML_EOF;
+
+    c = input.peek();
+    if(c == '?') {
+      while((c = input.get()) != '>' && c != EOF) ;
+    } else if(c == '!') {
+      input.get();
+      if(input.peek() == '-') {
+	// comment, ends with "-->"
+	dashes = 0;
+	while((c = input.get()) != EOF && (c != '>' || dashes < 2))
+	  dashes = (c == '-' ? dashes+1 : 0);
+      } else {
+	while((c = input.get()) != '>' && c != EOF) ;
+      }
+    } else break;
+  }
+
+  if(input.peek() == '/') {
+    input.get();
+    kind = XML_CLOSE;
+  }
+
+  while((c = input.peek()) != EOF && c != '>' && c != '/' && c > ' ')
+    name += (char)(input.get());
+
+  while(true) {
+    input.skip_blanks();
+    c = input.get();
+    if(c == '>' || c == EOF) break;
+    if(c == '/') {
+      kind = XML_EMPTY;
+      continue;
+    }
+
+    key = (char)c;
+    while((c = input.peek()) != EOF && c != '=' && c > ' ')
+      key += (char)(input.get());
+    input.skip_blanks();
+    if(input.peek() == '=') {
+      input.get();
+      input.skip_blanks();
+      int quote = input.get();
+      value.clear();
+      while((c = input.get()) != quote && c != EOF)
+	value += (char)c;
+      attributes[key] = value;
+    }
+  }
+
+  return kind;
+}
+
+// appends the text up to the next tag
+static void read_xml_text(Mistral::InputFile& input, std::string& text) {
+  int c;
+  while((c = input.peek()) != '<' && c != EOF)
+    text += (char)(input.get());
+}
+
+// splits a text on blanks, brackets and braces are tokens on their own
+static void xcsp_tokenize(const std::string& text, std::vector< std::string >& tokens) {
+  std::string token;
+  for(unsigned int i=0; i<=text.size(); ++i) {
+    char c = (i < text.size() ? text[i] : ' ');
+    if(c == '[' || c == ']' || c == '{' || c == '}' || c <= ' ') {
+      if(!token.empty()) tokens.push_back(token);
+      token.clear();
+      if(c > ' ') tokens.push_back(std::string(1, c));
+    } else token += c;
+  }
+}
+
+static bool xcsp_is_int(const std::string& token) {
+  unsigned int i = (token.size() > 1 && (token[0] == '-' || token[0] == '+'));
+  if(i >= token.size()) return false;
+  for(; i<token.size(); ++i)
+    if(token[i] < '0' || token[i] > '9') return false;
+  return true;
+}
+
+static std::string xcsp_lower(const std::string& word) {
+  std::string lower(word);
+  for(unsigned int i=0; i<lower.size(); ++i)
+    lower[i] = tolower(lower[i]);
+  return lower;
+}
+
+static void xcsp_error(const std::string& message, const std::string& what) {
+  std::cerr << "Error: " << message << " " << what << std::endl;
+  exit(1);
+}
+
+
+// a node of the functional expression of a predicate: an operator applied
+// to arguments, a formal parameter (param >= 0) or a constant (op is empty)
+class XCSPTerm {
+public:
+  std::string op;
+  int param;
+  int value;
+  std::vector< XCSPTerm > args;
+
+  XCSPTerm() : param(-1), value(0) {}
+};
 
-  //cbase->reason = reason.stack_;
+// arity of the functional operators supported by the reader (0 if unknown)
+static int xcsp_arity(const std::string& op) {
+  if(op == "neg" || op == "abs" || op == "not") return 1;
+  if(op == "add" || op == "sub" || op == "mul" || op == "div" || op == "mod" ||
+     op == "min" || op == "max" || op == "eq" || op == "ne" || op == "ge" ||
+     op == "gt" || op == "le" || op == "lt" || op == "and" || op == "or" ||
+     op == "xor" || op == "iff") return 2;
+  return 0;
+}
+
+static void xcsp_parse_term(const char*& s, const std::vector< std::string >& formals, XCSPTerm& term) {
+  while(*s && *s <= ' ') ++s;
+
+  std::string word;
+  while(*s == '-' || *s == '_' || isalnum(*s)) word += *(s++);
+  while(*s && *s <= ' ') ++s;
+
+  if(*s == '(') {
+    term.op = word;
+    ++s;
+    while(true) {
+      term.args.push_back(XCSPTerm());
+      xcsp_parse_term(s, formals, term.args.back());
+      while(*s && *s <= ' ') ++s;
+      if(*s == ',') ++s;
+      else break;
+    }
+    if(*s != ')') xcsp_error("missing parenthesis after", word);
+    ++s;
+    if(xcsp_arity(word) != (int)(term.args.size()))
+      xcsp_error("unsupported predicate operator", word);
+  } else if(xcsp_is_int(word)) {
+    term.value = atoi(word.c_str());
+  } else {
+    for(term.param=formals.size(); term.param-- && formals[term.param] != word;) ;
+    if(term.param < 0) xcsp_error("unknown predicate parameter", word);
+  }
+}
+
+static Mistral::Variable xcsp_expression(const XCSPTerm& term, Mistral::Vector< Mistral::Variable >& actuals) {
+  if(term.param >= 0) return actuals[term.param];
+  if(term.op.empty()) return Mistral::Variable(term.value);
+
+  Mistral::Variable x = xcsp_expression(term.args[0], actuals);
+  if(term.op == "neg") return -x;
+  if(term.op == "abs") return Mistral::Abs(x);
+  // (a negation posted as a constraint does not work on a predicate)
+  if(term.op == "not") return x == 0;
+
+  Mistral::Variable y = xcsp_expression(term.args[1], actuals);
+  if(term.op == "add") return x + y;
+  if(term.op == "sub") return x - y;
+  if(term.op == "mul") return x * y;
+  if(term.op == "div") return x / y;
+  if(term.op == "mod") return x % y;
+  if(term.op == "min") return Mistral::Min(x, y);
+  if(term.op == "max") return Mistral::Max(x, y);
+  if(term.op == "eq" || term.op == "iff") return x == y;
+  if(term.op == "ne" || term.op == "xor") return x != y;
+  if(term.op == "ge") return x >= y;
+  if(term.op == "gt") return x > y;
+  if(term.op == "le") return x <= y;
+  if(term.op == "lt") return x < y;
+  if(term.op == "and") return x && y;
+  return x || y;
+}
+
+
+// a relation, its tuples are stored in a single block shared by the tables
+// of all the constraints that refer to it (they are never released, as the
+// tuples given to Table())
+class XCSPRelation {
+public:
+  int arity;
+  int num_tuples;
+  bool conflicts;
+  int *tuples;
+};
+
+// lexicographic order on the tuples of a relation
+class XCSPTupleLess {
+public:
+  int arity;
+
+  XCSPTupleLess(const int n) : arity(n) {}
+  bool operator()(const int* a, const int* b) const {
+    for(int i=0; i<arity; ++i)
+      if(a[i] != b[i]) return a[i] < b[i];
+    return false;
+  }
+};
+
+class XCSPPredicate {
+public:
+  std::vector< std::string > formals;
+  XCSPTerm functional;
+};
+
+
+void Mistral::Solver::parse_xcsp(const char* filename) {
+  InputFile input( filename );
+  int kind, c, i, j, k, n;
+  std::string name, text;
+  std::map< std::string, std::string > attributes;
+  std::vector< std::string > tokens;
+
+  std::map< std::string, int > domain_index, variable_index, relation_index, predicate_index;
+  std::vector< std::vector< int > > domains;
+  std::vector< XCSPRelation > relations;
+  std::vector< XCSPPredicate > predicates;
+
+  // the variables of the instance
+  Vector< Variable > X;
+  Vector< Variable > scope, actuals, list;
+  Vector< int > weights;
+
+  if(!input.is_open()) {
+    std::cerr << "Error: cannot read " << filename << std::endl;
+    exit(1);
+  }
+
+  while((kind = read_xml_tag(input, name, attributes)) != XML_EOF) {
+    if(kind == XML_CLOSE) continue;
+
+    if(name == "domain") {
+      domain_index[attributes["name"]] = domains.size();
+      domains.push_back(std::vector< int >());
+      std::vector< int >& values = domains.back();
+      while(kind == XML_OPEN) {
+	input.skip_blanks();
+	c = input.peek();
+	if(c != '-' && c != '+' && (unsigned int)(c - '0') >= 10) break;
+	i = input.read_int();
+	if(input.peek() == '.') {
+	  input.get();
+	  input.get();
+	  j = input.read_int();
+	} else j = i;
+	for(; i<=j; ++i) values.push_back(i);
+      }
+
+    } else if(name == "variable") {
+      if(!domain_index.count(attributes["domain"]))
+	xcsp_error("unknown domain", attributes["domain"]);
+      std::vector< int >& values = domains[domain_index[attributes["domain"]]];
+      if(values.empty()) xcsp_error("empty domain", attributes["domain"]);
+
+      variable_index[attributes["name"]] = X.size;
+      // the constraints are posted on the expressions, since the
+      // implementation of the domains is chosen at consolidation
+      if(values.back() - values.front() + 1 == (int)(values.size())) {
+	Variable x(values.front(), values.back());
+	add(x);
+	X.add(x);
+      } else {
+	Vector< int > vals;
+	for(i=0; i<(int)(values.size()); ++i) vals.add(values[i]);
+	Variable x(vals);
+	add(x);
+	X.add(x);
+      }
+
+    } else if(name == "relation") {
+      if(attributes["semantics"] == "soft")
+	xcsp_error("soft relations are not supported", attributes["name"]);
+
+      // the tuples are read straight into the block, in a single pass
+      Vector< int > block;
+      n = atoi(attributes["arity"].c_str());
+      block.initialise(0, std::max(1, n * atoi(attributes["nbTuples"].c_str())));
+      while(kind == XML_OPEN) {
+	input.skip_blanks();
+	c = input.peek();
+	if(c == '|') input.get();
+	else if(c == '-' || c == '+' || (unsigned int)(c - '0') < 10) block.add(input.read_int());
+	else break;
+      }
+
+      XCSPRelation relation;
+      relation.arity = n;
+      relation.num_tuples = (n ? block.size / n : 0);
+      relation.conflicts = (attributes["semantics"] == "conflicts");
+      relation.tuples = block.stack_;
+      block.neutralise();
+
+      relation_index[attributes["name"]] = relations.size();
+      relations.push_back(relation);
+
+    } else if(name == "predicate") {
+      predicate_index[attributes["name"]] = predicates.size();
+      predicates.push_back(XCSPPredicate());
+      XCSPPredicate& predicate = predicates.back();
+      while((kind = read_xml_tag(input, name, attributes)) != XML_EOF && name != "predicate") {
+	if(kind != XML_OPEN) continue;
+	text.clear();
+	read_xml_text(input, text);
+	if(name == "parameters") {
+	  tokens.clear();
+	  xcsp_tokenize(text, tokens);
+	  // "int X0 int X1 ..."
+	  for(i=1; i<(int)(tokens.size()); i+=2) predicate.formals.push_back(tokens[i]);
+	} else if(name == "functional") {
+	  const char *s = text.c_str();
+	  xcsp_parse_term(s, predicate.formals, predicate.functional);
+	} else if(name == "infix" || name == "postfix" || name == "math") {
+	  xcsp_error("unsupported predicate representation", name);
+	}
+      }
+
+    } else if(name == "constraint") {
+      std::string reference = attributes["reference"];
+
+      tokens.clear();
+      xcsp_tokenize(attributes["scope"], tokens);
+      scope.clear();
+      for(i=0; i<(int)(tokens.size()); ++i) {
+	if(!variable_index.count(tokens[i])) xcsp_error("unknown variable", tokens[i]);
+	scope.add(X[variable_index[tokens[i]]]);
+      }
+
+      // the parameters, and the operator tag that may interrupt them
+      std::string op;
+      tokens.clear();
+      if(kind == XML_OPEN) {
+	while((kind = read_xml_tag(input, name, attributes)) != XML_EOF && name != "constraint") {
+	  if(name == "parameters" && kind == XML_OPEN) {
+	    while(true) {
+	      text.clear();
+	      read_xml_text(input, text);
+	      xcsp_tokenize(text, tokens);
+	      kind = read_xml_tag(input, name, attributes);
+	      if(kind == XML_CLOSE || kind == XML_EOF) break;
+	      op = name;
+	      tokens.push_back("<>");
+	    }
+	  }
+	}
+      }
+
+      // the parameters are either variables or constants
+      actuals.clear();
+      for(i=0; i<(int)(tokens.size()); ++i) {
+	if(variable_index.count(tokens[i]))
+	  actuals.add(X[variable_index[tokens[i]]]);
+	else if(xcsp_is_int(tokens[i]))
+	  actuals.add(Variable(atoi(tokens[i].c_str())));
+      }
+
+      if(relation_index.count(reference)) {
+	XCSPRelation& relation = relations[relation_index[reference]];
+	if(relation.arity != (int)(scope.size))
+	  xcsp_error("wrong arity for relation", reference);
+	n = relation.arity;
+
+	// the vector of tuples is handed over to the table
+	Vector< const int* > rel;
+	if(!relation.conflicts) {
+	  for(i=0; i<relation.num_tuples; ++i) rel.add(relation.tuples + i*n);
+	} else {
+	  // the supports are the tuples of the cartesian product of the
+	  // domains that are not conflicts (sorted to be skipped in one pass)
+	  Vector< const int* > conflicts;
+	  for(i=0; i<relation.num_tuples; ++i) conflicts.add(relation.tuples + i*n);
+	  std::sort(conflicts.begin(), conflicts.end(), XCSPTupleLess(n));
+
+	  Vector< int > supports;
+	  int *tuple = new int[n];
+	  for(j=0; j<n; ++j) tuple[j] = scope[j].get_min();
+	  k = 0;
+	  do {
+	    while(k < (int)(conflicts.size) && XCSPTupleLess(n)(conflicts[k], tuple)) ++k;
+	    if(k == (int)(conflicts.size) || XCSPTupleLess(n)(tuple, conflicts[k]))
+	      for(j=0; j<n; ++j) supports.add(tuple[j]);
+	    // next tuple in lexicographic order
+	    for(j=n; j--;) {
+	      if(tuple[j] < scope[j].get_max()) {
+		tuple[j] = scope[j].next(tuple[j]);
+		break;
+	      }
+	      tuple[j] = scope[j].get_min();
+	    }
+	  } while(j >= 0);
+	  delete [] tuple;
+
+	  for(i=0; i<(int)(supports.size); i+=n) rel.add(supports.stack_ + i);
+	  supports.neutralise();
+	}
+	add(Table(scope, rel, TableExpression::Dynamic));
+	rel.neutralise();
+
+      } else if(predicate_index.count(reference)) {
+	XCSPPredicate& predicate = predicates[predicate_index[reference]];
+	if(actuals.size != predicate.formals.size())
+	  xcsp_error("wrong number of parameters for predicate", reference);
+	add(xcsp_expression(predicate.functional, actuals));
+
+      } else {
+	std::string global = xcsp_lower(reference);
+	if(global == "global:alldifferent") {
+	  add(AllDiff(actuals.empty() ? scope : actuals));
+
+	} else if(global == "global:weightedsum") {
+	  // [ { w1 V1 } { w2 V2 } ... ] <op/> k
+	  list.clear();
+	  weights.clear();
+	  for(i=0; i+3<(int)(tokens.size()) && tokens[i] != "<>"; ++i)
+	    if(tokens[i] == "{") {
+	      weights.add(atoi(tokens[i+1].c_str()));
+	      if(variable_index.count(tokens[i+2])) list.add(X[variable_index[tokens[i+2]]]);
+	      else list.add(Variable(atoi(tokens[i+2].c_str())));
+	    }
+	  k = atoi(tokens.back().c_str());
+	  if(op == "eq") add(Sum(list, weights, k, k));
+	  else if(op == "ne") add(Sum(list, weights) != k);
+	  else if(op == "ge") add(Sum(list, weights, k, INFTY));
+	  else if(op == "gt") add(Sum(list, weights, k+1, INFTY));
+	  else if(op == "le") add(Sum(list, weights, -INFTY, k));
+	  else if(op == "lt") add(Sum(list, weights, -INFTY, k-1));
+	  else xcsp_error("unsupported weightedSum operator", op);
+
+	} else if(global == "global:element") {
+	  // index [ V1 V2 ... ] value, the index starts at 1
+	  if(actuals.size < 3) xcsp_error("wrong parameters for", reference);
+	  list.clear();
+	  for(i=1; i+1<(int)(actuals.size); ++i) list.add(actuals[i]);
+	  add(actuals.back() == Element(list, actuals[0], 1));
+
+	} else {
+	  xcsp_error("unsupported constraint", reference);
+	}
+      }
+    }
+  }
 }
 
 
@@ -1550,13 +2127,15 @@ Mistral::Outcome Mistral::Solver::solve() {
 void Mistral::Solver::minimize(Variable X) {
   X.initialise(this,1);
   objective = new Goal(Goal::MINIMIZATION, X.get_var());
-  consolidate_manager->id_obj = X.id();
+  // otherwise, the consolidate manager gets the objective when it is created
+  if(consolidate_manager) consolidate_manager->id_obj = X.id();
 }
 
 void Mistral::Solver::maximize(Variable X) {
   X.initialise(this,1);
   objective = new Goal(Goal::MAXIMIZATION, X.get_var());
-  consolidate_manager->id_obj = X.id();
+  // otherwise, the consolidate manager gets the objective when it is created
+  if(consolidate_manager) consolidate_manager->id_obj = X.id();
 }
 
 Mistral::Outcome Mistral::Solver::search_minimize(Variable X) {
@@ -1866,6 +2445,7 @@ Mistral::Outcome Mistral::Solver::restart_search(const int root, const bool _res
 		statistics.num_constraints = posted_constraints.size;
 		if(base) statistics.num_clauses = base->clauses.size;
 		if(base) statistics.num_learned = base->learnt.size;
+		if(lazy_base) statistics.num_learned = lazy_base->learnt.size;
 		statistics.num_variables = sequence.size;  
 		statistics.num_values = 0;
 		for(int i=0; i<sequence.size; ++i)
@@ -2052,6 +2632,10 @@ Goal *goal)
   
 	if(base) statistics.num_clauses = base->clauses.size;
 
+	// the lazy clauses learnt during a previous search may rely on its objective
+	if(lazy_base) lazy_base->clear_learnt();
+	else if(parameters.lazy_generation) set_lazy_generation_on();
+
 	unsigned int arity;
 	for(unsigned int i=0; i<posted_constraints.size; ++i) {
 		arity = constraints[posted_constraints[i]].arity();
@@ -2128,6 +2712,10 @@ void Mistral::Solver::initialise_search(VarStack < Variable, ReversibleNum<int>
   
   if(base) statistics.num_clauses = base->clauses.size;
 
+  // the lazy clauses learnt during a previous search may rely on its objective
+  if(lazy_base) lazy_base->clear_learnt();
+  else if(parameters.lazy_generation) set_lazy_generation_on();
+
   unsigned int arity;
   for(unsigned int i=0; i<posted_constraints.size; ++i) {
     arity = constraints[posted_constraints[i]].arity();
@@ -2323,6 +2911,8 @@ void Mistral::Solver::restore() {
   --level;
   ++statistics.num_backtracks;
 
+  if(lazy_base) lazy_base->cancel_until(level);
+
 
   // unsigned int previous_level;
 
@@ -2817,6 +3407,46 @@ void Mistral::Solver::parity_processing(const int Knst)
 
 }
 
+void Mistral::Solver::gaussian_elimination() 
+{
+  // the parity constraints over Boolean variables are gathered into a 
+  // single system, propagated by Gauss-Jordan elimination on top of them
+  Vector< Variable > scope;
+  Vector< Vector< int > > equations;
+  Vector< int > parities;
+  Vector< int > column;
+  Variable *scp;
+  int arity, j, x;
+  bool boolean;
+
+  column.initialise(variables.size, variables.size, -1);
+
+  for(unsigned int i=0; i<constraints.size; ++i) {
+    if(constraints[i].symbol() == "parity") {
+      scp = constraints[i].get_scope();
+      arity = constraints[i].arity();
+      boolean = true;
+      for(j=0; boolean && j<arity; ++j) 
+	boolean = (scp[j].get_min() >= 0 && scp[j].get_max() <= 1);
+      if(boolean) {
+	equations.add(Vector< int >());
+	for(j=0; j<arity; ++j) {
+	  x = scp[j].id();
+	  if(column[x] < 0) {
+	    column[x] = scope.size;
+	    scope.add(scp[j]);
+	  }
+	  equations.back().add(column[x]);
+	}
+	parities.add(((ConstraintParity*)(constraints[i].propagator))->target_parity);
+      }
+    }
+  }
+
+  if(equations.size > 1) 
+    add(Constraint(new ConstraintGaussJordan(scope, equations, parities)));
+}
+
 bool Mistral::Solver::is_pseudo_boolean() const {
 
   bool is_pb = true;
@@ -3268,6 +3898,7 @@ Mistral::PropagationOutcome Mistral::Solver::propagate(Constraint c,
       // propagate postponed constraint
       ++statistics.num_propagations;  
       culprit = active_constraints.select(constraints);
+      if(lazy_base) lazy_base->cause = culprit.propagator;
       taboo_constraint = culprit.freeze();
       wiped_idx = culprit.propagate(); 
       taboo_constraint = culprit.defrost();
@@ -3626,7 +4257,12 @@ bool Mistral::Solver::propagate()
 
 
   bool fix_point;
-  int trig, cons, vidx;
+  int trig, cons, vidx, cost;
+  unsigned long int events_before;
+  unsigned long long int cycles_before = 0;
+#ifdef _PROFILING
+  double propag_start;
+#endif
   Triplet < int, Event, ConstraintImplementation* > var_evt;
 
   //wiped_idx = CONSISTENT;
@@ -3634,6 +4270,9 @@ bool Mistral::Solver::propagate()
 
   ++statistics.num_filterings;  
 
+  // the bound of the objective is not explained, it is taken as a fact
+  if(lazy_base) lazy_base->cause = lazy_base;
+
   // TODO, we shouldn't have to do that
   if(IS_OK(wiped_idx) && objective && objective->enforce()) {
     wiped_idx = objective->objective.id();
@@ -3767,9 +4406,25 @@ bool Mistral::Solver::propagate()
 	      }
 #endif
 	      ++statistics.num_propagations;  
+	      cost = culprit.priority();
+	      ++statistics.num_class_propagations[cost];
+	      events_before = num_events;
+	      if(parameters.profiling) cycles_before = get_cycles();
+#ifdef _PROFILING
+	      propag_start = get_run_time();
+#endif
+	      if(lazy_base) lazy_base->cause = culprit.propagator;
 	      taboo_constraint = culprit.freeze();
 	      wiped_idx = culprit.propagate(var_evt.second); 
 	      taboo_constraint = culprit.defrost();
+#ifdef _PROFILING
+	      statistics.class_propag_time[cost] += (get_run_time() - propag_start);
+#endif
+	      statistics.num_class_prunings[cost] += (num_events - events_before);
+	      if(!IS_OK(wiped_idx)) ++statistics.num_class_failures[cost];
+	      if(parameters.profiling) 
+		culprit.propagator->update_profile(num_events - events_before, !IS_OK(wiped_idx),
+						   get_cycles() - cycles_before);
 #ifdef _DEBUG_AC
 	      if(_DEBUG_AC) {
 		if(IS_OK(wiped_idx)) {
@@ -3859,9 +4514,25 @@ bool Mistral::Solver::propagate()
 #endif
     
       ++statistics.num_propagations;  
+      cost = culprit.priority();
+      ++statistics.num_class_propagations[cost];
+      events_before = num_events;
+      if(parameters.profiling) cycles_before = get_cycles();
+#ifdef _PROFILING
+      propag_start = get_run_time();
+#endif
+      if(lazy_base) lazy_base->cause = culprit.propagator;
       taboo_constraint = culprit.freeze();
       wiped_idx = culprit.propagate(); 
       taboo_constraint = culprit.defrost();
+#ifdef _PROFILING
+      statistics.class_propag_time[cost] += (get_run_time() - propag_start);
+#endif
+      statistics.num_class_prunings[cost] += (num_events - events_before);
+      if(!IS_OK(wiped_idx)) ++statistics.num_class_failures[cost];
+      if(parameters.profiling) 
+	culprit.propagator->update_profile(num_events - events_before, !IS_OK(wiped_idx),
+					   get_cycles() - cycles_before);
 
 #ifdef _DEBUG_AC
       if(_DEBUG_AC) {
@@ -3880,6 +4551,7 @@ bool Mistral::Solver::propagate()
   }
   
   taboo_constraint = NULL;
+  if(lazy_base) lazy_base->cause = NULL;
   active_constraints.clear();
   if(!parameters.backjump) {
     active_variables.clear();
@@ -4657,6 +5329,14 @@ void Mistral::Solver::learn_nogood() {
       store_reason(current_explanation, a);
 #endif
 
+      // the clauses involved in the conflict are bumped
+      if(base) {
+	if(current_explanation == base) 
+	  base->bump(a == NULL_ATOM ? base->conflict : base->reason_for[a]);
+	else if(current_explanation->is_clause())
+	  base->bump((Clause*)current_explanation);
+      }
+
       Explanation::iterator lit = current_explanation->get_reason_for(a, (a != NULL_ATOM ? assignment_level[a] : level), stop);
   
       while(lit < stop) {
@@ -4896,7 +5576,8 @@ void Mistral::Solver::forget() {
 
   //std::cout << lit_activity << " "  << lit_activity[0] << " "  << lit_activity[1] << std::endl;
 
-  if(base) statistics.size_learned -= base->forget(parameters.forgetfulness, NULL, NULL);
+  if(base) statistics.size_learned -= base->forget(parameters.forgetfulness);
+  if(lazy_base) statistics.size_learned -= lazy_base->forget(parameters.forgetfulness);
   //(var_activity, lit_activity);
 
   //exit(1);
@@ -4973,10 +5654,15 @@ Mistral::Outcome Mistral::Solver::branch_right() {
 #endif
 
     Mistral::Decision deduction;
-
+    bool lazy_deduction = false;
     
     
-    if(parameters.backjump && !culprit.empty()) {
+    if(lazy_base && !culprit.empty() && lazy_base->learn_nogood(culprit.propagator)) {
+      
+      lazy_deduction = true;
+      deduction = lazy_base->get_deduction();
+
+    } else if(parameters.backjump && !lazy_base && !culprit.empty()) {
 
 #ifdef _OLD_
 
@@ -4996,6 +5682,9 @@ Mistral::Outcome Mistral::Solver::branch_right() {
     
     notify_backtrack();
     restore(backtrack_level);  
+
+    // reduce the learnt clause database when it is time to do so
+    if(base || lazy_base) forget();
     
 #ifdef _DEBUG_SEARCH
     if(_DEBUG_SEARCH) {
@@ -5024,6 +5713,14 @@ Mistral::Outcome Mistral::Solver::branch_right() {
     
     //decisions.back(-1).make();
     //decision.make();
+    if(lazy_base) {
+      // the deduction is explained by the learnt clause (units are facts of the root), 
+      // it is taken as a decision when the failure could not be explained
+      lazy_base->cause = (!lazy_deduction ? NULL : 
+			  (lazy_base->asserting ? (Explanation*)(lazy_base->asserting) : (Explanation*)lazy_base));
+      deduction.make();
+      lazy_base->cause = NULL;
+    } else
     deduction.make();
     //taboo_constraint = NULL;
     //}
@@ -5058,6 +5755,18 @@ void Mistral::Solver::branch_left() {
 
   Mistral::Decision decision = heuristic->branch();
 
+  if(lazy_base && decision._data_ != -1) {
+    // with lazy clause generation, the decisions are order literals
+    int v = decision.value();
+    if(decision.type() == Decision::ASSIGNMENT) {
+      if(v == decision.var.get_max()) decision = Decision(decision.var, Decision::LOWERBOUND, v);
+      else decision = Decision(decision.var, Decision::UPPERBOUND, v);
+    } else if(decision.type() == Decision::REMOVAL) {
+      if(v == decision.var.get_min()) decision = Decision(decision.var, Decision::LOWERBOUND, v+1);
+      else decision = Decision(decision.var, Decision::UPPERBOUND, v-1);
+    }
+  }
+
   if(decision.var.get_size() >= 20) {
     ++statistics.num_branch_on_large_domains;
   }
@@ -8660,6 +9369,16 @@ void Mistral::Solver::set_learning_on() {
   }
 }
 
+void Mistral::Solver::set_lazy_generation_on() {
+
+  parameters.lazy_generation = true;
+  if(!lazy_base) {
+    ConstraintLazyClauseBase *lcg = new ConstraintLazyClauseBase(variables);
+    add(Constraint(lcg));
+    lazy_base = lcg;
+  }
+}
+
 void Mistral::Solver::set_time_limit(const double limit) {
   if(limit > 0) {
     parameters.limit = 1;
@@ -8749,6 +9468,7 @@ Mistral::SolverCmdLine::~SolverCmdLine() {
   //delete printArg;
   // delete printsolArg;
   delete printstaArg;
+  delete profileArg;
   delete printmodArg;
   delete printparArg;
   delete printinsArg;
@@ -8762,6 +9482,7 @@ Mistral::SolverCmdLine::~SolverCmdLine() {
   delete forgetArg;
   delete incrementArg;
   delete learningArg;
+  delete lcgArg;
   delete branchingArg;
   delete orderingArg;
   delete pcommentArg;
@@ -8866,6 +9587,9 @@ void Mistral::SolverCmdLine::initialise() {
   learningArg = new TCLAP::SwitchArg("l","learning","Switch on clause learning (CDCL)", false);
   add( *learningArg );
 
+  lcgArg = new TCLAP::SwitchArg("","lcg","Switch on lazy clause generation (learning over bound literals)", false);
+  add( *lcgArg );
+
 
   // PRINT MODEL
   printmodArg = new TCLAP::SwitchArg("", "print_mod","Print the model", false);
@@ -8875,6 +9599,10 @@ void Mistral::SolverCmdLine::initialise() {
   printstaArg = new TCLAP::SwitchArg("", "print_sta","Print the statistics", false);
   add( *printstaArg );
 
+  // PROFILE THE PROPAGATORS
+  profileArg = new TCLAP::SwitchArg("", "profile","Record (and print with the statistics) the profile of the propagators", false);
+  add( *profileArg );
+
   // PRINT INSTANCE
   printinsArg = new TCLAP::SwitchArg("", "print_ins","Print the instance", false);
   add( *printinsArg );
@@ -8954,6 +9682,8 @@ void Mistral::SolverCmdLine::set_parameters(Mistral::Solver& s) {
   s.parameters.time_limit = timeArg->getValue();
   s.parameters.activity_decay = decayArg->getValue();
   s.parameters.backjump = learningArg->getValue();
+  s.parameters.lazy_generation = lcgArg->getValue();
+  s.parameters.profiling = profileArg->getValue();
   s.parameters.activity_increment = incrementArg->getValue();
   s.parameters.forgetfulness = forgetArg->getValue();
   s.parameters.prefix_comment = pcommentArg->getValue();
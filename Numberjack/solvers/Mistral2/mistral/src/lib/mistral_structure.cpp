@@ -3126,3 +3126,259 @@ void Mistral::IntervalList::push(const Interval& I) {
   }
 }
 
+
+
+
+
+
+/* Bulk operations on arrays of words. The units are 32 bits and can be 
+   the halves of 64 bits words, hence the may_alias type */
+
+#if defined(__GNUC__)
+typedef unsigned int __attribute__((__may_alias__)) bitset_unit;
+#else
+typedef unsigned int bitset_unit;
+#endif
+
+static void portable_and_with(unsigned int *a, const unsigned int *b, const int n) {
+  bitset_unit *x = a;
+  const bitset_unit *y = b;
+  for(int i=0; i<n; ++i) x[i] &= y[i];
+}
+
+static void portable_or_with(unsigned int *a, const unsigned int *b, const int n) {
+  bitset_unit *x = a;
+  const bitset_unit *y = b;
+  for(int i=0; i<n; ++i) x[i] |= y[i];
+}
+
+static void portable_andnot_with(unsigned int *a, const unsigned int *b, const int n) {
+  bitset_unit *x = a;
+  const bitset_unit *y = b;
+  for(int i=0; i<n; ++i) x[i] &= ~y[i];
+}
+
+static unsigned int portable_count(const unsigned int *a, const int n) {
+  const bitset_unit *x = a;
+  unsigned int c = 0;
+  for(int i=0; i<n; ++i) c += __builtin_popcount(x[i]);
+  return c;
+}
+
+static unsigned int portable_and_count(const unsigned int *a, const unsigned int *b, const int n) {
+  const bitset_unit *x = a;
+  const bitset_unit *y = b;
+  unsigned int c = 0;
+  for(int i=0; i<n; ++i) c += __builtin_popcount(x[i] & y[i]);
+  return c;
+}
+
+static bool portable_intersect(const unsigned int *a, const unsigned int *b, const int n) {
+  const bitset_unit *x = a;
+  const bitset_unit *y = b;
+  for(int i=0; i<n; ++i) if(x[i] & y[i]) return true;
+  return false;
+}
+
+static bool portable_includes(const unsigned int *a, const unsigned int *b, const int n) {
+  const bitset_unit *x = a;
+  const bitset_unit *y = b;
+  for(int i=0; i<n; ++i) if(y[i] & ~x[i]) return false;
+  return true;
+}
+
+
+#if defined(__GNUC__) && defined(__x86_64__)
+
+#include <immintrin.h>
+
+#define _SIMD_BITSET
+
+// SSE4.2: 128 bits registers, and the popcnt instruction
+
+#define _POPCNT128(v) (_mm_popcnt_u64(_mm_cvtsi128_si64(v)) + _mm_popcnt_u64(_mm_extract_epi64(v, 1)))
+
+__attribute__((target("sse4.2,popcnt")))
+static void sse42_and_with(unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+4<=n; i+=4) 
+    _mm_storeu_si128((__m128i*)(a+i), _mm_and_si128(_mm_loadu_si128((const __m128i*)(a+i)), 
+						    _mm_loadu_si128((const __m128i*)(b+i))));
+  portable_and_with(a+i, b+i, n-i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static void sse42_or_with(unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+4<=n; i+=4) 
+    _mm_storeu_si128((__m128i*)(a+i), _mm_or_si128(_mm_loadu_si128((const __m128i*)(a+i)), 
+						   _mm_loadu_si128((const __m128i*)(b+i))));
+  portable_or_with(a+i, b+i, n-i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static void sse42_andnot_with(unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+4<=n; i+=4) 
+    _mm_storeu_si128((__m128i*)(a+i), _mm_andnot_si128(_mm_loadu_si128((const __m128i*)(b+i)), 
+						       _mm_loadu_si128((const __m128i*)(a+i))));
+  portable_andnot_with(a+i, b+i, n-i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static unsigned int sse42_count(const unsigned int *a, const int n) {
+  int i = 0;
+  unsigned int c = 0;
+  for(; i+4<=n; i+=4) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(a+i));
+    c += _POPCNT128(v);
+  }
+  return c + portable_count(a+i, n-i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static unsigned int sse42_and_count(const unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  unsigned int c = 0;
+  for(; i+4<=n; i+=4) {
+    __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i*)(a+i)), _mm_loadu_si128((const __m128i*)(b+i)));
+    c += _POPCNT128(v);
+  }
+  return c + portable_and_count(a+i, b+i, n-i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static bool sse42_intersect(const unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+4<=n; i+=4) 
+    if(!_mm_testz_si128(_mm_loadu_si128((const __m128i*)(a+i)), _mm_loadu_si128((const __m128i*)(b+i)))) return true;
+  return portable_intersect(a+i, b+i, n-i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static bool sse42_includes(const unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+4<=n; i+=4) 
+    if(!_mm_testc_si128(_mm_loadu_si128((const __m128i*)(a+i)), _mm_loadu_si128((const __m128i*)(b+i)))) return false;
+  return portable_includes(a+i, b+i, n-i);
+}
+
+
+// AVX2: 256 bits registers, the population count of a block uses a 4 bits 
+// lookup table in a shuffle and a sum of absolute differences (W. Mula)
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_popcount_bytes(const __m256i v) {
+  const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+					  0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i lo = _mm256_and_si256(v, low_mask);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+}
+
+__attribute__((target("avx2")))
+static inline unsigned int avx2_sum_counts(const __m256i acc) {
+  return (unsigned int)(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) + 
+			_mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+}
+
+__attribute__((target("avx2")))
+static void avx2_and_with(unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+8<=n; i+=8) 
+    _mm256_storeu_si256((__m256i*)(a+i), _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a+i)), 
+							  _mm256_loadu_si256((const __m256i*)(b+i))));
+  portable_and_with(a+i, b+i, n-i);
+}
+
+__attribute__((target("avx2")))
+static void avx2_or_with(unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+8<=n; i+=8) 
+    _mm256_storeu_si256((__m256i*)(a+i), _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(a+i)), 
+							 _mm256_loadu_si256((const __m256i*)(b+i))));
+  portable_or_with(a+i, b+i, n-i);
+}
+
+__attribute__((target("avx2")))
+static void avx2_andnot_with(unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+8<=n; i+=8) 
+    _mm256_storeu_si256((__m256i*)(a+i), _mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(b+i)), 
+							     _mm256_loadu_si256((const __m256i*)(a+i))));
+  portable_andnot_with(a+i, b+i, n-i);
+}
+
+__attribute__((target("avx2")))
+static unsigned int avx2_count(const unsigned int *a, const int n) {
+  int i = 0;
+  __m256i acc = _mm256_setzero_si256();
+  for(; i+8<=n; i+=8) 
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(avx2_popcount_bytes(_mm256_loadu_si256((const __m256i*)(a+i))), 
+						_mm256_setzero_si256()));
+  return avx2_sum_counts(acc) + portable_count(a+i, n-i);
+}
+
+__attribute__((target("avx2")))
+static unsigned int avx2_and_count(const unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  __m256i acc = _mm256_setzero_si256();
+  for(; i+8<=n; i+=8) 
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(avx2_popcount_bytes(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a+i)), 
+										      _mm256_loadu_si256((const __m256i*)(b+i)))), 
+						_mm256_setzero_si256()));
+  return avx2_sum_counts(acc) + portable_and_count(a+i, b+i, n-i);
+}
+
+__attribute__((target("avx2")))
+static bool avx2_intersect(const unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+8<=n; i+=8) 
+    if(!_mm256_testz_si256(_mm256_loadu_si256((const __m256i*)(a+i)), _mm256_loadu_si256((const __m256i*)(b+i)))) return true;
+  return portable_intersect(a+i, b+i, n-i);
+}
+
+__attribute__((target("avx2")))
+static bool avx2_includes(const unsigned int *a, const unsigned int *b, const int n) {
+  int i = 0;
+  for(; i+8<=n; i+=8) 
+    if(!_mm256_testc_si256(_mm256_loadu_si256((const __m256i*)(a+i)), _mm256_loadu_si256((const __m256i*)(b+i)))) return false;
+  return portable_includes(a+i, b+i, n-i);
+}
+
+#endif
+
+
+Mistral::BitsetKernels Mistral::bitset_kernels = {
+  portable_and_with, portable_or_with, portable_andnot_with, 
+  portable_count, portable_and_count, portable_intersect, portable_includes,
+  BITSET_PORTABLE
+};
+
+int Mistral::set_bitset_kernels(const int level) {
+  BitsetKernels portable = { portable_and_with, portable_or_with, portable_andnot_with, 
+			     portable_count, portable_and_count, portable_intersect, portable_includes, 
+			     BITSET_PORTABLE };
+  bitset_kernels = portable;
+
+#ifdef _SIMD_BITSET
+  __builtin_cpu_init();
+  if(level >= BITSET_AVX2 && __builtin_cpu_supports("avx2")) {
+    BitsetKernels avx2 = { avx2_and_with, avx2_or_with, avx2_andnot_with, 
+			   avx2_count, avx2_and_count, avx2_intersect, avx2_includes, 
+			   BITSET_AVX2 };
+    bitset_kernels = avx2;
+  } else if(level >= BITSET_SSE42 && __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+    BitsetKernels sse42 = { sse42_and_with, sse42_or_with, sse42_andnot_with, 
+			    sse42_count, sse42_and_count, sse42_intersect, sse42_includes, 
+			    BITSET_SSE42 };
+    bitset_kernels = sse42;
+  }
+#endif
+
+  return bitset_kernels.level;
+}
+
+// the best implementation is selected when the library is loaded
+static int bitset_kernels_level = Mistral::set_bitset_kernels();
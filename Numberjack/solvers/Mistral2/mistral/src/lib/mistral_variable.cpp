@@ -4187,6 +4187,128 @@ Mistral::Variable Mistral::ReifiedDisjunctive(Variable X, Variable Y,
 
 
 
+Mistral::UnaryResourceExpression::UnaryResourceExpression(Vector< Variable >& args, Vector< int >& p) 
+  : Expression(args) { processing_time = p; }
+
+Mistral::UnaryResourceExpression::~UnaryResourceExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete unary resource expression" << std::endl;
+#endif
+}
+  
+void Mistral::UnaryResourceExpression::extract_constraint(Solver *s) {
+  s->add(Constraint(new ConstraintUnaryResource(children, processing_time)));
+}
+
+void Mistral::UnaryResourceExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: UnaryResource constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+void Mistral::UnaryResourceExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: UnaryResource constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+const char* Mistral::UnaryResourceExpression::get_name() const {
+  return "unary";
+}
+
+Mistral::Variable Mistral::UnaryResource(Vector< Variable >& args, Vector< int >& p) 
+{
+  Variable exp(new UnaryResourceExpression(args,p));
+  return exp;
+}
+
+
+
+Mistral::CumulativeExpression::CumulativeExpression(Vector< Variable >& args, Vector< int >& p, 
+						    Vector< int >& d, const int c, const bool e) 
+  : Expression(args) { processing_time = p; demand = d; capacity = c; energetic = e; }
+
+Mistral::CumulativeExpression::~CumulativeExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete cumulative expression" << std::endl;
+#endif
+}
+  
+void Mistral::CumulativeExpression::extract_constraint(Solver *s) {
+  s->add(Constraint(new ConstraintCumulative(children, processing_time, demand, capacity, energetic)));
+}
+
+void Mistral::CumulativeExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: Cumulative constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+void Mistral::CumulativeExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: Cumulative constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+const char* Mistral::CumulativeExpression::get_name() const {
+  return "cumulative";
+}
+
+Mistral::Variable Mistral::Cumulative(Vector< Variable >& args, Vector< int >& p, Vector< int >& d, const int c, const bool e) 
+{
+  Variable exp(new CumulativeExpression(args,p,d,c,e));
+  return exp;
+}
+
+
+Mistral::CircuitExpression::CircuitExpression(Vector< Variable >& args) 
+  : Expression(args) { }
+
+Mistral::CircuitExpression::CircuitExpression(Vector< Variable >& args, Vector< int >& w, Variable cost) 
+  : Expression(args) { children.add(cost); weight = w; }
+
+Mistral::CircuitExpression::~CircuitExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete circuit expression" << std::endl;
+#endif
+}
+  
+void Mistral::CircuitExpression::extract_constraint(Solver *s) {
+  if(weight.empty()) {
+    s->add(Constraint(new ConstraintCircuit(children)));
+  } else {
+    VarArray successors;
+    for(unsigned int i=0; i+1<children.size; ++i)
+      successors.add(children[i]);
+    s->add(Constraint(new ConstraintCircuit(successors)));
+    s->add(Constraint(new ConstraintWeightedCircuit(children, weight)));
+  }
+}
+
+void Mistral::CircuitExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: Circuit constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+void Mistral::CircuitExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: Circuit constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+const char* Mistral::CircuitExpression::get_name() const {
+  return "circuit";
+}
+
+Mistral::Variable Mistral::Circuit(Vector< Variable >& args) 
+{
+  Variable exp(new CircuitExpression(args));
+  return exp;
+}
+
+Mistral::Variable Mistral::Circuit(Vector< Variable >& args, Vector< int >& w, Variable cost) 
+{
+  Variable exp(new CircuitExpression(args,w,cost));
+  return exp;
+}
+
+
+
 Mistral::FreeExpression::FreeExpression(Variable X) 
   : Expression(X) { };
 
@@ -4224,7 +4346,9 @@ void Mistral::AllDiffExpression::extract_constraint(Solver *s) {
   //   Constraint *con = new ConstraintAllDiff(children); 
   //   con->initialise();
   //   return con;
-  if(consistency_level == BOUND_CONSISTENCY)
+  if(consistency_level == ARC_CONSISTENCY)
+    s->add(Constraint(new ConstraintAllDiffGAC(children))); 
+  else if(consistency_level == BOUND_CONSISTENCY)
     s->add(Constraint(new ConstraintAllDiff(children))); 
   s->add(Constraint(new ConstraintCliqueNotEqual(children))); 
   //   Vector< Variable > pair;
@@ -4466,12 +4590,26 @@ Mistral::TableExpression::~TableExpression() {
 
 void Mistral::TableExpression::extract_constraint(Solver *s) { 
   ConstraintTable *tab;
+
+  if(propagator == MDD4R || propagator == Dynamic) {
+    // by default, the table is replaced by its decision diagram when the 
+    // latter is much smaller (an edge costs a few times more than a cell)
+    ConstraintMDD *mdd = new ConstraintMDD(children, tuples);
+    mdd->compile();
+    if(propagator == MDD4R || 4*mdd->num_edges() < (int)(tuples.size*children.size)) {
+      s->add(Constraint(mdd));
+      return;
+    }
+    delete mdd;
+  }
+
   switch(propagator) {
   case GAC2001: {tab = new ConstraintGAC2001(children);} break;
   case GAC3: {tab = new ConstraintGAC3(children);} break;
     //case AC3: {tab = new ConstraintAC3(children);} break;
   case GAC4: {tab = new ConstraintGAC4(children);} break;
-  default: {tab = new ConstraintGAC2001(children);}
+  case CT: {tab = new ConstraintCompactTable(children);} break;
+  default: {tab = new ConstraintCompactTable(children);}
   }
  
   tab->table.copy(tuples);
@@ -4503,6 +4641,58 @@ Mistral::Variable Mistral::Table(Vector< Variable >& args, Vector<const int*>& r
 // }
 
 
+Mistral::MDDExpression::MDDExpression(Vector< Variable >& args, const int init, 
+				      Vector< int >& trans, Vector< int >& finals) 
+  : Expression(args) { initial_state = init; transitions = trans; final_states = finals; }
+
+Mistral::MDDExpression::~MDDExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete mdd expression" << std::endl;
+#endif
+}
+
+void Mistral::MDDExpression::extract_constraint(Solver *s) { 
+  s->add(Constraint(new ConstraintMDD(children, initial_state, transitions, final_states)));
+}
+
+void Mistral::MDDExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: MDD constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+void Mistral::MDDExpression::extract_predicate(Solver *s) { 
+  std::cerr << "Error: MDD constraint can't yet be used as a predicate" << std::endl;
+  exit(0);
+}
+
+const char* Mistral::MDDExpression::get_name() const {
+  return "mdd";
+}
+
+Mistral::Variable Mistral::Regular(Vector< Variable >& args, const int init, Vector< int >& trans, Vector< int >& finals) {
+  Variable exp(new MDDExpression(args, init, trans, finals));
+  return exp;
+}
+
+Mistral::Variable Mistral::MDD(Vector< Variable >& args, Vector< int >& edges) {
+  // the diagram is read as an automaton whose final states are the terminals
+  int num_nodes = 0;
+  unsigned int k;
+  for(k=0; k<edges.size; k+=3) {
+    if(edges[k] >= num_nodes) num_nodes = edges[k]+1;
+    if(edges[k+2] >= num_nodes) num_nodes = edges[k+2]+1;
+  }
+  Vector< bool > terminal;
+  terminal.initialise(num_nodes, num_nodes, true);
+  for(k=0; k<edges.size; k+=3) terminal[edges[k]] = false;
+  Vector< int > finals;
+  for(int i=0; i<num_nodes; ++i) if(terminal[i]) finals.add(i);
+
+  Variable exp(new MDDExpression(args, 0, edges, finals));
+  return exp;
+}
+
+
 Mistral::LexExpression::LexExpression(Vector< Variable >& r1, Vector< Variable >& r2, const int st_)
   : Expression() { 
   int row_size = r1.size;
@@ -4671,6 +4861,7 @@ Mistral::BoolSumExpression::~BoolSumExpression() {
 }
 
 #define _INCREMENTAL_WBOOLSUM
+#define _WATCHED_BOOLSUM
 
 void Mistral::BoolSumExpression::extract_constraint(Solver *s) { 
   if(weight.empty()) {
@@ -4714,11 +4905,23 @@ void Mistral::BoolSumExpression::extract_constraint(Solver *s) {
 	  std::cout << "ok\n";
 #endif
       }
-    } else {
+    } 
+#ifdef _WATCHED_BOOLSUM
+    else if(ConstraintWatchedBoolSum::is_worthwhile(children,weight,lower_bound,upper_bound)) {
+      s->add(Constraint(new ConstraintWatchedBoolSum(children,lower_bound,upper_bound))); 
+    }
+#endif
+    else {
       s->add(Constraint(new ConstraintBoolSumInterval(children,lower_bound,upper_bound))); 
     }
   } else {
 
+#ifdef _WATCHED_BOOLSUM
+    if(ConstraintWatchedBoolSum::is_worthwhile(children,weight,lower_bound,upper_bound)) 
+      s->add(Constraint(new ConstraintWatchedBoolSum(children,weight,lower_bound,upper_bound))); 
+    else
+#endif
+
 #ifdef _INCREMENTAL_WBOOLSUM
     s->add(Constraint(new ConstraintIncrementalWeightedBoolSumInterval(children,weight,lower_bound,upper_bound)));  
 #else
@@ -5418,6 +5621,9 @@ void Mistral::ElementExpression::initialise_domain() {
 
     nxt = children[arity].next(i+offset);
   } while(i+offset<nxt);
+
+  // no index is valid, the predicate will fail when extracted
+  if(lower_bound > upper_bound) lower_bound = upper_bound = 0;
   
   domain.initialise(lower_bound, upper_bound, BitSet::empt);
   
@@ -5490,9 +5696,21 @@ void Mistral::ElementExpression::extract_predicate(Solver *s) {
   else
     std::cout << "ok\n";
 #endif
-	Constraint con(new PredicateElement(children, offset));
-	
-  s->add(con);
+
+  // an array of constants has a dedicated propagator
+  Vector< int > constants;
+  for(int i=0; i<arity && children[i].is_ground(); ++i) 
+    constants.add(children[i].get_min());
+
+  if((int)(constants.size) == arity) {
+    Vector< Variable > scp;
+    scp.add(children[arity]);
+    scp.add(children[arity+1]);
+    s->add(Constraint(new PredicateConstantElement(scp, constants, offset)));
+  } else {
+    Constraint con(new PredicateElement(children, offset));
+    s->add(con);
+  }
 }
 
 
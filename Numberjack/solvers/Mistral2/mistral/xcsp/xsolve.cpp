@@ -23,12 +23,11 @@
 
 #include <iostream>
 
- #include "xml/XMLParser_libxml2.hh"
- #include "xml/MistralCallback.hh"
- #include "xml/CSPParserCallback.hh"
-//#include <mistral_solver.hpp>
+#include <iomanip>
+
+#include <mistral_solver.hpp>
+#include <mistral_search.hpp>
 
-using namespace CSPXMLParser;
 using namespace Mistral;
 using namespace std;
 
@@ -142,47 +141,38 @@ void outputHelpMessage()
 
 int main(int argc, char **argv)
 {
-  MistralCallback cb; // my interface between the parser and the solver
-  
+  str_param[0] = "";
+  // getCommandLine(int_ident, int_param, nia,
+  // 		     str_ident, str_param, nsa,
+  // 		     &(argv[1]), argc-1);
 
-  try
+  if( argc < 2 || !strcmp( argv[argc-1], "-h" ) )
     {
-      // the parser that will decode the XML file
-      XMLParser_libxml2<MistralCallback> parser(cb); 
-      parser.setPreferredExpressionRepresentation(TREE);
-
-      str_param[0] = "";
-      // getCommandLine(int_ident, int_param, nia,
-      // 		     str_ident, str_param, nsa,
-      // 		     &(argv[1]), argc-1);
-
-      if( argc < 2 || !strcmp( argv[argc-1], "-h" ) )
-  	{
-  	  outputHelpMessage();
-  	}
-      else
-  	{
-  	  cout << "c mistral" <<  " version 2.0" << endl;
-	  
-  	  parser.parse( argv[1] ); // parse the input file
-	  
-	  Outcome result = cb.solve();
-
-	  cout << outcome2str(result) << endl;
-
-	  cout << cb.solver.statistics << endl;
-
-  	  //cb.print_outcome( cb.solve() );
-  	  //cb.cleanup();
-  	}
-
+      outputHelpMessage();
     }
-  catch (exception &e)
+  else
     {
-      cout.flush();
-      cerr << "\n\tUnexpected exception :\n";
-      cerr << "\t" << e.what() << endl;
-      exit(1);
+      cout << "c mistral" <<  " version 2.0" << endl;
+
+      // the instance is streamed from the file, the tuples of each
+      // relation are read once and shared by its table constraints
+      Solver solver;
+      solver.parse_xcsp( argv[1] );
+      solver.consolidate();
+
+      cout << solver << endl;
+
+      BranchingHeuristic *heuristic = new GenericHeuristic< GenericDVO< MinDomainOverDegree >, MinValue >(&solver);
+      RestartPolicy *restart = new Geometric();
+
+      Outcome result = solver.depth_first_search(solver.variables, heuristic, restart);
+
+      Solution solution(solver.variables);
+      cout << solution << endl;
+
+      cout << outcome2str(result) << endl;
+
+      cout << solver.statistics << endl;
     }
 
   return 0;